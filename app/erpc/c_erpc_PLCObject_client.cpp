@@ -143,6 +143,86 @@ uint32_t StopPLC(bool * success)
     return result;
 }
 
+uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->GetTraceVariablesWait(debugToken, timeoutMs, minSamples, traces);
+
+    return result;
+}
+
+uint32_t SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->SetStatisticsVariablesList(orders, windowMs);
+
+    return result;
+}
+
+uint32_t GetStatistics(TraceStatistics * statistics)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->GetStatistics(statistics);
+
+    return result;
+}
+
+uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->SetDecimatedTraceVariablesList(orders, debugtoken);
+
+    return result;
+}
+
+uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->GetLogMessages(level, firstID, maxCount, fromSec, toSec, batch);
+
+    return result;
+}
+
+uint32_t QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->QueryBlobs(blobIDs, present);
+
+    return result;
+}
+
+uint32_t ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->ReadVariables(idxs, snapshot);
+
+    return result;
+}
+
+uint32_t WriteVariables(const list_variable_write_1_t * values)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->WriteVariables(values);
+
+    return result;
+}
+
+uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->GetTraceVariablesPage(debugToken, timeoutMs, minSamples, maxSize, page);
+
+    return result;
+}
+
+uint32_t SetTransferEncoding(uint32_t requested, uint32_t * accepted)
+{
+    uint32_t result;
+    result = s_BeremizPLCObjectService_client->SetTransferEncoding(requested, accepted);
+
+    return result;
+}
+
 void initBeremizPLCObjectService_client(erpc_client_t client)
 {
 #if ERPC_ALLOCATION_POLICY == ERPC_ALLOCATION_POLICY_DYNAMIC
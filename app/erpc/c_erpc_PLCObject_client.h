@@ -49,6 +49,16 @@ enum _BeremizPLCObjectService_ids
     kBeremizPLCObjectService_SetTraceVariablesList_id = 12,
     kBeremizPLCObjectService_StartPLC_id = 13,
     kBeremizPLCObjectService_StopPLC_id = 14,
+    kBeremizPLCObjectService_GetTraceVariablesWait_id = 15,
+    kBeremizPLCObjectService_SetStatisticsVariablesList_id = 16,
+    kBeremizPLCObjectService_GetStatistics_id = 17,
+    kBeremizPLCObjectService_SetDecimatedTraceVariablesList_id = 18,
+    kBeremizPLCObjectService_GetLogMessages_id = 19,
+    kBeremizPLCObjectService_QueryBlobs_id = 20,
+    kBeremizPLCObjectService_ReadVariables_id = 21,
+    kBeremizPLCObjectService_WriteVariables_id = 22,
+    kBeremizPLCObjectService_GetTraceVariablesPage_id = 23,
+    kBeremizPLCObjectService_SetTransferEncoding_id = 24,
 };
 
 //! @name BeremizPLCObjectService
@@ -80,6 +90,26 @@ uint32_t SetTraceVariablesList(const list_trace_order_1_t * orders, uint32_t * d
 uint32_t StartPLC(void);
 
 uint32_t StopPLC(bool * success);
+
+uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces);
+
+uint32_t SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs);
+
+uint32_t GetStatistics(TraceStatistics * statistics);
+
+uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken);
+
+uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch);
+
+uint32_t QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present);
+
+uint32_t ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot);
+
+uint32_t WriteVariables(const list_variable_write_1_t * values);
+
+uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page);
+
+uint32_t SetTransferEncoding(uint32_t requested, uint32_t * accepted);
 //@}
 
 #endif // ERPC_FUNCTIONS_DEFINITIONS
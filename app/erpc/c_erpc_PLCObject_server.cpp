@@ -143,6 +143,86 @@ class BeremizPLCObjectService_server: public BeremizPLCObjectService_interface
 
             return result;
         }
+
+        uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces)
+        {
+            uint32_t result;
+            result = ::GetTraceVariablesWait(debugToken, timeoutMs, minSamples, traces);
+
+            return result;
+        }
+
+        uint32_t SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs)
+        {
+            uint32_t result;
+            result = ::SetStatisticsVariablesList(orders, windowMs);
+
+            return result;
+        }
+
+        uint32_t GetStatistics(TraceStatistics * statistics)
+        {
+            uint32_t result;
+            result = ::GetStatistics(statistics);
+
+            return result;
+        }
+
+        uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken)
+        {
+            uint32_t result;
+            result = ::SetDecimatedTraceVariablesList(orders, debugtoken);
+
+            return result;
+        }
+
+        uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch)
+        {
+            uint32_t result;
+            result = ::GetLogMessages(level, firstID, maxCount, fromSec, toSec, batch);
+
+            return result;
+        }
+
+        uint32_t QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present)
+        {
+            uint32_t result;
+            result = ::QueryBlobs(blobIDs, present);
+
+            return result;
+        }
+
+        uint32_t ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot)
+        {
+            uint32_t result;
+            result = ::ReadVariables(idxs, snapshot);
+
+            return result;
+        }
+
+        uint32_t WriteVariables(const list_variable_write_1_t * values)
+        {
+            uint32_t result;
+            result = ::WriteVariables(values);
+
+            return result;
+        }
+
+        uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page)
+        {
+            uint32_t result;
+            result = ::GetTraceVariablesPage(debugToken, timeoutMs, minSamples, maxSize, page);
+
+            return result;
+        }
+
+        uint32_t SetTransferEncoding(uint32_t requested, uint32_t * accepted)
+        {
+            uint32_t result;
+            result = ::SetTransferEncoding(requested, accepted);
+
+            return result;
+        }
 };
 
 ERPC_MANUALLY_CONSTRUCTED_STATIC(BeremizPLCObjectService_service, s_BeremizPLCObjectService_service);
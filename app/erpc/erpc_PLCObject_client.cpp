@@ -46,6 +46,30 @@ static void write_trace_order_struct(erpc::Codec * codec, const trace_order * da
 //! @brief Function to write struct list_trace_order_1_t
 static void write_list_trace_order_1_t_struct(erpc::Codec * codec, const list_trace_order_1_t * data);
 
+//! @brief Function to write struct stat_order
+static void write_stat_order_struct(erpc::Codec * codec, const stat_order * data);
+
+//! @brief Function to write struct list_stat_order_1_t
+static void write_list_stat_order_1_t_struct(erpc::Codec * codec, const list_stat_order_1_t * data);
+
+//! @brief Function to write struct decimated_trace_order
+static void write_decimated_trace_order_struct(erpc::Codec * codec, const decimated_trace_order * data);
+
+//! @brief Function to write struct list_decimated_trace_order_1_t
+static void write_list_decimated_trace_order_1_t_struct(erpc::Codec * codec, const list_decimated_trace_order_1_t * data);
+
+//! @brief Function to write struct list_binary_1_t
+static void write_list_binary_1_t_struct(erpc::Codec * codec, const list_binary_1_t * data);
+
+//! @brief Function to write struct list_uint32_1_t
+static void write_list_uint32_1_t_struct(erpc::Codec * codec, const list_uint32_1_t * data);
+
+//! @brief Function to write struct variable_write
+static void write_variable_write_struct(erpc::Codec * codec, const variable_write * data);
+
+//! @brief Function to write struct list_variable_write_1_t
+static void write_list_variable_write_1_t_struct(erpc::Codec * codec, const list_variable_write_1_t * data);
+
 
 // Write struct binary_t function implementation
 static void write_binary_t_struct(erpc::Codec * codec, const binary_t * data)
@@ -118,6 +142,122 @@ static void write_list_trace_order_1_t_struct(erpc::Codec * codec, const list_tr
     }
 }
 
+// Write struct stat_order function implementation
+static void write_stat_order_struct(erpc::Codec * codec, const stat_order * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->write(data->idx);
+
+    codec->write(static_cast<int32_t>(data->type));
+}
+
+// Write struct list_stat_order_1_t function implementation
+static void write_list_stat_order_1_t_struct(erpc::Codec * codec, const list_stat_order_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_stat_order_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Write struct decimated_trace_order function implementation
+static void write_decimated_trace_order_struct(erpc::Codec * codec, const decimated_trace_order * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->write(data->idx);
+
+    write_binary_t_struct(codec, &(data->force));
+
+    codec->write(data->divisor);
+}
+
+// Write struct list_decimated_trace_order_1_t function implementation
+static void write_list_decimated_trace_order_1_t_struct(erpc::Codec * codec, const list_decimated_trace_order_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_decimated_trace_order_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Write struct list_binary_1_t function implementation
+static void write_list_binary_1_t_struct(erpc::Codec * codec, const list_binary_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_binary_t_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Write struct list_uint32_1_t function implementation
+static void write_list_uint32_1_t_struct(erpc::Codec * codec, const list_uint32_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->write(data->elements[listCount]);
+    }
+}
+
+// Write struct variable_write function implementation
+static void write_variable_write_struct(erpc::Codec * codec, const variable_write * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->write(data->idx);
+
+    write_binary_t_struct(codec, &(data->value));
+}
+
+// Write struct list_variable_write_1_t function implementation
+static void write_list_variable_write_1_t_struct(erpc::Codec * codec, const list_variable_write_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_variable_write_struct(codec, &(data->elements[listCount]));
+    }
+}
+
 
 //! @brief Function to read struct binary_t
 static void read_binary_t_struct(erpc::Codec * codec, binary_t * data);
@@ -140,6 +280,36 @@ static void read_TraceVariables_struct(erpc::Codec * codec, TraceVariables * dat
 //! @brief Function to read struct list_trace_sample_1_t
 static void read_list_trace_sample_1_t_struct(erpc::Codec * codec, list_trace_sample_1_t * data);
 
+//! @brief Function to read struct var_statistics
+static void read_var_statistics_struct(erpc::Codec * codec, var_statistics * data);
+
+//! @brief Function to read struct TraceStatistics
+static void read_TraceStatistics_struct(erpc::Codec * codec, TraceStatistics * data);
+
+//! @brief Function to read struct list_var_statistics_1_t
+static void read_list_var_statistics_1_t_struct(erpc::Codec * codec, list_var_statistics_1_t * data);
+
+//! @brief Function to read struct log_entry
+static void read_log_entry_struct(erpc::Codec * codec, log_entry * data);
+
+//! @brief Function to read struct log_batch
+static void read_log_batch_struct(erpc::Codec * codec, log_batch * data);
+
+//! @brief Function to read struct list_log_entry_1_t
+static void read_list_log_entry_1_t_struct(erpc::Codec * codec, list_log_entry_1_t * data);
+
+//! @brief Function to read struct list_bool_1_t
+static void read_list_bool_1_t_struct(erpc::Codec * codec, list_bool_1_t * data);
+
+//! @brief Function to read struct list_uint32_1_t
+static void read_list_uint32_1_t_struct(erpc::Codec * codec, list_uint32_1_t * data);
+
+//! @brief Function to read struct variable_snapshot
+static void read_variable_snapshot_struct(erpc::Codec * codec, variable_snapshot * data);
+
+//! @brief Function to read struct TracePage
+static void read_TracePage_struct(erpc::Codec * codec, TracePage * data);
+
 
 // Read struct binary_t function implementation
 static void read_binary_t_struct(erpc::Codec * codec, binary_t * data)
@@ -248,81 +418,934 @@ static void read_PLCstatus_struct(erpc::Codec * codec, PLCstatus * data)
 
     if(NULL == data)
     {
-        return;
+        return;
+    }
+
+    codec->read(_tmp_local_i32);
+    data->PLCstatus = static_cast<PLCstatus_enum>(_tmp_local_i32);
+
+    for (uint32_t arrayCount0 = 0U; arrayCount0 < 4U; ++arrayCount0)
+    {
+        codec->read(data->logcounts[arrayCount0]);
+    }
+}
+
+// Read struct trace_sample function implementation
+static void read_trace_sample_struct(erpc::Codec * codec, trace_sample * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->tick);
+
+    read_binary_t_struct(codec, &(data->TraceBuffer));
+}
+
+// Read struct TraceVariables function implementation
+static void read_TraceVariables_struct(erpc::Codec * codec, TraceVariables * data)
+{
+    int32_t _tmp_local_i32;
+
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(_tmp_local_i32);
+    data->PLCstatus = static_cast<PLCstatus_enum>(_tmp_local_i32);
+
+    read_list_trace_sample_1_t_struct(codec, &(data->traces));
+}
+
+// Read struct list_trace_sample_1_t function implementation
+static void read_list_trace_sample_1_t_struct(erpc::Codec * codec, list_trace_sample_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (trace_sample *) erpc_malloc(data->elementsCount * sizeof(trace_sample));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_trace_sample_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct var_statistics function implementation
+static void read_var_statistics_struct(erpc::Codec * codec, var_statistics * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->idx);
+
+    codec->read(data->samples);
+
+    codec->read(data->min);
+
+    codec->read(data->max);
+
+    codec->read(data->mean);
+
+    codec->read(data->last);
+
+    codec->read(data->changes);
+
+    codec->read(data->timeInState);
+}
+
+// Read struct TraceStatistics function implementation
+static void read_TraceStatistics_struct(erpc::Codec * codec, TraceStatistics * data)
+{
+    int32_t _tmp_local_i32;
+
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(_tmp_local_i32);
+    data->PLCstatus = static_cast<PLCstatus_enum>(_tmp_local_i32);
+
+    codec->read(data->window);
+
+    read_list_var_statistics_1_t_struct(codec, &(data->stats));
+}
+
+// Read struct list_var_statistics_1_t function implementation
+static void read_list_var_statistics_1_t_struct(erpc::Codec * codec, list_var_statistics_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (var_statistics *) erpc_malloc(data->elementsCount * sizeof(var_statistics));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_var_statistics_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct log_entry function implementation
+static void read_log_entry_struct(erpc::Codec * codec, log_entry * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->msgID);
+
+    {
+        uint32_t msg_len;
+        char * msg_local;
+        codec->readString(msg_len, &msg_local);
+        data->msg = (char*) erpc_malloc((msg_len + 1) * sizeof(char));
+        if ((data->msg == NULL) || (msg_local == NULL))
+        {
+            codec->updateStatus(kErpcStatus_MemoryError);
+        }
+        else
+        {
+            memcpy(data->msg, msg_local, msg_len);
+            (data->msg)[msg_len] = 0;
+        }
+    }
+
+    codec->read(data->tick);
+
+    codec->read(data->sec);
+
+    codec->read(data->nsec);
+}
+
+// Read struct log_batch function implementation
+static void read_log_batch_struct(erpc::Codec * codec, log_batch * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->count);
+
+    codec->read(data->nextID);
+
+    read_list_log_entry_1_t_struct(codec, &(data->entries));
+}
+
+// Read struct list_log_entry_1_t function implementation
+static void read_list_log_entry_1_t_struct(erpc::Codec * codec, list_log_entry_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (log_entry *) erpc_malloc(data->elementsCount * sizeof(log_entry));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_log_entry_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct list_bool_1_t function implementation
+static void read_list_bool_1_t_struct(erpc::Codec * codec, list_bool_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (bool *) erpc_malloc(data->elementsCount * sizeof(bool));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->read(data->elements[listCount]);
+    }
+}
+
+// Read struct list_uint32_1_t function implementation
+static void read_list_uint32_1_t_struct(erpc::Codec * codec, list_uint32_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (uint32_t *) erpc_malloc(data->elementsCount * sizeof(uint32_t));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->read(data->elements[listCount]);
+    }
+}
+
+// Read struct variable_snapshot function implementation
+static void read_variable_snapshot_struct(erpc::Codec * codec, variable_snapshot * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->tick);
+
+    read_binary_t_struct(codec, &(data->values));
+
+    read_list_uint32_1_t_struct(codec, &(data->sizes));
+}
+
+// Read struct TracePage function implementation
+static void read_TracePage_struct(erpc::Codec * codec, TracePage * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    read_TraceVariables_struct(codec, &(data->samples));
+
+    codec->read(data->more);
+
+    codec->read(data->dropped);
+
+    codec->read(data->discarded);
+}
+
+
+
+
+BeremizPLCObjectService_client::BeremizPLCObjectService_client(ClientManager *manager)
+:m_clientManager(manager)
+{
+}
+
+BeremizPLCObjectService_client::~BeremizPLCObjectService_client()
+{
+}
+
+// BeremizPLCObjectService interface AppendChunkToBlob function client shim.
+uint32_t BeremizPLCObjectService_client::AppendChunkToBlob(const binary_t * data, const binary_t * blobID, binary_t * newBlobID)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_AppendChunkToBlobId, request.getSequence());
+
+        write_binary_t_struct(codec, data);
+
+        write_binary_t_struct(codec, blobID);
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        read_binary_t_struct(codec, newBlobID);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_AppendChunkToBlobId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface GetLogMessage function client shim.
+uint32_t BeremizPLCObjectService_client::GetLogMessage(uint8_t level, uint32_t msgID, log_message * message)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetLogMessageId, request.getSequence());
+
+        codec->write(level);
+
+        codec->write(msgID);
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        read_log_message_struct(codec, message);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_GetLogMessageId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface GetPLCID function client shim.
+uint32_t BeremizPLCObjectService_client::GetPLCID(PSKID * plcID)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetPLCIDId, request.getSequence());
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        read_PSKID_struct(codec, plcID);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_GetPLCIDId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface GetPLCstatus function client shim.
+uint32_t BeremizPLCObjectService_client::GetPLCstatus(PLCstatus * status)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetPLCstatusId, request.getSequence());
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        read_PLCstatus_struct(codec, status);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_GetPLCstatusId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface GetTraceVariables function client shim.
+uint32_t BeremizPLCObjectService_client::GetTraceVariables(uint32_t debugToken, TraceVariables * traces)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetTraceVariablesId, request.getSequence());
+
+        codec->write(debugToken);
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        read_TraceVariables_struct(codec, traces);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_GetTraceVariablesId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface MatchMD5 function client shim.
+uint32_t BeremizPLCObjectService_client::MatchMD5(const char * MD5, bool * match)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_MatchMD5Id, request.getSequence());
+
+        {
+            uint32_t MD5_len = strlen((const char*)MD5);
+
+            codec->writeString(MD5_len, (const char*)MD5);
+        }
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        codec->read(*match);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_MatchMD5Id);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface NewPLC function client shim.
+uint32_t BeremizPLCObjectService_client::NewPLC(const char * md5sum, const binary_t * plcObjectBlobID, const list_extra_file_1_t * extrafiles, bool * success)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_NewPLCId, request.getSequence());
+
+        {
+            uint32_t md5sum_len = strlen((const char*)md5sum);
+
+            codec->writeString(md5sum_len, (const char*)md5sum);
+        }
+
+        write_binary_t_struct(codec, plcObjectBlobID);
+
+        write_list_extra_file_1_t_struct(codec, extrafiles);
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        codec->read(*success);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_NewPLCId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface PurgeBlobs function client shim.
+uint32_t BeremizPLCObjectService_client::PurgeBlobs(void)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
+    }
+#endif
+
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
+    {
+        err = kErpcStatus_MemoryError;
+    }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_PurgeBlobsId, request.getSequence());
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        codec->read(result);
+
+        err = codec->getStatus();
+    }
+
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_PurgeBlobsId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
+
+
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
+}
+
+// BeremizPLCObjectService interface RepairPLC function client shim.
+uint32_t BeremizPLCObjectService_client::RepairPLC(void)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
+    {
+        preCB();
     }
+#endif
 
-    codec->read(_tmp_local_i32);
-    data->PLCstatus = static_cast<PLCstatus_enum>(_tmp_local_i32);
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
 
-    for (uint32_t arrayCount0 = 0U; arrayCount0 < 4U; ++arrayCount0)
-    {
-        codec->read(data->logcounts[arrayCount0]);
-    }
-}
+    // Encode the request.
+    Codec * codec = request.getCodec();
 
-// Read struct trace_sample function implementation
-static void read_trace_sample_struct(erpc::Codec * codec, trace_sample * data)
-{
-    if(NULL == data)
+    if (codec == NULL)
     {
-        return;
+        err = kErpcStatus_MemoryError;
     }
+    else
+    {
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_RepairPLCId, request.getSequence());
 
-    codec->read(data->tick);
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
 
-    read_binary_t_struct(codec, &(data->TraceBuffer));
-}
+        codec->read(result);
 
-// Read struct TraceVariables function implementation
-static void read_TraceVariables_struct(erpc::Codec * codec, TraceVariables * data)
-{
-    int32_t _tmp_local_i32;
+        err = codec->getStatus();
+    }
 
-    if(NULL == data)
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_RepairPLCId);
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
     {
-        return;
+        postCB();
     }
+#endif
 
-    codec->read(_tmp_local_i32);
-    data->PLCstatus = static_cast<PLCstatus_enum>(_tmp_local_i32);
 
-    read_list_trace_sample_1_t_struct(codec, &(data->traces));
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
+
+    return result;
 }
 
-// Read struct list_trace_sample_1_t function implementation
-static void read_list_trace_sample_1_t_struct(erpc::Codec * codec, list_trace_sample_1_t * data)
+// BeremizPLCObjectService interface ResetLogCount function client shim.
+uint32_t BeremizPLCObjectService_client::ResetLogCount(void)
 {
-    if(NULL == data)
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb preCB = m_clientManager->getPreCB();
+    if (preCB)
     {
-        return;
+        preCB();
     }
+#endif
 
-    codec->startReadList(data->elementsCount);
-    data->elements = (trace_sample *) erpc_malloc(data->elementsCount * sizeof(trace_sample));
-    if ((data->elements == NULL) && (data->elementsCount > 0))
+    // Get a new request.
+    RequestContext request = m_clientManager->createRequest(false);
+
+    // Encode the request.
+    Codec * codec = request.getCodec();
+
+    if (codec == NULL)
     {
-        codec->updateStatus(kErpcStatus_MemoryError);
+        err = kErpcStatus_MemoryError;
     }
-    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    else
     {
-        read_trace_sample_struct(codec, &(data->elements[listCount]));
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_ResetLogCountId, request.getSequence());
+
+        // Send message to server
+        // Codec status is checked inside this function.
+        m_clientManager->performRequest(request);
+
+        codec->read(result);
+
+        err = codec->getStatus();
     }
-}
 
+    // Dispose of the request.
+    m_clientManager->releaseRequest(request);
+
+    // Invoke error handler callback function
+    m_clientManager->callErrorHandler(err, m_ResetLogCountId);
 
+#if ERPC_PRE_POST_ACTION
+    pre_post_action_cb postCB = m_clientManager->getPostCB();
+    if (postCB)
+    {
+        postCB();
+    }
+#endif
 
 
-BeremizPLCObjectService_client::BeremizPLCObjectService_client(ClientManager *manager)
-:m_clientManager(manager)
-{
-}
+    if (err != kErpcStatus_Success)
+    {
+        result = 0xFFFFFFFFU;
+    }
 
-BeremizPLCObjectService_client::~BeremizPLCObjectService_client()
-{
+    return result;
 }
 
-// BeremizPLCObjectService interface AppendChunkToBlob function client shim.
-uint32_t BeremizPLCObjectService_client::AppendChunkToBlob(const binary_t * data, const binary_t * blobID, binary_t * newBlobID)
+// BeremizPLCObjectService interface SeedBlob function client shim.
+uint32_t BeremizPLCObjectService_client::SeedBlob(const binary_t * seed, binary_t * blobID)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -348,17 +1371,15 @@ uint32_t BeremizPLCObjectService_client::AppendChunkToBlob(const binary_t * data
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_AppendChunkToBlobId, request.getSequence());
-
-        write_binary_t_struct(codec, data);
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SeedBlobId, request.getSequence());
 
-        write_binary_t_struct(codec, blobID);
+        write_binary_t_struct(codec, seed);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        read_binary_t_struct(codec, newBlobID);
+        read_binary_t_struct(codec, blobID);
 
         codec->read(result);
 
@@ -369,7 +1390,7 @@ uint32_t BeremizPLCObjectService_client::AppendChunkToBlob(const binary_t * data
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_AppendChunkToBlobId);
+    m_clientManager->callErrorHandler(err, m_SeedBlobId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -388,8 +1409,8 @@ uint32_t BeremizPLCObjectService_client::AppendChunkToBlob(const binary_t * data
     return result;
 }
 
-// BeremizPLCObjectService interface GetLogMessage function client shim.
-uint32_t BeremizPLCObjectService_client::GetLogMessage(uint8_t level, uint32_t msgID, log_message * message)
+// BeremizPLCObjectService interface SetTraceVariablesList function client shim.
+uint32_t BeremizPLCObjectService_client::SetTraceVariablesList(const list_trace_order_1_t * orders, uint32_t * debugtoken)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -415,17 +1436,15 @@ uint32_t BeremizPLCObjectService_client::GetLogMessage(uint8_t level, uint32_t m
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetLogMessageId, request.getSequence());
-
-        codec->write(level);
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SetTraceVariablesListId, request.getSequence());
 
-        codec->write(msgID);
+        write_list_trace_order_1_t_struct(codec, orders);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        read_log_message_struct(codec, message);
+        codec->read(*debugtoken);
 
         codec->read(result);
 
@@ -436,7 +1455,7 @@ uint32_t BeremizPLCObjectService_client::GetLogMessage(uint8_t level, uint32_t m
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_GetLogMessageId);
+    m_clientManager->callErrorHandler(err, m_SetTraceVariablesListId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -455,8 +1474,8 @@ uint32_t BeremizPLCObjectService_client::GetLogMessage(uint8_t level, uint32_t m
     return result;
 }
 
-// BeremizPLCObjectService interface GetPLCID function client shim.
-uint32_t BeremizPLCObjectService_client::GetPLCID(PSKID * plcID)
+// BeremizPLCObjectService interface StartPLC function client shim.
+uint32_t BeremizPLCObjectService_client::StartPLC(void)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -482,14 +1501,12 @@ uint32_t BeremizPLCObjectService_client::GetPLCID(PSKID * plcID)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetPLCIDId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_StartPLCId, request.getSequence());
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        read_PSKID_struct(codec, plcID);
-
         codec->read(result);
 
         err = codec->getStatus();
@@ -499,7 +1516,7 @@ uint32_t BeremizPLCObjectService_client::GetPLCID(PSKID * plcID)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_GetPLCIDId);
+    m_clientManager->callErrorHandler(err, m_StartPLCId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -518,8 +1535,8 @@ uint32_t BeremizPLCObjectService_client::GetPLCID(PSKID * plcID)
     return result;
 }
 
-// BeremizPLCObjectService interface GetPLCstatus function client shim.
-uint32_t BeremizPLCObjectService_client::GetPLCstatus(PLCstatus * status)
+// BeremizPLCObjectService interface StopPLC function client shim.
+uint32_t BeremizPLCObjectService_client::StopPLC(bool * success)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -545,13 +1562,13 @@ uint32_t BeremizPLCObjectService_client::GetPLCstatus(PLCstatus * status)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetPLCstatusId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_StopPLCId, request.getSequence());
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        read_PLCstatus_struct(codec, status);
+        codec->read(*success);
 
         codec->read(result);
 
@@ -562,7 +1579,7 @@ uint32_t BeremizPLCObjectService_client::GetPLCstatus(PLCstatus * status)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_GetPLCstatusId);
+    m_clientManager->callErrorHandler(err, m_StopPLCId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -581,8 +1598,8 @@ uint32_t BeremizPLCObjectService_client::GetPLCstatus(PLCstatus * status)
     return result;
 }
 
-// BeremizPLCObjectService interface GetTraceVariables function client shim.
-uint32_t BeremizPLCObjectService_client::GetTraceVariables(uint32_t debugToken, TraceVariables * traces)
+// BeremizPLCObjectService interface GetTraceVariablesWait function client shim.
+uint32_t BeremizPLCObjectService_client::GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -608,10 +1625,14 @@ uint32_t BeremizPLCObjectService_client::GetTraceVariables(uint32_t debugToken,
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetTraceVariablesId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetTraceVariablesWaitId, request.getSequence());
 
         codec->write(debugToken);
 
+        codec->write(timeoutMs);
+
+        codec->write(minSamples);
+
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
@@ -627,7 +1648,7 @@ uint32_t BeremizPLCObjectService_client::GetTraceVariables(uint32_t debugToken,
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_GetTraceVariablesId);
+    m_clientManager->callErrorHandler(err, m_GetTraceVariablesWaitId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -646,8 +1667,8 @@ uint32_t BeremizPLCObjectService_client::GetTraceVariables(uint32_t debugToken,
     return result;
 }
 
-// BeremizPLCObjectService interface MatchMD5 function client shim.
-uint32_t BeremizPLCObjectService_client::MatchMD5(const char * MD5, bool * match)
+// BeremizPLCObjectService interface SetStatisticsVariablesList function client shim.
+uint32_t BeremizPLCObjectService_client::SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -673,20 +1694,16 @@ uint32_t BeremizPLCObjectService_client::MatchMD5(const char * MD5, bool * match
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_MatchMD5Id, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SetStatisticsVariablesListId, request.getSequence());
 
-        {
-            uint32_t MD5_len = strlen((const char*)MD5);
+        write_list_stat_order_1_t_struct(codec, orders);
 
-            codec->writeString(MD5_len, (const char*)MD5);
-        }
+        codec->write(windowMs);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        codec->read(*match);
-
         codec->read(result);
 
         err = codec->getStatus();
@@ -696,7 +1713,7 @@ uint32_t BeremizPLCObjectService_client::MatchMD5(const char * MD5, bool * match
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_MatchMD5Id);
+    m_clientManager->callErrorHandler(err, m_SetStatisticsVariablesListId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -715,8 +1732,8 @@ uint32_t BeremizPLCObjectService_client::MatchMD5(const char * MD5, bool * match
     return result;
 }
 
-// BeremizPLCObjectService interface NewPLC function client shim.
-uint32_t BeremizPLCObjectService_client::NewPLC(const char * md5sum, const binary_t * plcObjectBlobID, const list_extra_file_1_t * extrafiles, bool * success)
+// BeremizPLCObjectService interface GetStatistics function client shim.
+uint32_t BeremizPLCObjectService_client::GetStatistics(TraceStatistics * statistics)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -742,23 +1759,13 @@ uint32_t BeremizPLCObjectService_client::NewPLC(const char * md5sum, const binar
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_NewPLCId, request.getSequence());
-
-        {
-            uint32_t md5sum_len = strlen((const char*)md5sum);
-
-            codec->writeString(md5sum_len, (const char*)md5sum);
-        }
-
-        write_binary_t_struct(codec, plcObjectBlobID);
-
-        write_list_extra_file_1_t_struct(codec, extrafiles);
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetStatisticsId, request.getSequence());
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        codec->read(*success);
+        read_TraceStatistics_struct(codec, statistics);
 
         codec->read(result);
 
@@ -769,7 +1776,7 @@ uint32_t BeremizPLCObjectService_client::NewPLC(const char * md5sum, const binar
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_NewPLCId);
+    m_clientManager->callErrorHandler(err, m_GetStatisticsId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -788,8 +1795,8 @@ uint32_t BeremizPLCObjectService_client::NewPLC(const char * md5sum, const binar
     return result;
 }
 
-// BeremizPLCObjectService interface PurgeBlobs function client shim.
-uint32_t BeremizPLCObjectService_client::PurgeBlobs(void)
+// BeremizPLCObjectService interface SetDecimatedTraceVariablesList function client shim.
+uint32_t BeremizPLCObjectService_client::SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -815,12 +1822,16 @@ uint32_t BeremizPLCObjectService_client::PurgeBlobs(void)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_PurgeBlobsId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SetDecimatedTraceVariablesListId, request.getSequence());
+
+        write_list_decimated_trace_order_1_t_struct(codec, orders);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
+        codec->read(*debugtoken);
+
         codec->read(result);
 
         err = codec->getStatus();
@@ -830,7 +1841,7 @@ uint32_t BeremizPLCObjectService_client::PurgeBlobs(void)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_PurgeBlobsId);
+    m_clientManager->callErrorHandler(err, m_SetDecimatedTraceVariablesListId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -849,8 +1860,8 @@ uint32_t BeremizPLCObjectService_client::PurgeBlobs(void)
     return result;
 }
 
-// BeremizPLCObjectService interface RepairPLC function client shim.
-uint32_t BeremizPLCObjectService_client::RepairPLC(void)
+// BeremizPLCObjectService interface GetLogMessages function client shim.
+uint32_t BeremizPLCObjectService_client::GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -876,12 +1887,24 @@ uint32_t BeremizPLCObjectService_client::RepairPLC(void)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_RepairPLCId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetLogMessagesId, request.getSequence());
+
+        codec->write(level);
+
+        codec->write(firstID);
+
+        codec->write(maxCount);
+
+        codec->write(fromSec);
+
+        codec->write(toSec);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
+        read_log_batch_struct(codec, batch);
+
         codec->read(result);
 
         err = codec->getStatus();
@@ -891,7 +1914,7 @@ uint32_t BeremizPLCObjectService_client::RepairPLC(void)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_RepairPLCId);
+    m_clientManager->callErrorHandler(err, m_GetLogMessagesId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -910,8 +1933,8 @@ uint32_t BeremizPLCObjectService_client::RepairPLC(void)
     return result;
 }
 
-// BeremizPLCObjectService interface ResetLogCount function client shim.
-uint32_t BeremizPLCObjectService_client::ResetLogCount(void)
+// BeremizPLCObjectService interface QueryBlobs function client shim.
+uint32_t BeremizPLCObjectService_client::QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -937,12 +1960,16 @@ uint32_t BeremizPLCObjectService_client::ResetLogCount(void)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_ResetLogCountId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_QueryBlobsId, request.getSequence());
+
+        write_list_binary_1_t_struct(codec, blobIDs);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
+        read_list_bool_1_t_struct(codec, present);
+
         codec->read(result);
 
         err = codec->getStatus();
@@ -952,7 +1979,7 @@ uint32_t BeremizPLCObjectService_client::ResetLogCount(void)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_ResetLogCountId);
+    m_clientManager->callErrorHandler(err, m_QueryBlobsId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -971,8 +1998,8 @@ uint32_t BeremizPLCObjectService_client::ResetLogCount(void)
     return result;
 }
 
-// BeremizPLCObjectService interface SeedBlob function client shim.
-uint32_t BeremizPLCObjectService_client::SeedBlob(const binary_t * seed, binary_t * blobID)
+// BeremizPLCObjectService interface ReadVariables function client shim.
+uint32_t BeremizPLCObjectService_client::ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -998,15 +2025,15 @@ uint32_t BeremizPLCObjectService_client::SeedBlob(const binary_t * seed, binary_
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SeedBlobId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_ReadVariablesId, request.getSequence());
 
-        write_binary_t_struct(codec, seed);
+        write_list_uint32_1_t_struct(codec, idxs);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        read_binary_t_struct(codec, blobID);
+        read_variable_snapshot_struct(codec, snapshot);
 
         codec->read(result);
 
@@ -1017,7 +2044,7 @@ uint32_t BeremizPLCObjectService_client::SeedBlob(const binary_t * seed, binary_
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_SeedBlobId);
+    m_clientManager->callErrorHandler(err, m_ReadVariablesId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -1036,8 +2063,8 @@ uint32_t BeremizPLCObjectService_client::SeedBlob(const binary_t * seed, binary_
     return result;
 }
 
-// BeremizPLCObjectService interface SetTraceVariablesList function client shim.
-uint32_t BeremizPLCObjectService_client::SetTraceVariablesList(const list_trace_order_1_t * orders, uint32_t * debugtoken)
+// BeremizPLCObjectService interface WriteVariables function client shim.
+uint32_t BeremizPLCObjectService_client::WriteVariables(const list_variable_write_1_t * values)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -1063,16 +2090,14 @@ uint32_t BeremizPLCObjectService_client::SetTraceVariablesList(const list_trace_
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SetTraceVariablesListId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_WriteVariablesId, request.getSequence());
 
-        write_list_trace_order_1_t_struct(codec, orders);
+        write_list_variable_write_1_t_struct(codec, values);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        codec->read(*debugtoken);
-
         codec->read(result);
 
         err = codec->getStatus();
@@ -1082,7 +2107,7 @@ uint32_t BeremizPLCObjectService_client::SetTraceVariablesList(const list_trace_
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_SetTraceVariablesListId);
+    m_clientManager->callErrorHandler(err, m_WriteVariablesId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -1101,8 +2126,8 @@ uint32_t BeremizPLCObjectService_client::SetTraceVariablesList(const list_trace_
     return result;
 }
 
-// BeremizPLCObjectService interface StartPLC function client shim.
-uint32_t BeremizPLCObjectService_client::StartPLC(void)
+// BeremizPLCObjectService interface GetTraceVariablesPage function client shim.
+uint32_t BeremizPLCObjectService_client::GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -1128,12 +2153,22 @@ uint32_t BeremizPLCObjectService_client::StartPLC(void)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_StartPLCId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_GetTraceVariablesPageId, request.getSequence());
+
+        codec->write(debugToken);
+
+        codec->write(timeoutMs);
+
+        codec->write(minSamples);
+
+        codec->write(maxSize);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
+        read_TracePage_struct(codec, page);
+
         codec->read(result);
 
         err = codec->getStatus();
@@ -1143,7 +2178,7 @@ uint32_t BeremizPLCObjectService_client::StartPLC(void)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_StartPLCId);
+    m_clientManager->callErrorHandler(err, m_GetTraceVariablesPageId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
@@ -1162,8 +2197,8 @@ uint32_t BeremizPLCObjectService_client::StartPLC(void)
     return result;
 }
 
-// BeremizPLCObjectService interface StopPLC function client shim.
-uint32_t BeremizPLCObjectService_client::StopPLC(bool * success)
+// BeremizPLCObjectService interface SetTransferEncoding function client shim.
+uint32_t BeremizPLCObjectService_client::SetTransferEncoding(uint32_t requested, uint32_t * accepted)
 {
     erpc_status_t err = kErpcStatus_Success;
 
@@ -1189,13 +2224,15 @@ uint32_t BeremizPLCObjectService_client::StopPLC(bool * success)
     }
     else
     {
-        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_StopPLCId, request.getSequence());
+        codec->startWriteMessage(message_type_t::kInvocationMessage, m_serviceId, m_SetTransferEncodingId, request.getSequence());
+
+        codec->write(requested);
 
         // Send message to server
         // Codec status is checked inside this function.
         m_clientManager->performRequest(request);
 
-        codec->read(*success);
+        codec->read(*accepted);
 
         codec->read(result);
 
@@ -1206,7 +2243,7 @@ uint32_t BeremizPLCObjectService_client::StopPLC(bool * success)
     m_clientManager->releaseRequest(request);
 
     // Invoke error handler callback function
-    m_clientManager->callErrorHandler(err, m_StopPLCId);
+    m_clientManager->callErrorHandler(err, m_SetTransferEncodingId);
 
 #if ERPC_PRE_POST_ACTION
     pre_post_action_cb postCB = m_clientManager->getPostCB();
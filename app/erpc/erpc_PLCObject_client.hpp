@@ -61,6 +61,26 @@ class BeremizPLCObjectService_client: public BeremizPLCObjectService_interface
 
         virtual uint32_t StopPLC(bool * success);
 
+        virtual uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces);
+
+        virtual uint32_t SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs);
+
+        virtual uint32_t GetStatistics(TraceStatistics * statistics);
+
+        virtual uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken);
+
+        virtual uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch);
+
+        virtual uint32_t QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present);
+
+        virtual uint32_t ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot);
+
+        virtual uint32_t WriteVariables(const list_variable_write_1_t * values);
+
+        virtual uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page);
+
+        virtual uint32_t SetTransferEncoding(uint32_t requested, uint32_t * accepted);
+
     protected:
         erpc::ClientManager *m_clientManager;
 };
@@ -48,6 +48,13 @@ typedef enum PLCstatus_enum
     Disconnected = 4
 } PLCstatus_enum;
 
+typedef enum stat_type_enum
+{
+    StatUnsigned = 0,
+    StatSigned = 1,
+    StatFloat = 2
+} stat_type_enum;
+
 // Aliases data types declarations
 typedef struct binary_t binary_t;
 typedef struct PSKID PSKID;
@@ -60,6 +67,23 @@ typedef struct list_extra_file_1_t list_extra_file_1_t;
 typedef struct trace_order trace_order;
 typedef struct list_trace_order_1_t list_trace_order_1_t;
 typedef struct log_message log_message;
+typedef struct stat_order stat_order;
+typedef struct list_stat_order_1_t list_stat_order_1_t;
+typedef struct var_statistics var_statistics;
+typedef struct list_var_statistics_1_t list_var_statistics_1_t;
+typedef struct TraceStatistics TraceStatistics;
+typedef struct decimated_trace_order decimated_trace_order;
+typedef struct list_decimated_trace_order_1_t list_decimated_trace_order_1_t;
+typedef struct log_entry log_entry;
+typedef struct list_log_entry_1_t list_log_entry_1_t;
+typedef struct log_batch log_batch;
+typedef struct list_binary_1_t list_binary_1_t;
+typedef struct list_bool_1_t list_bool_1_t;
+typedef struct variable_snapshot variable_snapshot;
+typedef struct variable_write variable_write;
+typedef struct list_variable_write_1_t list_variable_write_1_t;
+typedef struct list_uint32_1_t list_uint32_1_t;
+typedef struct TracePage TracePage;
 
 // Structures/unions data types declarations
 struct binary_t
@@ -130,6 +154,123 @@ struct log_message
     uint32_t nsec;
 };
 
+struct stat_order
+{
+    uint32_t idx;
+    stat_type_enum type;
+};
+
+struct list_stat_order_1_t
+{
+    stat_order * elements;
+    uint32_t elementsCount;
+};
+
+struct var_statistics
+{
+    uint32_t idx;
+    uint32_t samples;
+    double min;
+    double max;
+    double mean;
+    double last;
+    uint32_t changes;
+    uint32_t timeInState;
+};
+
+struct list_var_statistics_1_t
+{
+    var_statistics * elements;
+    uint32_t elementsCount;
+};
+
+struct TraceStatistics
+{
+    PLCstatus_enum PLCstatus;
+    uint32_t window;
+    list_var_statistics_1_t stats;
+};
+
+struct decimated_trace_order
+{
+    uint32_t idx;
+    binary_t force;
+    uint32_t divisor;
+};
+
+struct list_decimated_trace_order_1_t
+{
+    decimated_trace_order * elements;
+    uint32_t elementsCount;
+};
+
+struct log_entry
+{
+    uint32_t msgID;
+    char * msg;
+    uint32_t tick;
+    uint32_t sec;
+    uint32_t nsec;
+};
+
+struct list_log_entry_1_t
+{
+    log_entry * elements;
+    uint32_t elementsCount;
+};
+
+struct log_batch
+{
+    uint32_t count;
+    uint32_t nextID;
+    list_log_entry_1_t entries;
+};
+
+struct list_binary_1_t
+{
+    binary_t * elements;
+    uint32_t elementsCount;
+};
+
+struct list_bool_1_t
+{
+    bool * elements;
+    uint32_t elementsCount;
+};
+
+struct list_uint32_1_t
+{
+    uint32_t * elements;
+    uint32_t elementsCount;
+};
+
+struct variable_snapshot
+{
+    uint32_t tick;
+    binary_t values;
+    list_uint32_1_t sizes;
+};
+
+struct variable_write
+{
+    uint32_t idx;
+    binary_t value;
+};
+
+struct list_variable_write_1_t
+{
+    variable_write * elements;
+    uint32_t elementsCount;
+};
+
+struct TracePage
+{
+    TraceVariables samples;
+    bool more;
+    uint32_t dropped;
+    uint32_t discarded;
+};
+
 
 #endif // ERPC_TYPE_DEFINITIONS_ERPC_PLCOBJECT
 
@@ -44,6 +44,16 @@ class BeremizPLCObjectService_interface
         static const uint8_t m_SetTraceVariablesListId = 12;
         static const uint8_t m_StartPLCId = 13;
         static const uint8_t m_StopPLCId = 14;
+        static const uint8_t m_GetTraceVariablesWaitId = 15;
+        static const uint8_t m_SetStatisticsVariablesListId = 16;
+        static const uint8_t m_GetStatisticsId = 17;
+        static const uint8_t m_SetDecimatedTraceVariablesListId = 18;
+        static const uint8_t m_GetLogMessagesId = 19;
+        static const uint8_t m_QueryBlobsId = 20;
+        static const uint8_t m_ReadVariablesId = 21;
+        static const uint8_t m_WriteVariablesId = 22;
+        static const uint8_t m_GetTraceVariablesPageId = 23;
+        static const uint8_t m_SetTransferEncodingId = 24;
 
         virtual ~BeremizPLCObjectService_interface(void);
 
@@ -74,6 +84,26 @@ class BeremizPLCObjectService_interface
         virtual uint32_t StartPLC(void) = 0;
 
         virtual uint32_t StopPLC(bool * success) = 0;
+
+        virtual uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables * traces) = 0;
+
+        virtual uint32_t SetStatisticsVariablesList(const list_stat_order_1_t * orders, uint32_t windowMs) = 0;
+
+        virtual uint32_t GetStatistics(TraceStatistics * statistics) = 0;
+
+        virtual uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t * orders, uint32_t * debugtoken) = 0;
+
+        virtual uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch * batch) = 0;
+
+        virtual uint32_t QueryBlobs(const list_binary_1_t * blobIDs, list_bool_1_t * present) = 0;
+
+        virtual uint32_t ReadVariables(const list_uint32_1_t * idxs, variable_snapshot * snapshot) = 0;
+
+        virtual uint32_t WriteVariables(const list_variable_write_1_t * values) = 0;
+
+        virtual uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage * page) = 0;
+
+        virtual uint32_t SetTransferEncoding(uint32_t requested, uint32_t * accepted) = 0;
 private:
 };
 } // erpcShim
@@ -51,6 +51,30 @@ static void read_trace_order_struct(erpc::Codec * codec, trace_order * data);
 //! @brief Function to read struct list_trace_order_1_t
 static void read_list_trace_order_1_t_struct(erpc::Codec * codec, list_trace_order_1_t * data);
 
+//! @brief Function to read struct stat_order
+static void read_stat_order_struct(erpc::Codec * codec, stat_order * data);
+
+//! @brief Function to read struct list_stat_order_1_t
+static void read_list_stat_order_1_t_struct(erpc::Codec * codec, list_stat_order_1_t * data);
+
+//! @brief Function to read struct decimated_trace_order
+static void read_decimated_trace_order_struct(erpc::Codec * codec, decimated_trace_order * data);
+
+//! @brief Function to read struct list_decimated_trace_order_1_t
+static void read_list_decimated_trace_order_1_t_struct(erpc::Codec * codec, list_decimated_trace_order_1_t * data);
+
+//! @brief Function to read struct list_binary_1_t
+static void read_list_binary_1_t_struct(erpc::Codec * codec, list_binary_1_t * data);
+
+//! @brief Function to read struct list_uint32_1_t
+static void read_list_uint32_1_t_struct(erpc::Codec * codec, list_uint32_1_t * data);
+
+//! @brief Function to read struct variable_write
+static void read_variable_write_struct(erpc::Codec * codec, variable_write * data);
+
+//! @brief Function to read struct list_variable_write_1_t
+static void read_list_variable_write_1_t_struct(erpc::Codec * codec, list_variable_write_1_t * data);
+
 
 // Read struct binary_t function implementation
 static void read_binary_t_struct(erpc::Codec * codec, binary_t * data)
@@ -160,6 +184,150 @@ static void read_list_trace_order_1_t_struct(erpc::Codec * codec, list_trace_ord
     }
 }
 
+// Read struct stat_order function implementation
+static void read_stat_order_struct(erpc::Codec * codec, stat_order * data)
+{
+    int32_t _tmp_local_i32;
+
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->idx);
+
+    codec->read(_tmp_local_i32);
+    data->type = static_cast<stat_type_enum>(_tmp_local_i32);
+}
+
+// Read struct list_stat_order_1_t function implementation
+static void read_list_stat_order_1_t_struct(erpc::Codec * codec, list_stat_order_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (stat_order *) erpc_malloc(data->elementsCount * sizeof(stat_order));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_stat_order_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct decimated_trace_order function implementation
+static void read_decimated_trace_order_struct(erpc::Codec * codec, decimated_trace_order * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->idx);
+
+    read_binary_t_struct(codec, &(data->force));
+
+    codec->read(data->divisor);
+}
+
+// Read struct list_decimated_trace_order_1_t function implementation
+static void read_list_decimated_trace_order_1_t_struct(erpc::Codec * codec, list_decimated_trace_order_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (decimated_trace_order *) erpc_malloc(data->elementsCount * sizeof(decimated_trace_order));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_decimated_trace_order_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct list_binary_1_t function implementation
+static void read_list_binary_1_t_struct(erpc::Codec * codec, list_binary_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (binary_t *) erpc_malloc(data->elementsCount * sizeof(binary_t));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_binary_t_struct(codec, &(data->elements[listCount]));
+    }
+}
+
+// Read struct list_uint32_1_t function implementation
+static void read_list_uint32_1_t_struct(erpc::Codec * codec, list_uint32_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (uint32_t *) erpc_malloc(data->elementsCount * sizeof(uint32_t));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->read(data->elements[listCount]);
+    }
+}
+
+// Read struct variable_write function implementation
+static void read_variable_write_struct(erpc::Codec * codec, variable_write * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->read(data->idx);
+
+    read_binary_t_struct(codec, &(data->value));
+}
+
+// Read struct list_variable_write_1_t function implementation
+static void read_list_variable_write_1_t_struct(erpc::Codec * codec, list_variable_write_1_t * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startReadList(data->elementsCount);
+    data->elements = (variable_write *) erpc_malloc(data->elementsCount * sizeof(variable_write));
+    if ((data->elements == NULL) && (data->elementsCount > 0))
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        read_variable_write_struct(codec, &(data->elements[listCount]));
+    }
+}
+
 
 //! @brief Function to write struct binary_t
 static void write_binary_t_struct(erpc::Codec * codec, const binary_t * data);
@@ -182,6 +350,36 @@ static void write_TraceVariables_struct(erpc::Codec * codec, const TraceVariable
 //! @brief Function to write struct list_trace_sample_1_t
 static void write_list_trace_sample_1_t_struct(erpc::Codec * codec, const list_trace_sample_1_t * data);
 
+//! @brief Function to write struct var_statistics
+static void write_var_statistics_struct(erpc::Codec * codec, const var_statistics * data);
+
+//! @brief Function to write struct TraceStatistics
+static void write_TraceStatistics_struct(erpc::Codec * codec, const TraceStatistics * data);
+
+//! @brief Function to write struct list_var_statistics_1_t
+static void write_list_var_statistics_1_t_struct(erpc::Codec * codec, const list_var_statistics_1_t * data);
+
+//! @brief Function to write struct log_entry
+static void write_log_entry_struct(erpc::Codec * codec, const log_entry * data);
+
+//! @brief Function to write struct log_batch
+static void write_log_batch_struct(erpc::Codec * codec, const log_batch * data);
+
+//! @brief Function to write struct list_log_entry_1_t
+static void write_list_log_entry_1_t_struct(erpc::Codec * codec, const list_log_entry_1_t * data);
+
+//! @brief Function to write struct list_bool_1_t
+static void write_list_bool_1_t_struct(erpc::Codec * codec, const list_bool_1_t * data);
+
+//! @brief Function to write struct list_uint32_1_t
+static void write_list_uint32_1_t_struct(erpc::Codec * codec, const list_uint32_1_t * data);
+
+//! @brief Function to write struct variable_snapshot
+static void write_variable_snapshot_struct(erpc::Codec * codec, const variable_snapshot * data);
+
+//! @brief Function to write struct TracePage
+static void write_TracePage_struct(erpc::Codec * codec, const TracePage * data);
+
 
 // Write struct binary_t function implementation
 static void write_binary_t_struct(erpc::Codec * codec, const binary_t * data)
@@ -293,119 +491,446 @@ static void write_list_trace_sample_1_t_struct(erpc::Codec * codec, const list_t
     }
 }
 
+// Write struct var_statistics function implementation
+static void write_var_statistics_struct(erpc::Codec * codec, const var_statistics * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
 
-//! @brief Function to free space allocated inside struct binary_t
-static void free_binary_t_struct(binary_t * data);
+    codec->write(data->idx);
 
-//! @brief Function to free space allocated inside struct log_message
-static void free_log_message_struct(log_message * data);
+    codec->write(data->samples);
 
-//! @brief Function to free space allocated inside struct PSKID
-static void free_PSKID_struct(PSKID * data);
+    codec->write(data->min);
 
-//! @brief Function to free space allocated inside struct trace_sample
-static void free_trace_sample_struct(trace_sample * data);
+    codec->write(data->max);
 
-//! @brief Function to free space allocated inside struct TraceVariables
-static void free_TraceVariables_struct(TraceVariables * data);
+    codec->write(data->mean);
 
-//! @brief Function to free space allocated inside struct list_trace_sample_1_t
-static void free_list_trace_sample_1_t_struct(list_trace_sample_1_t * data);
+    codec->write(data->last);
 
-//! @brief Function to free space allocated inside struct extra_file
-static void free_extra_file_struct(extra_file * data);
+    codec->write(data->changes);
 
-//! @brief Function to free space allocated inside struct list_extra_file_1_t
-static void free_list_extra_file_1_t_struct(list_extra_file_1_t * data);
+    codec->write(data->timeInState);
+}
 
-//! @brief Function to free space allocated inside struct trace_order
-static void free_trace_order_struct(trace_order * data);
+// Write struct TraceStatistics function implementation
+static void write_TraceStatistics_struct(erpc::Codec * codec, const TraceStatistics * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
 
-//! @brief Function to free space allocated inside struct list_trace_order_1_t
-static void free_list_trace_order_1_t_struct(list_trace_order_1_t * data);
+    codec->write(static_cast<int32_t>(data->PLCstatus));
 
+    codec->write(data->window);
 
-// Free space allocated inside struct binary_t function implementation
-static void free_binary_t_struct(binary_t * data)
-{
-    erpc_free(data->data);
+    write_list_var_statistics_1_t_struct(codec, &(data->stats));
 }
 
-// Free space allocated inside struct log_message function implementation
-static void free_log_message_struct(log_message * data)
+// Write struct list_var_statistics_1_t function implementation
+static void write_list_var_statistics_1_t_struct(erpc::Codec * codec, const list_var_statistics_1_t * data)
 {
-    erpc_free(data->msg);
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_var_statistics_struct(codec, &(data->elements[listCount]));
+    }
 }
 
-// Free space allocated inside struct PSKID function implementation
-static void free_PSKID_struct(PSKID * data)
+// Write struct log_entry function implementation
+static void write_log_entry_struct(erpc::Codec * codec, const log_entry * data)
 {
-    erpc_free(data->ID);
+    if(NULL == data)
+    {
+        return;
+    }
 
-    erpc_free(data->PSK);
-}
+    codec->write(data->msgID);
 
-// Free space allocated inside struct trace_sample function implementation
-static void free_trace_sample_struct(trace_sample * data)
-{
-    free_binary_t_struct(&data->TraceBuffer);
-}
+    {
+        uint32_t msg_len = strlen((const char*)data->msg);
 
-// Free space allocated inside struct TraceVariables function implementation
-static void free_TraceVariables_struct(TraceVariables * data)
-{
-    free_list_trace_sample_1_t_struct(&data->traces);
+        codec->writeString(msg_len, (const char*)data->msg);
+    }
+
+    codec->write(data->tick);
+
+    codec->write(data->sec);
+
+    codec->write(data->nsec);
 }
 
-// Free space allocated inside struct list_trace_sample_1_t function implementation
-static void free_list_trace_sample_1_t_struct(list_trace_sample_1_t * data)
+// Write struct log_batch function implementation
+static void write_log_batch_struct(erpc::Codec * codec, const log_batch * data)
 {
-    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    if(NULL == data)
     {
-        free_trace_sample_struct(&data->elements[listCount]);
+        return;
     }
 
-    erpc_free(data->elements);
-}
+    codec->write(data->count);
 
-// Free space allocated inside struct extra_file function implementation
-static void free_extra_file_struct(extra_file * data)
-{
-    erpc_free(data->fname);
+    codec->write(data->nextID);
 
-    free_binary_t_struct(&data->blobID);
+    write_list_log_entry_1_t_struct(codec, &(data->entries));
 }
 
-// Free space allocated inside struct list_extra_file_1_t function implementation
-static void free_list_extra_file_1_t_struct(list_extra_file_1_t * data)
+// Write struct list_log_entry_1_t function implementation
+static void write_list_log_entry_1_t_struct(erpc::Codec * codec, const list_log_entry_1_t * data)
 {
-    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    if(NULL == data)
     {
-        free_extra_file_struct(&data->elements[listCount]);
+        return;
     }
 
-    erpc_free(data->elements);
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        write_log_entry_struct(codec, &(data->elements[listCount]));
+    }
 }
 
-// Free space allocated inside struct trace_order function implementation
-static void free_trace_order_struct(trace_order * data)
+// Write struct list_bool_1_t function implementation
+static void write_list_bool_1_t_struct(erpc::Codec * codec, const list_bool_1_t * data)
 {
-    free_binary_t_struct(&data->force);
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->write(data->elements[listCount]);
+    }
 }
 
-// Free space allocated inside struct list_trace_order_1_t function implementation
-static void free_list_trace_order_1_t_struct(list_trace_order_1_t * data)
+// Write struct list_uint32_1_t function implementation
+static void write_list_uint32_1_t_struct(erpc::Codec * codec, const list_uint32_1_t * data)
 {
-    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    if(NULL == data)
     {
-        free_trace_order_struct(&data->elements[listCount]);
+        return;
     }
 
-    erpc_free(data->elements);
+    codec->startWriteList(data->elementsCount);
+    for (uint32_t listCount = 0U; listCount < data->elementsCount; ++listCount)
+    {
+        codec->write(data->elements[listCount]);
+    }
 }
 
-
-
+// Write struct variable_snapshot function implementation
+static void write_variable_snapshot_struct(erpc::Codec * codec, const variable_snapshot * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    codec->write(data->tick);
+
+    write_binary_t_struct(codec, &(data->values));
+
+    write_list_uint32_1_t_struct(codec, &(data->sizes));
+}
+
+// Write struct TracePage function implementation
+static void write_TracePage_struct(erpc::Codec * codec, const TracePage * data)
+{
+    if(NULL == data)
+    {
+        return;
+    }
+
+    write_TraceVariables_struct(codec, &(data->samples));
+
+    codec->write(data->more);
+
+    codec->write(data->dropped);
+
+    codec->write(data->discarded);
+}
+
+
+//! @brief Function to free space allocated inside struct binary_t
+static void free_binary_t_struct(binary_t * data);
+
+//! @brief Function to free space allocated inside struct log_message
+static void free_log_message_struct(log_message * data);
+
+//! @brief Function to free space allocated inside struct PSKID
+static void free_PSKID_struct(PSKID * data);
+
+//! @brief Function to free space allocated inside struct trace_sample
+static void free_trace_sample_struct(trace_sample * data);
+
+//! @brief Function to free space allocated inside struct TraceVariables
+static void free_TraceVariables_struct(TraceVariables * data);
+
+//! @brief Function to free space allocated inside struct list_trace_sample_1_t
+static void free_list_trace_sample_1_t_struct(list_trace_sample_1_t * data);
+
+//! @brief Function to free space allocated inside struct extra_file
+static void free_extra_file_struct(extra_file * data);
+
+//! @brief Function to free space allocated inside struct list_extra_file_1_t
+static void free_list_extra_file_1_t_struct(list_extra_file_1_t * data);
+
+//! @brief Function to free space allocated inside struct trace_order
+static void free_trace_order_struct(trace_order * data);
+
+//! @brief Function to free space allocated inside struct list_trace_order_1_t
+static void free_list_trace_order_1_t_struct(list_trace_order_1_t * data);
+
+//! @brief Function to free space allocated inside struct list_stat_order_1_t
+static void free_list_stat_order_1_t_struct(list_stat_order_1_t * data);
+
+//! @brief Function to free space allocated inside struct TraceStatistics
+static void free_TraceStatistics_struct(TraceStatistics * data);
+
+//! @brief Function to free space allocated inside struct list_var_statistics_1_t
+static void free_list_var_statistics_1_t_struct(list_var_statistics_1_t * data);
+
+//! @brief Function to free space allocated inside struct decimated_trace_order
+static void free_decimated_trace_order_struct(decimated_trace_order * data);
+
+//! @brief Function to free space allocated inside struct list_decimated_trace_order_1_t
+static void free_list_decimated_trace_order_1_t_struct(list_decimated_trace_order_1_t * data);
+
+//! @brief Function to free space allocated inside struct log_entry
+static void free_log_entry_struct(log_entry * data);
+
+//! @brief Function to free space allocated inside struct log_batch
+static void free_log_batch_struct(log_batch * data);
+
+//! @brief Function to free space allocated inside struct list_log_entry_1_t
+static void free_list_log_entry_1_t_struct(list_log_entry_1_t * data);
+
+//! @brief Function to free space allocated inside struct list_binary_1_t
+static void free_list_binary_1_t_struct(list_binary_1_t * data);
+
+//! @brief Function to free space allocated inside struct list_bool_1_t
+static void free_list_bool_1_t_struct(list_bool_1_t * data);
+
+//! @brief Function to free space allocated inside struct list_uint32_1_t
+static void free_list_uint32_1_t_struct(list_uint32_1_t * data);
+
+//! @brief Function to free space allocated inside struct variable_write
+static void free_variable_write_struct(variable_write * data);
+
+//! @brief Function to free space allocated inside struct list_variable_write_1_t
+static void free_list_variable_write_1_t_struct(list_variable_write_1_t * data);
+
+//! @brief Function to free space allocated inside struct variable_snapshot
+static void free_variable_snapshot_struct(variable_snapshot * data);
+
+//! @brief Function to free space allocated inside struct TracePage
+static void free_TracePage_struct(TracePage * data);
+
+
+// Free space allocated inside struct binary_t function implementation
+static void free_binary_t_struct(binary_t * data)
+{
+    erpc_free(data->data);
+}
+
+// Free space allocated inside struct log_message function implementation
+static void free_log_message_struct(log_message * data)
+{
+    erpc_free(data->msg);
+}
+
+// Free space allocated inside struct PSKID function implementation
+static void free_PSKID_struct(PSKID * data)
+{
+    erpc_free(data->ID);
+
+    erpc_free(data->PSK);
+}
+
+// Free space allocated inside struct trace_sample function implementation
+static void free_trace_sample_struct(trace_sample * data)
+{
+    free_binary_t_struct(&data->TraceBuffer);
+}
+
+// Free space allocated inside struct TraceVariables function implementation
+static void free_TraceVariables_struct(TraceVariables * data)
+{
+    free_list_trace_sample_1_t_struct(&data->traces);
+}
+
+// Free space allocated inside struct list_trace_sample_1_t function implementation
+static void free_list_trace_sample_1_t_struct(list_trace_sample_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_trace_sample_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct extra_file function implementation
+static void free_extra_file_struct(extra_file * data)
+{
+    erpc_free(data->fname);
+
+    free_binary_t_struct(&data->blobID);
+}
+
+// Free space allocated inside struct list_extra_file_1_t function implementation
+static void free_list_extra_file_1_t_struct(list_extra_file_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_extra_file_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct trace_order function implementation
+static void free_trace_order_struct(trace_order * data)
+{
+    free_binary_t_struct(&data->force);
+}
+
+// Free space allocated inside struct list_trace_order_1_t function implementation
+static void free_list_trace_order_1_t_struct(list_trace_order_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_trace_order_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct list_stat_order_1_t function implementation
+static void free_list_stat_order_1_t_struct(list_stat_order_1_t * data)
+{
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct TraceStatistics function implementation
+static void free_TraceStatistics_struct(TraceStatistics * data)
+{
+    free_list_var_statistics_1_t_struct(&data->stats);
+}
+
+// Free space allocated inside struct list_var_statistics_1_t function implementation
+static void free_list_var_statistics_1_t_struct(list_var_statistics_1_t * data)
+{
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct decimated_trace_order function implementation
+static void free_decimated_trace_order_struct(decimated_trace_order * data)
+{
+    free_binary_t_struct(&data->force);
+}
+
+// Free space allocated inside struct list_decimated_trace_order_1_t function implementation
+static void free_list_decimated_trace_order_1_t_struct(list_decimated_trace_order_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_decimated_trace_order_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct log_entry function implementation
+static void free_log_entry_struct(log_entry * data)
+{
+    erpc_free(data->msg);
+}
+
+// Free space allocated inside struct log_batch function implementation
+static void free_log_batch_struct(log_batch * data)
+{
+    free_list_log_entry_1_t_struct(&data->entries);
+}
+
+// Free space allocated inside struct list_log_entry_1_t function implementation
+static void free_list_log_entry_1_t_struct(list_log_entry_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_log_entry_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct list_binary_1_t function implementation
+static void free_list_binary_1_t_struct(list_binary_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_binary_t_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct list_bool_1_t function implementation
+static void free_list_bool_1_t_struct(list_bool_1_t * data)
+{
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct list_uint32_1_t function implementation
+static void free_list_uint32_1_t_struct(list_uint32_1_t * data)
+{
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct variable_write function implementation
+static void free_variable_write_struct(variable_write * data)
+{
+    free_binary_t_struct(&data->value);
+}
+
+// Free space allocated inside struct list_variable_write_1_t function implementation
+static void free_list_variable_write_1_t_struct(list_variable_write_1_t * data)
+{
+    for (uint32_t listCount = 0; listCount < data->elementsCount; ++listCount)
+    {
+        free_variable_write_struct(&data->elements[listCount]);
+    }
+
+    erpc_free(data->elements);
+}
+
+// Free space allocated inside struct variable_snapshot function implementation
+static void free_variable_snapshot_struct(variable_snapshot * data)
+{
+    free_binary_t_struct(&data->values);
+
+    free_list_uint32_1_t_struct(&data->sizes);
+}
+
+// Free space allocated inside struct TracePage function implementation
+static void free_TracePage_struct(TracePage * data)
+{
+    free_TraceVariables_struct(&data->samples);
+}
+
+
+
 BeremizPLCObjectService_service::BeremizPLCObjectService_service(BeremizPLCObjectService_interface *_BeremizPLCObjectService_interface)
     : erpc::Service(BeremizPLCObjectService_interface::m_serviceId)
     , m_handler(_BeremizPLCObjectService_interface)
@@ -512,37 +1037,97 @@ erpc_status_t BeremizPLCObjectService_service::handleInvocation(uint32_t methodI
             break;
         }
 
-        default:
+        case BeremizPLCObjectService_interface::m_GetTraceVariablesWaitId:
         {
-            erpcStatus = kErpcStatus_InvalidArgument;
+            erpcStatus = GetTraceVariablesWait_shim(codec, messageFactory, transport, sequence);
             break;
         }
-    }
-
-    return erpcStatus;
-}
 
-// Server shim for AppendChunkToBlob of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::AppendChunkToBlob_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
-{
-    erpc_status_t err = kErpcStatus_Success;
+        case BeremizPLCObjectService_interface::m_SetStatisticsVariablesListId:
+        {
+            erpcStatus = SetStatisticsVariablesList_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
 
-    binary_t *data = NULL;
-    data = (binary_t *) erpc_malloc(sizeof(binary_t));
-    if (data == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-    binary_t *blobID = NULL;
-    blobID = (binary_t *) erpc_malloc(sizeof(binary_t));
-    if (blobID == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-    binary_t *newBlobID = NULL;
-    uint32_t result;
+        case BeremizPLCObjectService_interface::m_GetStatisticsId:
+        {
+            erpcStatus = GetStatistics_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
 
-    // startReadMessage() was already called before this shim was invoked.
+        case BeremizPLCObjectService_interface::m_SetDecimatedTraceVariablesListId:
+        {
+            erpcStatus = SetDecimatedTraceVariablesList_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_GetLogMessagesId:
+        {
+            erpcStatus = GetLogMessages_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_QueryBlobsId:
+        {
+            erpcStatus = QueryBlobs_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_ReadVariablesId:
+        {
+            erpcStatus = ReadVariables_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_WriteVariablesId:
+        {
+            erpcStatus = WriteVariables_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_GetTraceVariablesPageId:
+        {
+            erpcStatus = GetTraceVariablesPage_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        case BeremizPLCObjectService_interface::m_SetTransferEncodingId:
+        {
+            erpcStatus = SetTransferEncoding_shim(codec, messageFactory, transport, sequence);
+            break;
+        }
+
+        default:
+        {
+            erpcStatus = kErpcStatus_InvalidArgument;
+            break;
+        }
+    }
+
+    return erpcStatus;
+}
+
+// Server shim for AppendChunkToBlob of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::AppendChunkToBlob_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    binary_t *data = NULL;
+    data = (binary_t *) erpc_malloc(sizeof(binary_t));
+    if (data == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    binary_t *blobID = NULL;
+    blobID = (binary_t *) erpc_malloc(sizeof(binary_t));
+    if (blobID == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    binary_t *newBlobID = NULL;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
 
     read_binary_t_struct(codec, data);
 
@@ -635,7 +1220,579 @@ erpc_status_t BeremizPLCObjectService_service::GetLogMessage_shim(Codec * codec,
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->GetLogMessage(level, msgID, message);
+        result = m_handler->GetLogMessage(level, msgID, message);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetLogMessageId, sequence);
+
+        write_log_message_struct(codec, message);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    if (message)
+    {
+        free_log_message_struct(message);
+    }
+    erpc_free(message);
+
+    return err;
+}
+
+// Server shim for GetPLCID of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetPLCID_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    PSKID *plcID = NULL;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    plcID = (PSKID *) erpc_malloc(sizeof(PSKID));
+    if (plcID == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->GetPLCID(plcID);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetPLCIDId, sequence);
+
+        write_PSKID_struct(codec, plcID);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    if (plcID)
+    {
+        free_PSKID_struct(plcID);
+    }
+    erpc_free(plcID);
+
+    return err;
+}
+
+// Server shim for GetPLCstatus of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetPLCstatus_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    PLCstatus *status = NULL;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    status = (PLCstatus *) erpc_malloc(sizeof(PLCstatus));
+    if (status == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->GetPLCstatus(status);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetPLCstatusId, sequence);
+
+        write_PLCstatus_struct(codec, status);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    erpc_free(status);
+
+    return err;
+}
+
+// Server shim for GetTraceVariables of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t debugToken;
+    TraceVariables *traces = NULL;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    codec->read(debugToken);
+
+    traces = (TraceVariables *) erpc_malloc(sizeof(TraceVariables));
+    if (traces == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->GetTraceVariables(debugToken, traces);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetTraceVariablesId, sequence);
+
+        write_TraceVariables_struct(codec, traces);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    if (traces)
+    {
+        free_TraceVariables_struct(traces);
+    }
+    erpc_free(traces);
+
+    return err;
+}
+
+// Server shim for MatchMD5 of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::MatchMD5_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    char * MD5 = NULL;
+    bool match;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    {
+        uint32_t MD5_len;
+        char * MD5_local;
+        codec->readString(MD5_len, &MD5_local);
+        MD5 = (char*) erpc_malloc((MD5_len + 1) * sizeof(char));
+        if ((MD5 == NULL) || (MD5_local == NULL))
+        {
+            codec->updateStatus(kErpcStatus_MemoryError);
+        }
+        else
+        {
+            memcpy(MD5, MD5_local, MD5_len);
+            (MD5)[MD5_len] = 0;
+        }
+    }
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->MatchMD5(MD5, &match);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_MatchMD5Id, sequence);
+
+        codec->write(match);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    erpc_free(MD5);
+
+    return err;
+}
+
+// Server shim for NewPLC of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::NewPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    char * md5sum = NULL;
+    binary_t *plcObjectBlobID = NULL;
+    plcObjectBlobID = (binary_t *) erpc_malloc(sizeof(binary_t));
+    if (plcObjectBlobID == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    list_extra_file_1_t *extrafiles = NULL;
+    extrafiles = (list_extra_file_1_t *) erpc_malloc(sizeof(list_extra_file_1_t));
+    if (extrafiles == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    bool success;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    {
+        uint32_t md5sum_len;
+        char * md5sum_local;
+        codec->readString(md5sum_len, &md5sum_local);
+        md5sum = (char*) erpc_malloc((md5sum_len + 1) * sizeof(char));
+        if ((md5sum == NULL) || (md5sum_local == NULL))
+        {
+            codec->updateStatus(kErpcStatus_MemoryError);
+        }
+        else
+        {
+            memcpy(md5sum, md5sum_local, md5sum_len);
+            (md5sum)[md5sum_len] = 0;
+        }
+    }
+
+    read_binary_t_struct(codec, plcObjectBlobID);
+
+    read_list_extra_file_1_t_struct(codec, extrafiles);
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->NewPLC(md5sum, plcObjectBlobID, extrafiles, &success);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_NewPLCId, sequence);
+
+        codec->write(success);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    erpc_free(md5sum);
+
+    if (plcObjectBlobID)
+    {
+        free_binary_t_struct(plcObjectBlobID);
+    }
+    erpc_free(plcObjectBlobID);
+
+    if (extrafiles)
+    {
+        free_list_extra_file_1_t_struct(extrafiles);
+    }
+    erpc_free(extrafiles);
+
+    return err;
+}
+
+// Server shim for PurgeBlobs of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::PurgeBlobs_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->PurgeBlobs();
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_PurgeBlobsId, sequence);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    return err;
+}
+
+// Server shim for RepairPLC of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::RepairPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->RepairPLC();
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_RepairPLCId, sequence);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    return err;
+}
+
+// Server shim for ResetLogCount of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::ResetLogCount_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->ResetLogCount();
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_ResetLogCountId, sequence);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    return err;
+}
+
+// Server shim for SeedBlob of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::SeedBlob_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    binary_t *seed = NULL;
+    seed = (binary_t *) erpc_malloc(sizeof(binary_t));
+    if (seed == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    binary_t *blobID = NULL;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    read_binary_t_struct(codec, seed);
+
+    blobID = (binary_t *) erpc_malloc(sizeof(binary_t));
+    if (blobID == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->SeedBlob(seed, blobID);
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = false;
+#endif
+
+        // preparing MessageBuffer for serializing data
+        err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+    }
+
+    if (err == kErpcStatus_Success)
+    {
+        // preparing codec for serializing data
+        codec->reset(transport->reserveHeaderSize());
+
+        // Build response message.
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SeedBlobId, sequence);
+
+        write_binary_t_struct(codec, blobID);
+
+        codec->write(result);
+
+        err = codec->getStatus();
+    }
+
+    if (seed)
+    {
+        free_binary_t_struct(seed);
+    }
+    erpc_free(seed);
+
+    if (blobID)
+    {
+        free_binary_t_struct(blobID);
+    }
+    erpc_free(blobID);
+
+    return err;
+}
+
+// Server shim for SetTraceVariablesList of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::SetTraceVariablesList_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+{
+    erpc_status_t err = kErpcStatus_Success;
+
+    list_trace_order_1_t *orders = NULL;
+    orders = (list_trace_order_1_t *) erpc_malloc(sizeof(list_trace_order_1_t));
+    if (orders == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    uint32_t debugtoken;
+    uint32_t result;
+
+    // startReadMessage() was already called before this shim was invoked.
+
+    read_list_trace_order_1_t_struct(codec, orders);
+
+    err = codec->getStatus();
+    if (err == kErpcStatus_Success)
+    {
+        // Invoke the actual served function.
+#if ERPC_NESTED_CALLS_DETECTION
+        nestingDetection = true;
+#endif
+        result = m_handler->SetTraceVariablesList(orders, &debugtoken);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -650,40 +1807,33 @@ erpc_status_t BeremizPLCObjectService_service::GetLogMessage_shim(Codec * codec,
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetLogMessageId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SetTraceVariablesListId, sequence);
 
-        write_log_message_struct(codec, message);
+        codec->write(debugtoken);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    if (message)
+    if (orders)
     {
-        free_log_message_struct(message);
+        free_list_trace_order_1_t_struct(orders);
     }
-    erpc_free(message);
+    erpc_free(orders);
 
     return err;
 }
 
-// Server shim for GetPLCID of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::GetPLCID_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for StartPLC of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::StartPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    PSKID *plcID = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
-    plcID = (PSKID *) erpc_malloc(sizeof(PSKID));
-    if (plcID == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -691,7 +1841,7 @@ erpc_status_t BeremizPLCObjectService_service::GetPLCID_shim(Codec * codec, Mess
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->GetPLCID(plcID);
+        result = m_handler->StartPLC();
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -706,40 +1856,26 @@ erpc_status_t BeremizPLCObjectService_service::GetPLCID_shim(Codec * codec, Mess
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetPLCIDId, sequence);
-
-        write_PSKID_struct(codec, plcID);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_StartPLCId, sequence);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    if (plcID)
-    {
-        free_PSKID_struct(plcID);
-    }
-    erpc_free(plcID);
-
     return err;
 }
 
-// Server shim for GetPLCstatus of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::GetPLCstatus_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for StopPLC of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::StopPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    PLCstatus *status = NULL;
+    bool success;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
-    status = (PLCstatus *) erpc_malloc(sizeof(PLCstatus));
-    if (status == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -747,7 +1883,7 @@ erpc_status_t BeremizPLCObjectService_service::GetPLCstatus_shim(Codec * codec,
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->GetPLCstatus(status);
+        result = m_handler->StopPLC(&success);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -762,26 +1898,26 @@ erpc_status_t BeremizPLCObjectService_service::GetPLCstatus_shim(Codec * codec,
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetPLCstatusId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_StopPLCId, sequence);
 
-        write_PLCstatus_struct(codec, status);
+        codec->write(success);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    erpc_free(status);
-
     return err;
 }
 
-// Server shim for GetTraceVariables of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for GetTraceVariablesWait of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetTraceVariablesWait_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
     uint32_t debugToken;
+    uint32_t timeoutMs;
+    uint32_t minSamples;
     TraceVariables *traces = NULL;
     uint32_t result;
 
@@ -789,6 +1925,10 @@ erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * co
 
     codec->read(debugToken);
 
+    codec->read(timeoutMs);
+
+    codec->read(minSamples);
+
     traces = (TraceVariables *) erpc_malloc(sizeof(TraceVariables));
     if (traces == NULL)
     {
@@ -802,7 +1942,7 @@ erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * co
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->GetTraceVariables(debugToken, traces);
+        result = m_handler->GetTraceVariablesWait(debugToken, timeoutMs, minSamples, traces);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -817,7 +1957,7 @@ erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * co
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetTraceVariablesId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetTraceVariablesWaitId, sequence);
 
         write_TraceVariables_struct(codec, traces);
 
@@ -835,32 +1975,25 @@ erpc_status_t BeremizPLCObjectService_service::GetTraceVariables_shim(Codec * co
     return err;
 }
 
-// Server shim for MatchMD5 of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::MatchMD5_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for SetStatisticsVariablesList of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::SetStatisticsVariablesList_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    char * MD5 = NULL;
-    bool match;
+    list_stat_order_1_t *orders = NULL;
+    orders = (list_stat_order_1_t *) erpc_malloc(sizeof(list_stat_order_1_t));
+    if (orders == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    uint32_t windowMs;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
-    {
-        uint32_t MD5_len;
-        char * MD5_local;
-        codec->readString(MD5_len, &MD5_local);
-        MD5 = (char*) erpc_malloc((MD5_len + 1) * sizeof(char));
-        if ((MD5 == NULL) || (MD5_local == NULL))
-        {
-            codec->updateStatus(kErpcStatus_MemoryError);
-        }
-        else
-        {
-            memcpy(MD5, MD5_local, MD5_len);
-            (MD5)[MD5_len] = 0;
-        }
-    }
+    read_list_stat_order_1_t_struct(codec, orders);
+
+    codec->read(windowMs);
 
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
@@ -869,7 +2002,7 @@ erpc_status_t BeremizPLCObjectService_service::MatchMD5_shim(Codec * codec, Mess
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->MatchMD5(MD5, &match);
+        result = m_handler->SetStatisticsVariablesList(orders, windowMs);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -884,63 +2017,38 @@ erpc_status_t BeremizPLCObjectService_service::MatchMD5_shim(Codec * codec, Mess
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_MatchMD5Id, sequence);
-
-        codec->write(match);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SetStatisticsVariablesListId, sequence);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    erpc_free(MD5);
+    if (orders)
+    {
+        free_list_stat_order_1_t_struct(orders);
+    }
+    erpc_free(orders);
 
     return err;
 }
 
-// Server shim for NewPLC of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::NewPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for GetStatistics of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetStatistics_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    char * md5sum = NULL;
-    binary_t *plcObjectBlobID = NULL;
-    plcObjectBlobID = (binary_t *) erpc_malloc(sizeof(binary_t));
-    if (plcObjectBlobID == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-    list_extra_file_1_t *extrafiles = NULL;
-    extrafiles = (list_extra_file_1_t *) erpc_malloc(sizeof(list_extra_file_1_t));
-    if (extrafiles == NULL)
-    {
-        codec->updateStatus(kErpcStatus_MemoryError);
-    }
-    bool success;
+    TraceStatistics *statistics = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    statistics = (TraceStatistics *) erpc_malloc(sizeof(TraceStatistics));
+    if (statistics == NULL)
     {
-        uint32_t md5sum_len;
-        char * md5sum_local;
-        codec->readString(md5sum_len, &md5sum_local);
-        md5sum = (char*) erpc_malloc((md5sum_len + 1) * sizeof(char));
-        if ((md5sum == NULL) || (md5sum_local == NULL))
-        {
-            codec->updateStatus(kErpcStatus_MemoryError);
-        }
-        else
-        {
-            memcpy(md5sum, md5sum_local, md5sum_len);
-            (md5sum)[md5sum_len] = 0;
-        }
+        codec->updateStatus(kErpcStatus_MemoryError);
     }
 
-    read_binary_t_struct(codec, plcObjectBlobID);
-
-    read_list_extra_file_1_t_struct(codec, extrafiles);
-
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -948,7 +2056,7 @@ erpc_status_t BeremizPLCObjectService_service::NewPLC_shim(Codec * codec, Messag
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->NewPLC(md5sum, plcObjectBlobID, extrafiles, &success);
+        result = m_handler->GetStatistics(statistics);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -963,41 +2071,42 @@ erpc_status_t BeremizPLCObjectService_service::NewPLC_shim(Codec * codec, Messag
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_NewPLCId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetStatisticsId, sequence);
 
-        codec->write(success);
+        write_TraceStatistics_struct(codec, statistics);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    erpc_free(md5sum);
-
-    if (plcObjectBlobID)
-    {
-        free_binary_t_struct(plcObjectBlobID);
-    }
-    erpc_free(plcObjectBlobID);
-
-    if (extrafiles)
+    if (statistics)
     {
-        free_list_extra_file_1_t_struct(extrafiles);
+        free_TraceStatistics_struct(statistics);
     }
-    erpc_free(extrafiles);
+    erpc_free(statistics);
 
     return err;
 }
 
-// Server shim for PurgeBlobs of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::PurgeBlobs_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for SetDecimatedTraceVariablesList of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::SetDecimatedTraceVariablesList_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
+    list_decimated_trace_order_1_t *orders = NULL;
+    orders = (list_decimated_trace_order_1_t *) erpc_malloc(sizeof(list_decimated_trace_order_1_t));
+    if (orders == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    uint32_t debugtoken;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    read_list_decimated_trace_order_1_t_struct(codec, orders);
+
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -1005,7 +2114,7 @@ erpc_status_t BeremizPLCObjectService_service::PurgeBlobs_shim(Codec * codec, Me
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->PurgeBlobs();
+        result = m_handler->SetDecimatedTraceVariablesList(orders, &debugtoken);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1020,25 +2129,55 @@ erpc_status_t BeremizPLCObjectService_service::PurgeBlobs_shim(Codec * codec, Me
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_PurgeBlobsId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SetDecimatedTraceVariablesListId, sequence);
+
+        codec->write(debugtoken);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
+    if (orders)
+    {
+        free_list_decimated_trace_order_1_t_struct(orders);
+    }
+    erpc_free(orders);
+
     return err;
 }
 
-// Server shim for RepairPLC of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::RepairPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for GetLogMessages of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetLogMessages_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
+    uint8_t level;
+    uint32_t firstID;
+    uint32_t maxCount;
+    uint32_t fromSec;
+    uint32_t toSec;
+    log_batch *batch = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    codec->read(level);
+
+    codec->read(firstID);
+
+    codec->read(maxCount);
+
+    codec->read(fromSec);
+
+    codec->read(toSec);
+
+    batch = (log_batch *) erpc_malloc(sizeof(log_batch));
+    if (batch == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -1046,7 +2185,7 @@ erpc_status_t BeremizPLCObjectService_service::RepairPLC_shim(Codec * codec, Mes
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->RepairPLC();
+        result = m_handler->GetLogMessages(level, firstID, maxCount, fromSec, toSec, batch);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1061,25 +2200,48 @@ erpc_status_t BeremizPLCObjectService_service::RepairPLC_shim(Codec * codec, Mes
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_RepairPLCId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetLogMessagesId, sequence);
+
+        write_log_batch_struct(codec, batch);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
+    if (batch)
+    {
+        free_log_batch_struct(batch);
+    }
+    erpc_free(batch);
+
     return err;
 }
 
-// Server shim for ResetLogCount of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::ResetLogCount_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for QueryBlobs of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::QueryBlobs_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
+    list_binary_1_t *blobIDs = NULL;
+    blobIDs = (list_binary_1_t *) erpc_malloc(sizeof(list_binary_1_t));
+    if (blobIDs == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+    list_bool_1_t *present = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    read_list_binary_1_t_struct(codec, blobIDs);
+
+    present = (list_bool_1_t *) erpc_malloc(sizeof(list_bool_1_t));
+    if (present == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -1087,7 +2249,7 @@ erpc_status_t BeremizPLCObjectService_service::ResetLogCount_shim(Codec * codec,
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->ResetLogCount();
+        result = m_handler->QueryBlobs(blobIDs, present);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1102,36 +2264,50 @@ erpc_status_t BeremizPLCObjectService_service::ResetLogCount_shim(Codec * codec,
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_ResetLogCountId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_QueryBlobsId, sequence);
+
+        write_list_bool_1_t_struct(codec, present);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
+    if (blobIDs)
+    {
+        free_list_binary_1_t_struct(blobIDs);
+    }
+    erpc_free(blobIDs);
+
+    if (present)
+    {
+        free_list_bool_1_t_struct(present);
+    }
+    erpc_free(present);
+
     return err;
 }
 
-// Server shim for SeedBlob of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::SeedBlob_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for ReadVariables of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::ReadVariables_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    binary_t *seed = NULL;
-    seed = (binary_t *) erpc_malloc(sizeof(binary_t));
-    if (seed == NULL)
+    list_uint32_1_t *idxs = NULL;
+    idxs = (list_uint32_1_t *) erpc_malloc(sizeof(list_uint32_1_t));
+    if (idxs == NULL)
     {
         codec->updateStatus(kErpcStatus_MemoryError);
     }
-    binary_t *blobID = NULL;
+    variable_snapshot *snapshot = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
-    read_binary_t_struct(codec, seed);
+    read_list_uint32_1_t_struct(codec, idxs);
 
-    blobID = (binary_t *) erpc_malloc(sizeof(binary_t));
-    if (blobID == NULL)
+    snapshot = (variable_snapshot *) erpc_malloc(sizeof(variable_snapshot));
+    if (snapshot == NULL)
     {
         codec->updateStatus(kErpcStatus_MemoryError);
     }
@@ -1143,7 +2319,7 @@ erpc_status_t BeremizPLCObjectService_service::SeedBlob_shim(Codec * codec, Mess
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->SeedBlob(seed, blobID);
+        result = m_handler->ReadVariables(idxs, snapshot);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1158,47 +2334,46 @@ erpc_status_t BeremizPLCObjectService_service::SeedBlob_shim(Codec * codec, Mess
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SeedBlobId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_ReadVariablesId, sequence);
 
-        write_binary_t_struct(codec, blobID);
+        write_variable_snapshot_struct(codec, snapshot);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    if (seed)
+    if (idxs)
     {
-        free_binary_t_struct(seed);
+        free_list_uint32_1_t_struct(idxs);
     }
-    erpc_free(seed);
+    erpc_free(idxs);
 
-    if (blobID)
+    if (snapshot)
     {
-        free_binary_t_struct(blobID);
+        free_variable_snapshot_struct(snapshot);
     }
-    erpc_free(blobID);
+    erpc_free(snapshot);
 
     return err;
 }
 
-// Server shim for SetTraceVariablesList of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::SetTraceVariablesList_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for WriteVariables of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::WriteVariables_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    list_trace_order_1_t *orders = NULL;
-    orders = (list_trace_order_1_t *) erpc_malloc(sizeof(list_trace_order_1_t));
-    if (orders == NULL)
+    list_variable_write_1_t *values = NULL;
+    values = (list_variable_write_1_t *) erpc_malloc(sizeof(list_variable_write_1_t));
+    if (values == NULL)
     {
         codec->updateStatus(kErpcStatus_MemoryError);
     }
-    uint32_t debugtoken;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
-    read_list_trace_order_1_t_struct(codec, orders);
+    read_list_variable_write_1_t_struct(codec, values);
 
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
@@ -1207,7 +2382,7 @@ erpc_status_t BeremizPLCObjectService_service::SetTraceVariablesList_shim(Codec
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->SetTraceVariablesList(orders, &debugtoken);
+        result = m_handler->WriteVariables(values);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1222,33 +2397,50 @@ erpc_status_t BeremizPLCObjectService_service::SetTraceVariablesList_shim(Codec
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SetTraceVariablesListId, sequence);
-
-        codec->write(debugtoken);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_WriteVariablesId, sequence);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
-    if (orders)
+    if (values)
     {
-        free_list_trace_order_1_t_struct(orders);
+        free_list_variable_write_1_t_struct(values);
     }
-    erpc_free(orders);
+    erpc_free(values);
 
     return err;
 }
 
-// Server shim for StartPLC of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::StartPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for GetTraceVariablesPage of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::GetTraceVariablesPage_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
+    uint32_t debugToken;
+    uint32_t timeoutMs;
+    uint32_t minSamples;
+    uint32_t maxSize;
+    TracePage *page = NULL;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    codec->read(debugToken);
+
+    codec->read(timeoutMs);
+
+    codec->read(minSamples);
+
+    codec->read(maxSize);
+
+    page = (TracePage *) erpc_malloc(sizeof(TracePage));
+    if (page == NULL)
+    {
+        codec->updateStatus(kErpcStatus_MemoryError);
+    }
+
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -1256,7 +2448,7 @@ erpc_status_t BeremizPLCObjectService_service::StartPLC_shim(Codec * codec, Mess
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->StartPLC();
+        result = m_handler->GetTraceVariablesPage(debugToken, timeoutMs, minSamples, maxSize, page);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1271,26 +2463,37 @@ erpc_status_t BeremizPLCObjectService_service::StartPLC_shim(Codec * codec, Mess
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_StartPLCId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_GetTraceVariablesPageId, sequence);
+
+        write_TracePage_struct(codec, page);
 
         codec->write(result);
 
         err = codec->getStatus();
     }
 
+    if (page)
+    {
+        free_TracePage_struct(page);
+    }
+    erpc_free(page);
+
     return err;
 }
 
-// Server shim for StopPLC of BeremizPLCObjectService interface.
-erpc_status_t BeremizPLCObjectService_service::StopPLC_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
+// Server shim for SetTransferEncoding of BeremizPLCObjectService interface.
+erpc_status_t BeremizPLCObjectService_service::SetTransferEncoding_shim(Codec * codec, MessageBufferFactory *messageFactory, Transport * transport, uint32_t sequence)
 {
     erpc_status_t err = kErpcStatus_Success;
 
-    bool success;
+    uint32_t requested;
+    uint32_t accepted;
     uint32_t result;
 
     // startReadMessage() was already called before this shim was invoked.
 
+    codec->read(requested);
+
     err = codec->getStatus();
     if (err == kErpcStatus_Success)
     {
@@ -1298,7 +2501,7 @@ erpc_status_t BeremizPLCObjectService_service::StopPLC_shim(Codec * codec, Messa
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = true;
 #endif
-        result = m_handler->StopPLC(&success);
+        result = m_handler->SetTransferEncoding(requested, &accepted);
 #if ERPC_NESTED_CALLS_DETECTION
         nestingDetection = false;
 #endif
@@ -1313,9 +2516,9 @@ erpc_status_t BeremizPLCObjectService_service::StopPLC_shim(Codec * codec, Messa
         codec->reset(transport->reserveHeaderSize());
 
         // Build response message.
-        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_StopPLCId, sequence);
+        codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId, BeremizPLCObjectService_interface::m_SetTransferEncodingId, sequence);
 
-        codec->write(success);
+        codec->write(accepted);
 
         codec->write(result);
 
@@ -91,6 +91,36 @@ private:
 
     /*! @brief Server shim for StopPLC of BeremizPLCObjectService interface. */
     erpc_status_t StopPLC_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for GetTraceVariablesWait of BeremizPLCObjectService interface. */
+    erpc_status_t GetTraceVariablesWait_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for SetStatisticsVariablesList of BeremizPLCObjectService interface. */
+    erpc_status_t SetStatisticsVariablesList_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for GetStatistics of BeremizPLCObjectService interface. */
+    erpc_status_t GetStatistics_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for SetDecimatedTraceVariablesList of BeremizPLCObjectService interface. */
+    erpc_status_t SetDecimatedTraceVariablesList_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for GetLogMessages of BeremizPLCObjectService interface. */
+    erpc_status_t GetLogMessages_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for QueryBlobs of BeremizPLCObjectService interface. */
+    erpc_status_t QueryBlobs_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for ReadVariables of BeremizPLCObjectService interface. */
+    erpc_status_t ReadVariables_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for WriteVariables of BeremizPLCObjectService interface. */
+    erpc_status_t WriteVariables_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for GetTraceVariablesPage of BeremizPLCObjectService interface. */
+    erpc_status_t GetTraceVariablesPage_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
+
+    /*! @brief Server shim for SetTransferEncoding of BeremizPLCObjectService interface. */
+    erpc_status_t SetTransferEncoding_shim(erpc::Codec * codec, erpc::MessageBufferFactory *messageFactory, erpc::Transport * transport, uint32_t sequence);
 };
 
 } // erpcShim
@@ -115,7 +115,7 @@
 //!
 //! Uncomment to change the count of buffers allocated by one of statically allocated messages.
 //! Default value is set to 2.
-//#define ERPC_DEFAULT_BUFFERS_COUNT (2U)
+#define ERPC_DEFAULT_BUFFERS_COUNT (2U)
 
 //! @def ERPC_NOEXCEPT
 //!
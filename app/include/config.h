@@ -39,11 +39,25 @@
 #define HTTP_SERVER_STARTUP_DELAY		200
 #define HTTP_SERVER_PORT 				80
 #define HTTP_ROOT						FILESYSTEM_PATH WEB_PATH
+#define HTTP_MAX_CONNECTIONS			4												// connections served by the poll loop of the http server
+#define HTTP_REQUEST_BUFFER_SIZE		1024											// request header and body, per connection
+#define HTTP_SEND_BUFFER_SIZE			1024											// response headers and file chunks, per connection
+#define HTTP_URI_MAX_LENGTH				128												// request target including the query of /api reads
+#define HTTP_CONNECTION_TIMEOUT			(5 * MSEC_PER_SEC)								// idle keep-alive connections and stalled transfers are closed
+#define HTTP_API_MAX_RANGES				8												// process image ranges per /api/io request
+#define HTTP_API_MAX_VALUES				128												// process image values per /api/io request
+#define HTTP_CACHE_SLOTS				4												// web files kept in RAM, 0 disables the cache
+#define HTTP_CACHE_SLOT_SIZE			4096											// largest cached file
+#define WWW_BUNDLE_MAX_FILES			32												// web files packed into www_partition, if the board has one
+#define WWW_BUNDLE_NAME_SIZE			32												// longest name of a bundled web file
+#define WWW_BUNDLE_BLOCK_SIZE			256												// copy block while the bundle is built
 
 #define SNTP_SERVER 					"0.de.pool.ntp.org"
 #define SNTP_TIMEOUT 					SYS_FOREVER_MS								// MSEC_PER_SEC * 30
 
 #define ERPC_SERVER_PORT				1042
+#define RPC_SESSION_COUNT				2												// concurrent eRPC sessions, one worker thread each
+#define RPC_SESSION_IDLE_TIMEOUT		60												// seconds without a request until a session is closed
 #define HOSTNAME						"Beremiz4uC"	
 /*****************************************************************************************************************************/
 /*									Configuration file paths											     				 */
@@ -58,6 +72,13 @@
 
 #define MAX_FILE_UPLOADS 				20
 #define MAX_FILENAME_LENGTH 			8
+#define UPLOAD_BUFFER_SIZE				4096										// Write-behind buffer size, a multiple of the sd card sector size
+#define UPLOAD_BUFFER_COUNT				2											// Buffers filled by the rpc thread while the storage worker writes
+#define UPLOAD_QUEUE_SIZE				8											// Pending requests of the storage worker
+#define BLOB_STORE_INDEX_FILE			FILESYSTEM_PATH PLC_PATH "blobs.idx"		// md5 blobID of each installed extra file
+#define BLOB_STORE_MAX_ENTRIES			32											// Number of extra files known by their blobID
+#define BLOB_STORE_PATH_SIZE			48											// Maximum path length of an installed extra file
+#define BLOB_COPY_BLOCK_SIZE			1024										// Block size when a stored blob is copied to another path
 
 /*****************************************************************************************************************************/
 /*									Configuration rte logging															     */
@@ -70,8 +91,38 @@
 
 #define MAX_LOG_MESSAGE_SIZE 			1024                 						// Maximum size of a log message
 #define BACKUP_PERIOD_SEC 				0											// Backup log state every x seconds, 0 to disable
-#define LOG_FILE_NAME 					FILESYSTEM_PATH LOG_PATH "plc.log"			// Logfile name
-#define STATE_FILE_NAME 				FILESYSTEM_PATH LOG_PATH "logstate.log"		// Name of log state file
+#define LOG_FILE_NAME 					FILESYSTEM_PATH LOG_PATH "plc.blg"			// Logfile name, binary records
+#define STATE_FILE_NAME 				FILESYSTEM_PATH LOG_PATH "plc.idx"			// Name of log state file, includes the log index
+#define RTE_LOG_MAX_RECORDS				512											// Number of log records kept, the oldest record is overwritten
+#define RTE_LOG_MSG_SIZE				128											// Maximum message length per record incl. terminating zero
+#define RTE_LOG_QUEUE_SIZE				16											// Messages queued for the log writer, further messages are dropped
+#define RTE_LOG_WRITE_BATCH				8											// Maximum number of records per write
+#define RTE_LOG_DEFERRED_ARGS			8											// Arguments kept per deferred rte_log_inf message, '*' counts as one
+#define RTE_LOG_STR_SIZE				64											// Copied string arguments of a deferred message, all strings together
+#define RTE_LOG_FMT_SIZE				96											// Copied format of a deferred message from the PLC module
+#define RTE_LOG_DEFERRED_COUNT			16											// Deferred rte_log_inf messages waiting to be formatted
+#define RTE_LOG_BATCH_MAX				32											// Maximum number of messages returned by GetLogMessages
+#define RTE_LOG_BATCH_BYTES				896											// Maximum encoded size of a GetLogMessages batch, fits the eRPC buffer
+
+// System log file backend, see CONFIG_PLC_LOG_BACKEND_FILE
+#define SYS_LOG_FILE_BASE				FILESYSTEM_PATH LOG_PATH "sys"				// Current file is sys.log, rotated files sys1.log ..
+#define SYS_LOG_FILE_COUNT				3											// Number of log files including the current one
+#define SYS_LOG_FILE_MAX_SIZE			(64 * 1024)									// Size at which the log file is rotated
+#define SYS_LOG_WRITE_SIZE				1024										// Log output is written in blocks of this size
+#define SYS_LOG_BUFFER_SIZE				4096										// Log output waiting for the file write
+#define SYS_LOG_FLUSH_PERIOD			(10 * MSEC_PER_SEC)							// Max age of unwritten log output in milliseconds
+#define SYS_LOG_RATE_LIMIT				20											// Messages per log module and second
+#define SYS_LOG_MAX_SOURCES				128											// Log modules with a separate rate limit
+#define SYS_LOG_EXCLUDED_MODULES		{"fs", "littlefs", "flash", "spi_nor", "sd", "disk"}	// Module name prefixes not written to file
+
+// Syslog exporter, see CONFIG_PLC_SYSLOG
+#define SYSLOG_DEFAULT_PORT				514											// Default UDP port of the syslog server
+#define SYSLOG_QUEUE_SIZE				4096										// Formatted messages waiting to be sent, further messages are dropped
+#define SYSLOG_MESSAGE_SIZE				256											// Maximum length of one formatted message
+#define SYSLOG_DATAGRAM_SIZE			1472										// Maximum datagram size, ethernet MTU without IP and UDP header
+#define SYSLOG_PERIOD					500											// Send period in milliseconds
+#define SYSLOG_MAX_DATAGRAMS			4											// Maximum number of datagrams per send period
+#define SYSLOG_COALESCE					true										// Pack several LF separated messages into one datagram
 
 
 /*****************************************************************************************************************************/
@@ -83,7 +134,29 @@
 // Configuration for the maximum count of traceable and forcible variables
 #define TRACE_VARS_MAX_COUNT 			64											// Maximum number of variables to trace
 #define FORCE_VARS_MAX_COUNT 			64											// Maximum number of variables to force
+#define FORCE_VALUES_BUFFER_SIZE		1024										// Buffer for the values of all forced variables
 #define DEBUG_TIMEOUT 					(3 * MSEC_PER_SEC)							// Debug timeout in milliseconds
+#define TRACE_UPDATE_TIMEOUT			(1 * MSEC_PER_SEC)							// Max wait for a cycle boundary to apply trace changes
+#define TRACE_WAIT_DEFAULT_TIMEOUT		250											// Wait of GetTraceVariables for new samples in milliseconds
+#define TRACE_WAIT_MAX_TIMEOUT			(DEBUG_TIMEOUT / 2)							// Upper limit of client chosen waits, keeps debug thread alive
+#define TRACE_RESPONSE_MAX_SIZE			896											// Maximum size of the samples in one trace reply, fits one eRPC message
+#define TRACE_SAMPLE_OVERHEAD			8											// Reply bytes of a sample besides its data: tick and data length
+#define STATS_VARS_MAX_COUNT			16											// Maximum number of variables with statistics
+#define RW_VARS_MAX_COUNT				32											// Maximum number of variables per ReadVariables or WriteVariables
+#define RW_VALUES_MAX_SIZE				896											// Maximum size of the packed ReadVariables values, fits one eRPC message
+
+// Transfer encodings, negotiated per rpc session
+#define LZSS_WINDOW_BITS				8											// heatshrink window size of compressed uploads (-w), as log2
+#define LZSS_LOOKAHEAD_BITS				4											// heatshrink lookahead size of compressed uploads (-l), as log2
+#define LZSS_OUTPUT_BLOCK				256											// Decoded upload data is passed on in blocks of this size
+#define MODULE_PATCH_BLOCK_SIZE			256											// Stored module data is read in blocks of this size while patching
+
+// Flight recorder, keeps the trace history on file while no IDE fetches the samples
+#define FLIGHT_RECORDER_FILE			FILESYSTEM_PATH LOG_PATH "trace.rec"		// Circular recording file
+#define FLIGHT_RECORDER_CHUNK_SIZE		4096										// Size of a file write, the file header takes one chunk
+#define FLIGHT_RECORDER_CHUNK_COUNT		64											// Number of data chunks, limits the file size
+#define FLIGHT_RECORDER_PERIOD			100											// Drain period of the trace buffer in milliseconds
+#define FLIGHT_RECORDER_FLUSH_PERIOD	(5 * MSEC_PER_SEC)							// Max age of unwritten samples in milliseconds
 
 /*****************************************************************************************************************************/
 #define NUM(a) (sizeof(a) / sizeof(*a))
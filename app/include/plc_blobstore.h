@@ -0,0 +1,43 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_BLOBSTORE_H
+#define PLC_BLOBSTORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "erpc_PLCObject_common.h"
+
+// Installed file as known to the store
+struct blob_info
+{
+	uint8_t id[16];		// md5 of the content
+	uint32_t size;
+	uint32_t installed; // unix time of the install
+};
+
+bool blob_store_lookup(const binary_t *blobID, char *path, size_t size);
+bool blob_store_stat(const char *path, struct blob_info *info);
+int blob_store_add(const binary_t *blobID, const char *path);
+int blob_store_copy(const char *src, const char *dst);
+int blob_store_save(void);
+
+#endif
@@ -0,0 +1,78 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_COMPRESS_H
+#define PLC_COMPRESS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+#include "config.h"
+
+// Transfer encodings, negotiated per rpc session with SetTransferEncoding
+#define TRANSFER_ENCODING_UPLOAD_LZSS	BIT(0)		// every AppendChunkToBlob chunk is a complete heatshrink stream (window and lookahead see config.h)
+#define TRANSFER_ENCODING_TRACE_DELTA	BIT(1)		// every TraceBuffer is delta coded against the previous sample of the reply
+#define TRANSFER_ENCODING_MODULE_PATCH	BIT(2)		// a plc module can be uploaded as patch of the stored one, see plc_patch.h
+#define TRANSFER_ENCODING_UPLOAD_HANDLE	BIT(3)		// AppendChunkToBlob returns the blobID of SeedBlob, the md5 of seed and stored file is only checked by NewPLC
+#define TRANSFER_ENCODINGS_SUPPORTED	(TRANSFER_ENCODING_UPLOAD_LZSS | TRANSFER_ENCODING_TRACE_DELTA | TRANSFER_ENCODING_MODULE_PATCH | TRANSFER_ENCODING_UPLOAD_HANDLE)
+
+// Trace delta coding: the sample is xor'ed with the previous sample of the same reply if both have the same size (known
+// from the tick), otherwise and for the first sample of a reply with zeros. Samples with an empty TraceBuffer don't count.
+// The result is coded as a sequence of runs, a control byte 0x00..0x7f is followed by control + 1 literal bytes, a control
+// byte 0x80..0xff stands for (control & 0x7f) + 1 zero bytes.
+#define TRACE_DELTA_MAX_SIZE(n)			((n) + ((n) + 127) / 128)
+
+// Streaming decoder of heatshrink compressed data, keeps its state between calls
+struct lzss_decoder
+{
+	uint8_t window[1 << LZSS_WINDOW_BITS];		// last decoded bytes, source of back references
+	uint16_t head;								// write position in window
+	uint8_t state;								// field that is being read
+	uint8_t current_byte;						// input byte the bits are taken from
+	uint8_t bit_mask;							// next bit of current_byte, 0 when a new byte is needed
+	uint16_t bits;								// bits of the current field read so far
+	uint8_t bit_count;							// number of bits read into bits
+	uint16_t index;								// offset of the back reference
+	uint16_t count;								// bytes of the back reference left to copy
+	uint8_t out[LZSS_OUTPUT_BLOCK];				// decoded bytes not yet passed to the sink
+	size_t out_len;
+};
+
+// Accumulated cost and gain of a codec, for the compression shell command
+struct compress_stats
+{
+	uint64_t raw_bytes;							// uncompressed bytes
+	uint64_t coded_bytes;						// bytes on the wire
+	uint64_t cycles;							// cpu cycles spent in the codec
+};
+
+typedef int (*lzss_sink_t)(const uint8_t *data, size_t length, void *arg);
+
+void lzss_decoder_reset(struct lzss_decoder *dec);
+int lzss_decode(struct lzss_decoder *dec, const uint8_t *in, size_t length, lzss_sink_t sink, void *arg);
+int lzss_decode_finish(struct lzss_decoder *dec, lzss_sink_t sink, void *arg);
+size_t trace_delta_encode(const uint8_t *prev, const uint8_t *cur, size_t length, uint8_t *out);
+
+extern struct compress_stats upload_compress_stats;
+extern struct compress_stats trace_compress_stats;
+
+#endif
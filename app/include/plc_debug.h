@@ -22,6 +22,45 @@
 #ifndef PLC_DEBUG_H
 #define PLC_DEBUG_H
 #include "erpc_PLCObject_common.h"
+#include "config.h"
+
+// Definition of error codes for debugging functionalities
+#define TOO_MANY_TRACED -1
+#define TOO_MANY_FORCED -2
+#define FORCE_VAR_SIZE_OVERFLOW -3
+#define INVALID_FORCE_VALUE -4
+#define DEBUG_SUSPENDED -5
+#define TRACE_UPDATE_FAILED -6
+#define INVALID_STATS_VAR -7
+#define INVALID_VARIABLE -8
+#define WRITE_UNCONFIRMED -9
+
+// Sample layout of the trace records, changes together with the debug token
+struct trace_layout
+{
+	uint32_t token;
+	uint32_t count;
+	uint32_t idxs[TRACE_VARS_MAX_COUNT];
+	uint32_t size[TRACE_VARS_MAX_COUNT];
+	uint32_t divisor[TRACE_VARS_MAX_COUNT];
+};
+
+// Areas of the process image, see plc_io.c
+enum image_area
+{
+	IMAGE_IX,
+	IMAGE_QX,
+	IMAGE_IW,
+	IMAGE_QW,
+};
+
+// Consecutive elements of one area, bits and words are both passed as uint16_t values
+struct image_range
+{
+	enum image_area area;
+	uint32_t start;
+	uint32_t count;
+};
 
 // uint32_t get_current_memory_usage();
 // void deinitialize_trace_variables();
@@ -38,11 +77,29 @@
 // int TracesSwap(bool swap);
 PLCstatus_enum get_PLCStatus(void);
 void plc_debug_thread(void *, void *, void *);
+void plc_debug_thread_start(void);
 
 
 void __init_debug    (void);
 void __cleanup_debug (void);
 void __retrieve_debug(void);
 int publish_debug (void);
+void update_statistics(void);
+void apply_output_writes(void);
+
+bool plc_debug_host_attached(void);
+size_t plc_debug_drain_trace(uint8_t *buf, size_t size, struct trace_layout *layout, uint32_t *records);
+int plc_debug_trace_add(uint32_t idx);
+int plc_debug_trace_remove(uint32_t idx);
+int plc_debug_force(uint32_t idx, const binary_t *value);
+uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t *orders, uint32_t *debugtoken);
+uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables *traces);
+uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage *page);
+uint32_t SetStatisticsVariablesList(const list_stat_order_1_t *orders, uint32_t windowMs);
+uint32_t GetStatistics(TraceStatistics *statistics);
+uint32_t ReadVariables(const list_uint32_1_t *idxs, variable_snapshot *snapshot);
+uint32_t WriteVariables(const list_variable_write_1_t *values);
+int plc_debug_read_image(const struct image_range *ranges, size_t count, uint16_t *values, uint32_t *tick);
+int plc_debug_write_image(const struct image_range *ranges, size_t count, const uint16_t *values);
 
 #endif
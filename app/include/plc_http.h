@@ -25,7 +25,6 @@
 #include <unistd.h>
 
 void send_status_update();
-void handle_status_request(int client_fd);
 void process_websocket_handshake(int client_fd, const char *client_key);
 void send_ping_frame(int client_fd);
 void send_pong_frame(int client_fd);
@@ -36,9 +35,7 @@ void handle_websocket_communication(int client_fd);
 bool is_websocket_upgrade_request(const char *request);
 const char *extract_websocket_key(const char *request);
 const char *get_content_type(const char *file_path);
-void send_file(int client_fd, const char *file_path);
 void plc_websocket_server(void *client_fd, void *arg2, void *arg3);
-void process_request(int client_fd);
 void plc_http_server(void *, void *, void *);
 
 char *strcasestr(const char *haystack, const char *needle);
@@ -0,0 +1,32 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_HTTP_CACHE_H
+#define PLC_HTTP_CACHE_H
+
+#include <stdint.h>
+
+#include "plc_blobstore.h"
+
+const uint8_t *http_cache_acquire(const char *path, const struct blob_info *info);
+void http_cache_release(const uint8_t *data);
+
+#endif
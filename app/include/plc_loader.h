@@ -24,6 +24,16 @@
 typedef unsigned int dbgvardsc_index_t;
 #include "udynlink.h"
 
+#define SIGN (((uint32_t)'M' << 24) | ((uint32_t)'L' << 16) | ((uint32_t)'D' << 8) | (uint32_t)'U')
+#define PLC_FLASH_MODULE "FLASH"				// load_plc_module name for the active flash slot
+
+// udynlink file header
+typedef struct
+{
+	uint32_t sign;
+	uint32_t crc;
+} file_header_t;
+
 // RTE Functions
 void config_init__(void);
 void config_run__(unsigned long);
@@ -42,6 +52,10 @@ int erase_plc_programm_flash(int state);
 void reload_plc(void);
 int load_plc_module(char *filename);
 int unload_plc_module(void);
+char *plc_module_source(void);
+int plc_flash_slot_area(int slot);
+int plc_flash_inactive_slot(void);
+void plc_flash_activate_slot(int slot);
 
 extern uint32_t plc_initialized;
 extern uint32_t plc_run;
@@ -35,11 +35,17 @@ void logging_timer_callback(struct k_timer *timer_id);
 uint32_t GetLogCount(uint8_t level);
 uint32_t ResetLogCount(void);
 uint32_t GetLogMessage(uint8_t level, uint32_t msgID, log_message *message);
+uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch *batch);
 
 // rte function
 int LogMessage(uint8_t level, char* buf, int8_t size);
+uint32_t GetLogDroppedCount(void);
+void log_writer_thread(void *, void *, void *);
 
 // rte function to log in zephyr
 void rte_log_inf(const char* fmt, ...);
+// Captures the arguments and formats later. Strings are copied, %n and wide characters (%lc, %ls) end the message.
+void rte_log_inf_deferred(const char* fmt, ...);
+void rte_log_deferred_flush(void);
 
 #endif
\ No newline at end of file
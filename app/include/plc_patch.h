@@ -0,0 +1,56 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_PATCH_H
+#define PLC_PATCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define MODULE_PATCH_SIGN 0x54415042 // "BPAT"
+
+// A module patch rebuilds a new plc module from the one currently stored, it is uploaded like a plc module if the
+// session negotiated TRANSFER_ENCODING_MODULE_PATCH. All numbers are little endian.
+struct module_patch_header
+{
+	uint32_t sign;					// MODULE_PATCH_SIGN
+	char base_md5[32];				// md5 of the stored plc as in PLC_MD5_FILE, the patch is refused for any other plc
+	uint32_t target_size;			// size of the new module
+	uint8_t target_md5[16];			// md5 of the new module
+};
+
+// The header is followed by commands until the new module is complete, offset and length are LEB128 coded:
+//   MODULE_PATCH_COPY offset length			copies length bytes of the stored module from offset
+//   MODULE_PATCH_ADD offset length bytes		adds length bytes bytewise to the stored module from offset
+//   MODULE_PATCH_DATA length bytes				inserts length bytes
+// ADD covers code that only moved, the added bytes are mostly zero and compress well with TRANSFER_ENCODING_UPLOAD_LZSS.
+enum module_patch_op
+{
+	MODULE_PATCH_COPY,
+	MODULE_PATCH_ADD,
+	MODULE_PATCH_DATA,
+};
+
+int module_patch_begin(void);
+int module_patch_write(const uint8_t *data, size_t length);
+int module_patch_end(void);
+
+#endif
@@ -0,0 +1,55 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_RECORDER_H
+#define PLC_RECORDER_H
+
+#include <stdint.h>
+
+#include "plc_debug.h"
+
+#define FLIGHT_RECORDER_MAGIC			0x52463442	// "B4FR"
+#define FLIGHT_RECORDER_VERSION			1
+
+// File header, stored in the first chunk of the recording file
+struct flight_recorder_header
+{
+	uint32_t magic;
+	uint16_t version;
+	uint16_t header_size;					// sizeof(struct flight_recorder_header)
+	uint32_t chunk_size;					// Size of every chunk including its chunk header
+	uint32_t chunk_count;					// Number of data chunks, chunk n is stored at (n % chunk_count + 1) * chunk_size
+	struct trace_layout layout;				// Layout of the trace records of this recording
+};
+
+// Header of a data chunk, followed by complete trace records of the same layout as published by the debug thread
+struct flight_recorder_chunk
+{
+	uint32_t seq;							// Sequence number, starts at 1, the oldest chunk has the lowest number
+	uint16_t used;							// Bytes of trace records following this header
+	uint16_t records;						// Number of trace records in this chunk
+};
+
+void flight_recorder_lock(void);
+void flight_recorder_unlock(void);
+void flight_recorder_thread(void *, void *, void *);
+
+#endif
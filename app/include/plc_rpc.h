@@ -24,20 +24,21 @@
 #define PLC_RPC_H
 
 char *print_hash(const uint8_t hash[16]);
-void add_file_upload(char *filename, struct binary_t *blobID, FILE *file_pointer);
+void add_file_upload(char *filename, struct binary_t *blobID);
 void update_last_blobID(const struct binary_t *blobID);
 char* get_filename_from_blobID(const struct binary_t *blobID);
-FILE* get_file_pointer_from_blobID(const struct binary_t *blobID);
+struct file_upload *get_upload_from_blobID(const struct binary_t *blobID);
 struct blob_t get_last_blobID();
-FILE* is_last_file_pointer_valid();
+bool is_last_upload_open();
 char *generate_random_filename(char *file_name, char *path);
 binary_t blob_to_binary(struct blob_t blob);
-uint32_t finish_fileUpload(const binary_t *blobID);
+uint32_t finish_fileUpload(void);
 void update_fileUpload(binary_t *blobID);
 uint32_t prepare_fileUpload(binary_t *blobID);
 bool path_exists(const char *path);
 int rmdir(const char *path);
 void rpc_server_task(void *, void *, void *);
+uint32_t rpc_session_encodings(void);
 
 struct blob_t
 {
@@ -49,6 +50,10 @@ struct file_upload
 {
     char filename[33];
     struct blob_t blobID;
-    FILE *file_pointer;
+    bool open;
+    int8_t flash_slot;      // plc module streamed into this flash slot, -1 for a file
+    bool patch;             // plc module rebuilt from a patch of the stored one
+    bool patch_valid;       // patch complete and the new module checked
+    uint32_t size;
 };
 #endif
\ No newline at end of file
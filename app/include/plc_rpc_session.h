@@ -0,0 +1,57 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_RPC_SESSION_H
+#define PLC_RPC_SESSION_H
+
+#include <stdint.h>
+#include <netinet/in.h>
+#include <zephyr/kernel.h>
+
+#include "erpc_common.h"
+#include "erpc_config.h"
+#include "c_erpc_PLCObject_server.h"
+#include "config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// State of one eRPC client session, owned by the worker thread serving it
+struct rpc_session
+{
+	int fd;																		// connected client socket
+	uint32_t id;																// running session number for the log
+	uint32_t encodings;															// transfer encodings negotiated by the client
+	struct sockaddr_in peer;													// address of the client
+	uint32_t buffers_used;														// bitmap of the buffers handed out
+	uint8_t buffers[ERPC_DEFAULT_BUFFERS_COUNT][ERPC_DEFAULT_BUFFER_SIZE];		// message buffer pool of the session
+};
+
+extern struct k_mutex rpc_state_mutex;
+
+erpc_status_t rpc_session_serve(struct rpc_session *session, erpc_service_t service);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -43,9 +43,21 @@ void set_plc_autostart_setting(bool value);
 bool get_plc_autostart_source_setting(void) ;
 void set_plc_autostart_setting(bool value);
 
+bool get_flight_recorder_setting(void);
+void set_flight_recorder_setting(bool value);
+
+int get_plc_flash_slot_setting(void);
+void set_plc_flash_slot_setting(int value);
+
 char* get_hostname_setting(void);
 void set_hostname_setting(const char* value);
 
+char* get_syslog_server_setting(void);
+void set_syslog_server_setting(const char* value);
+
+int get_syslog_port_setting(void);
+void set_syslog_port_setting(int value);
+
 bool get_dhcp_active_setting(void);
 void set_dhcp_active_setting(bool value);
 
@@ -0,0 +1,38 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_UPLOAD_H
+#define PLC_UPLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+int upload_open(const char *filename);
+int upload_open_flash(uint8_t area);
+int upload_write(const uint8_t *data, size_t length);
+void upload_close(void);
+int upload_sync(void);
+void upload_hash_begin(const uint8_t *seed, size_t length, uint8_t *digest);
+void upload_hash_end(void);
+void upload_reset(void);
+void upload_thread(void *, void *, void *);
+
+#endif
@@ -0,0 +1,57 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#ifndef PLC_WWW_BUNDLE_H
+#define PLC_WWW_BUNDLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "config.h"
+
+#define WWW_BUNDLE_MAGIC				0x42573442	// "B4WB"
+
+// Image header at the start of www_partition, written last so an interrupted build leaves no valid image
+struct www_bundle_header
+{
+	uint32_t magic;
+	uint32_t count;							// Number of directory entries following the header
+	uint32_t size;							// Size of the image
+	uint32_t reserved;
+};
+
+// Directory entry, entries are sorted by name
+struct www_bundle_entry
+{
+	char name[WWW_BUNDLE_NAME_SIZE];		// Path relative to HTTP_ROOT
+	uint32_t offset;						// Offset of the content from the start of the image, 4 byte aligned
+	uint32_t size;
+	uint8_t id[16];							// md5 of the content
+	uint32_t installed;						// unix time of the install
+};
+
+int www_bundle_build(void);
+bool www_bundle_acquire(void);
+void www_bundle_release(void);
+const struct www_bundle_entry *www_bundle_find(const char *name);
+const uint8_t *www_bundle_data(const struct www_bundle_entry *entry);
+
+#endif
@@ -0,0 +1,336 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_blobstore, LOG_LEVEL_INF);
+
+#include <errno.h>
+#include <string.h>
+#include <time.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+
+#include "config.h"
+#include "plc_blobstore.h"
+
+/***************************************************************************************************************************************/
+/*		content addressed blob store																						 		   */
+/***************************************************************************************************************************************/
+
+// The installed extra files are the store, the index maps the md5 blobID of each file to its path. A blob is only
+// reported as present while the file still exists with the size it had when it was installed. The index is loaded on
+// first use and written by blob_store_save. The http server takes the md5 and install time of the web files as ETag and
+// Last-Modified, so the index is shared between the rpc sessions and the http thread.
+
+#define BLOB_STORE_MAGIC 0x54423442 // "B4BT", entries with install time
+
+struct blob_entry
+{
+	uint8_t id[16];
+	uint32_t size;
+	uint32_t installed; // unix time of the first install of this content at this path
+	char path[BLOB_STORE_PATH_SIZE];
+};
+
+struct blob_index_header
+{
+	uint32_t magic;
+	uint32_t count;
+};
+
+static struct blob_entry __ccm_noinit_section blob_index[BLOB_STORE_MAX_ENTRIES];
+static uint32_t blob_count = 0;
+static bool blob_index_loaded = false;
+K_MUTEX_DEFINE(blob_store_mutex);
+
+/****************************************************************************************************************************************
+ * @brief 			Loads the index file, a missing or invalid index is treated as empty store.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static void blob_store_load(void)
+{
+	struct fs_file_t file;
+	struct blob_index_header header;
+
+	if (blob_index_loaded)
+	{
+		return;
+	}
+	blob_index_loaded = true;
+	blob_count = 0;
+
+	fs_file_t_init(&file);
+	if (fs_open(&file, BLOB_STORE_INDEX_FILE, FS_O_READ) != 0)
+	{
+		return;
+	}
+	if ((fs_read(&file, &header, sizeof(header)) == sizeof(header)) && (header.magic == BLOB_STORE_MAGIC) &&
+		(header.count <= BLOB_STORE_MAX_ENTRIES))
+	{
+		ssize_t size = header.count * sizeof(struct blob_entry);
+		if (fs_read(&file, blob_index, size) == size)
+		{
+			blob_count = header.count;
+		}
+	}
+	fs_close(&file);
+	LOG_INF("blob store: %u blobs", blob_count);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Searches the index for a blobID.
+ *
+ * @param blobID 	md5 blobID.
+ * @return 			Index entry or NULL if not found.
+ ****************************************************************************************************************************************/
+static struct blob_entry *blob_store_find(const binary_t *blobID)
+{
+	if (blobID->dataLength != sizeof(blob_index[0].id))
+	{
+		return NULL;
+	}
+	for (uint32_t i = 0; i < blob_count; i++)
+	{
+		if (memcmp(blob_index[i].id, blobID->data, sizeof(blob_index[i].id)) == 0)
+		{
+			return &blob_index[i];
+		}
+	}
+	return NULL;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Removes an entry from the index.
+ *
+ * @param entry 	Index entry.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static void blob_store_remove(struct blob_entry *entry)
+{
+	uint32_t i = entry - blob_index;
+	memmove(&blob_index[i], &blob_index[i + 1], (blob_count - i - 1) * sizeof(struct blob_entry));
+	blob_count--;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Checks if a blob is stored.
+ *
+ * @param blobID 	md5 blobID.
+ * @param path 		Receives the path of the stored file, may be NULL.
+ * @param size 		Size of path.
+ * @return 			true if the blob is stored and the file unchanged in size.
+ ****************************************************************************************************************************************/
+bool blob_store_lookup(const binary_t *blobID, char *path, size_t size)
+{
+	struct fs_dirent dirent;
+	bool found = false;
+
+	k_mutex_lock(&blob_store_mutex, K_FOREVER);
+	blob_store_load();
+	struct blob_entry *entry = blob_store_find(blobID);
+	if (entry != NULL)
+	{
+		if ((fs_stat(entry->path, &dirent) != 0) || (dirent.size != entry->size))
+		{
+			blob_store_remove(entry); // File was deleted or replaced
+		}
+		else
+		{
+			if (path != NULL)
+			{
+				strncpy(path, entry->path, size - 1);
+				path[size - 1] = '\0';
+			}
+			found = true;
+		}
+	}
+	k_mutex_unlock(&blob_store_mutex);
+	return found;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Gets the blobID and install time of an installed file.
+ *
+ * @param path 		Path of the installed file.
+ * @param info 		Receives blobID, size and install time.
+ * @return 			true if the file is indexed and unchanged in size.
+ ****************************************************************************************************************************************/
+bool blob_store_stat(const char *path, struct blob_info *info)
+{
+	struct fs_dirent dirent;
+	bool found = false;
+
+	k_mutex_lock(&blob_store_mutex, K_FOREVER);
+	blob_store_load();
+	for (uint32_t i = 0; i < blob_count; i++)
+	{
+		struct blob_entry *entry = &blob_index[i];
+		if (strcmp(entry->path, path) == 0)
+		{
+			if ((fs_stat(path, &dirent) == 0) && (dirent.size == entry->size))
+			{
+				memcpy(info->id, entry->id, sizeof(info->id));
+				info->size = entry->size;
+				info->installed = entry->installed;
+				found = true;
+			}
+			break;
+		}
+	}
+	k_mutex_unlock(&blob_store_mutex);
+	return found;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Adds an installed file to the index, entries for the same path or blobID are replaced. The oldest entry is
+ * 					dropped if the index is full. The install time is kept if the same content is installed at the same path again.
+ *
+ * @param blobID 	md5 blobID of the file content.
+ * @param path 		Path of the installed file.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int blob_store_add(const binary_t *blobID, const char *path)
+{
+	struct fs_dirent dirent;
+	struct timespec ts;
+
+	if ((blobID->dataLength != sizeof(blob_index[0].id)) || (strlen(path) >= BLOB_STORE_PATH_SIZE))
+	{
+		return -EINVAL;
+	}
+	int ret = fs_stat(path, &dirent);
+	if (ret != 0)
+	{
+		return ret;
+	}
+	clock_gettime(CLOCK_REALTIME, &ts);
+	uint32_t installed = ts.tv_sec;
+
+	k_mutex_lock(&blob_store_mutex, K_FOREVER);
+	blob_store_load();
+	struct blob_entry *entry = blob_store_find(blobID);
+	if (entry != NULL)
+	{
+		if ((strcmp(entry->path, path) == 0) && (entry->size == dirent.size))
+		{
+			installed = entry->installed; // Content unchanged
+		}
+		blob_store_remove(entry);
+	}
+	for (uint32_t i = 0; i < blob_count; i++)
+	{
+		if (strcmp(blob_index[i].path, path) == 0)
+		{
+			blob_store_remove(&blob_index[i]); // Content of the path changed
+			break;
+		}
+	}
+	if (blob_count == BLOB_STORE_MAX_ENTRIES)
+	{
+		blob_store_remove(&blob_index[0]);
+	}
+
+	entry = &blob_index[blob_count++];
+	memcpy(entry->id, blobID->data, sizeof(entry->id));
+	entry->size = dirent.size;
+	entry->installed = installed;
+	memset(entry->path, 0, sizeof(entry->path));
+	strcpy(entry->path, path);
+	k_mutex_unlock(&blob_store_mutex);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Copies a stored blob to another path.
+ *
+ * @param src 		Path of the stored file.
+ * @param dst 		Destination path, replaced if it exists.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int blob_store_copy(const char *src, const char *dst)
+{
+	struct fs_file_t in;
+	struct fs_file_t out;
+	ssize_t count;
+	int ret;
+
+	uint8_t *buffer = k_malloc(BLOB_COPY_BLOCK_SIZE);
+	if (buffer == NULL)
+	{
+		return -ENOMEM;
+	}
+
+	fs_file_t_init(&in);
+	fs_file_t_init(&out);
+	ret = fs_open(&in, src, FS_O_READ);
+	if (ret == 0)
+	{
+		ret = fs_open(&out, dst, FS_O_CREATE | FS_O_WRITE);
+		if (ret == 0)
+		{
+			ret = fs_truncate(&out, 0);
+			while ((ret == 0) && ((count = fs_read(&in, buffer, BLOB_COPY_BLOCK_SIZE)) > 0))
+			{
+				ret = (fs_write(&out, buffer, count) == count) ? 0 : -EIO;
+			}
+			if ((ret == 0) && (count < 0))
+			{
+				ret = count;
+			}
+			fs_close(&out);
+		}
+		fs_close(&in);
+	}
+	k_free(buffer);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Writes the index file.
+ *
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int blob_store_save(void)
+{
+	struct fs_file_t file;
+	k_mutex_lock(&blob_store_mutex, K_FOREVER);
+	struct blob_index_header header = {.magic = BLOB_STORE_MAGIC, .count = blob_count};
+	ssize_t size = blob_count * sizeof(struct blob_entry);
+
+	fs_file_t_init(&file);
+	int ret = fs_open(&file, BLOB_STORE_INDEX_FILE, FS_O_CREATE | FS_O_WRITE);
+	if (ret != 0)
+	{
+		LOG_ERR("Failed to open blob index %s: %d", BLOB_STORE_INDEX_FILE, ret);
+		k_mutex_unlock(&blob_store_mutex);
+		return ret;
+	}
+	ret = fs_truncate(&file, 0);
+	if ((ret == 0) && ((fs_write(&file, &header, sizeof(header)) != sizeof(header)) || (fs_write(&file, blob_index, size) != size)))
+	{
+		ret = -EIO;
+	}
+	fs_close(&file);
+	k_mutex_unlock(&blob_store_mutex);
+	return ret;
+}
@@ -23,6 +23,7 @@
 LOG_MODULE_REGISTER(plc_cli, LOG_LEVEL_DBG);
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <ff.h>
 #include <sys/stat.h>
@@ -39,6 +40,8 @@ LOG_MODULE_REGISTER(plc_cli, LOG_LEVEL_DBG);
 
 #include "plc_settings.h"
 #include "plc_filesys.h"
+#include "plc_compress.h"
+#include "plc_www_bundle.h"
 
 #define MKFS_DEV_ID FIXED_PARTITION_ID(storage_partition)
 #define MKFS_FLAGS 0
@@ -78,6 +81,9 @@ static int cmd_show_or_set_settings(const struct shell *shell, size_t argc, char
 		shell_fprintf(shell, SHELL_NORMAL, "-------------------- ------------------------------\n");
 		shell_fprintf(shell, SHELL_NORMAL, "%-20s %s\n", "mount_sd_card", get_mount_sd_card_setting() ? VAL_TRUE : VAL_FALSE);
 		shell_fprintf(shell, SHELL_NORMAL, "%-20s %s\n", "start_plc_at_boot", get_plc_autostart_setting() ? VAL_TRUE : VAL_FALSE);
+		shell_fprintf(shell, SHELL_NORMAL, "%-20s %s\n", "flight_recorder", get_flight_recorder_setting() ? VAL_TRUE : VAL_FALSE);
+		shell_fprintf(shell, SHELL_NORMAL, "%-20s %s\n", "syslog_server", get_syslog_server_setting());
+		shell_fprintf(shell, SHELL_NORMAL, "%-20s %d\n", "syslog_port", get_syslog_port_setting());
 	}
 	else if (argc == 3)
 	{
@@ -93,6 +99,22 @@ static int cmd_show_or_set_settings(const struct shell *shell, size_t argc, char
 			set_plc_autostart_setting(val);
 			shell_fprintf(shell, SHELL_NORMAL, "Setting '%s' updated to '%s'.\n", argv[1], argv[2]);
 		}
+		else if (strcmp(argv[1], "flight_recorder") == 0)
+		{
+			bool val = strcmp(argv[2], "true") == 0 ? true : false;
+			set_flight_recorder_setting(val);
+			shell_fprintf(shell, SHELL_NORMAL, "Setting '%s' updated to '%s'.\n", argv[1], argv[2]);
+		}
+		else if (strcmp(argv[1], "syslog_server") == 0)
+		{
+			set_syslog_server_setting(strcmp(argv[2], "none") == 0 ? "" : argv[2]);
+			shell_fprintf(shell, SHELL_NORMAL, "Setting '%s' updated to '%s'.\n", argv[1], argv[2]);
+		}
+		else if (strcmp(argv[1], "syslog_port") == 0)
+		{
+			set_syslog_port_setting(atoi(argv[2]));
+			shell_fprintf(shell, SHELL_NORMAL, "Setting '%s' updated to '%s'.\n", argv[1], argv[2]);
+		}
 		else
 		{
 			shell_fprintf(shell, SHELL_NORMAL, "Unknown setting '%s'.\n", argv[1]);
@@ -661,6 +683,51 @@ static int cmd_show_ip(const struct shell *shell, size_t argc, char **argv)
     return 0;
 }
 
+static void print_compress_stats(const struct shell *shell, const char *name, const struct compress_stats *stats)
+{
+	if (stats->raw_bytes == 0)
+	{
+		shell_print(shell, "%-8s not used", name);
+		return;
+	}
+
+	uint32_t ratio = (uint32_t)(stats->coded_bytes * 100 / stats->raw_bytes);
+	uint32_t us_per_kb = (uint32_t)(k_cyc_to_us_floor64(stats->cycles) * 1024 / stats->raw_bytes);
+	shell_print(shell, "%-8s raw %llu B, coded %llu B (%u%%), %u us/KB", name, stats->raw_bytes, stats->coded_bytes, ratio, us_per_kb);
+}
+
+static int cmd_compression(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc > 1 && strcmp(argv[1], "reset") == 0)
+	{
+		memset(&upload_compress_stats, 0, sizeof(upload_compress_stats));
+		memset(&trace_compress_stats, 0, sizeof(trace_compress_stats));
+		return 0;
+	}
+
+	print_compress_stats(shell, "upload", &upload_compress_stats);
+	print_compress_stats(shell, "trace", &trace_compress_stats);
+	return 0;
+}
+
+static int cmd_www_bundle(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret = www_bundle_build();
+	if (ret == -ENOTSUP)
+	{
+		shell_print(shell, "Board has no www_partition, web files are served from %s", HTTP_ROOT);
+	}
+	else if (ret != 0)
+	{
+		shell_print(shell, "Web bundle not built: %d, web files are served from %s", ret, HTTP_ROOT);
+	}
+	else
+	{
+		shell_print(shell, "Web files of %s packed into www_partition", HTTP_ROOT);
+	}
+	return ret;
+}
+
 SHELL_CMD_ARG_REGISTER(ls, NULL, "List directory", cmd_ls, 1, 1);
 SHELL_CMD_ARG_REGISTER(format, NULL, "format lfs:/", cmd_format_lfs, 1, 0);
 SHELL_CMD_ARG_REGISTER(pwd, NULL, "Show actual directory", cmd_pwd, 1, 0);
@@ -679,4 +746,6 @@ SHELL_CMD_ARG_REGISTER(mv, NULL, "Move (rename) files", cmd_mv, 1, 0);
 SHELL_CMD_ARG_REGISTER(run, NULL, "Execute a shell script file", cmd_run, 1, 0);
 SHELL_CMD_ARG_REGISTER(free, NULL, "Show memory usage", cmd_free, 1, 0);
 SHELL_CMD_ARG_REGISTER(show_ip, NULL, "Show the IPv4 address of the default network interface.", cmd_show_ip, 1, 0);
+SHELL_CMD_ARG_REGISTER(compression, NULL, "Show transfer compression statistics, 'compression reset' clears them.", cmd_compression, 1, 1);
+SHELL_CMD_ARG_REGISTER(www_bundle, NULL, "Pack the web files into the web bundle in flash.", cmd_www_bundle, 1, 0);
 #endif
\ No newline at end of file
@@ -0,0 +1,222 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <string.h>
+
+#include "plc_compress.h"
+
+/***************************************************************************************************************************************/
+/*		transfer compression																								 		   */
+/***************************************************************************************************************************************/
+
+// Uploads are compressed by the host with heatshrink (LZSS, bit packed). The decoder needs the window and one output block
+// of RAM, about LZSS_OUTPUT_BLOCK + 2^LZSS_WINDOW_BITS bytes, and no heap. Trace samples are coded on the PLC, a xor delta
+// to the previous sample followed by a zero run length code is cheap enough for the debug path and removes the bytes of
+// all variables that didn't change.
+
+struct compress_stats upload_compress_stats;
+struct compress_stats trace_compress_stats;
+
+#define LZSS_WINDOW_MASK ((1 << LZSS_WINDOW_BITS) - 1)
+
+enum lzss_state
+{
+	LZSS_TAG,
+	LZSS_LITERAL,
+	LZSS_INDEX,
+	LZSS_COUNT,
+	LZSS_COPY,
+};
+
+// Width of the field read in each state
+static const uint8_t lzss_field_bits[] = {
+	[LZSS_TAG] = 1,
+	[LZSS_LITERAL] = 8,
+	[LZSS_INDEX] = LZSS_WINDOW_BITS,
+	[LZSS_COUNT] = LZSS_LOOKAHEAD_BITS,
+};
+
+/****************************************************************************************************************************************
+ * @brief 			Resets the decoder for a new stream. The window starts with zeros like in heatshrink.
+ *
+ * @param dec 		Decoder state.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void lzss_decoder_reset(struct lzss_decoder *dec)
+{
+	memset(dec, 0, sizeof(*dec));
+	dec->state = LZSS_TAG;
+}
+
+static int lzss_emit(struct lzss_decoder *dec, uint8_t c, lzss_sink_t sink, void *arg)
+{
+	dec->window[dec->head++ & LZSS_WINDOW_MASK] = c;
+	dec->out[dec->out_len++] = c;
+	if (dec->out_len < LZSS_OUTPUT_BLOCK)
+	{
+		return 0;
+	}
+	dec->out_len = 0;
+	return sink(dec->out, LZSS_OUTPUT_BLOCK, arg);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Decodes a piece of a heatshrink stream. The input can be split anywhere, even inside a field, decoding
+ * 					continues with the next call. Decoded data is passed to the sink in blocks of LZSS_OUTPUT_BLOCK bytes.
+ *
+ * @param dec 		Decoder state.
+ * @param in 		Compressed data.
+ * @param length 	Length of the compressed data.
+ * @param sink 		Called with every full block of decoded data.
+ * @param arg 		Passed to the sink.
+ * @return 			0 on success, otherwise the error returned by the sink.
+ ****************************************************************************************************************************************/
+int lzss_decode(struct lzss_decoder *dec, const uint8_t *in, size_t length, lzss_sink_t sink, void *arg)
+{
+	size_t pos = 0;
+	int ret = 0;
+
+	while (ret == 0)
+	{
+		if (dec->state == LZSS_COPY)
+		{
+			if (dec->count == 0)
+			{
+				dec->state = LZSS_TAG;
+				continue;
+			}
+			dec->count--;
+			ret = lzss_emit(dec, dec->window[(dec->head - dec->index) & LZSS_WINDOW_MASK], sink, arg);
+			continue;
+		}
+
+		// Fields are packed msb first
+		if (dec->bit_mask == 0)
+		{
+			if (pos == length)
+			{
+				break;
+			}
+			dec->current_byte = in[pos++];
+			dec->bit_mask = 0x80;
+		}
+		dec->bits = (dec->bits << 1) | ((dec->current_byte & dec->bit_mask) ? 1 : 0);
+		dec->bit_mask >>= 1;
+		if (++dec->bit_count < lzss_field_bits[dec->state])
+		{
+			continue;
+		}
+
+		uint16_t value = dec->bits;
+		dec->bits = 0;
+		dec->bit_count = 0;
+		switch (dec->state)
+		{
+		case LZSS_TAG:
+			dec->state = value ? LZSS_LITERAL : LZSS_INDEX;
+			break;
+		case LZSS_LITERAL:
+			dec->state = LZSS_TAG;
+			ret = lzss_emit(dec, (uint8_t)value, sink, arg);
+			break;
+		case LZSS_INDEX:
+			dec->index = value + 1;
+			dec->state = LZSS_COUNT;
+			break;
+		case LZSS_COUNT:
+			dec->count = value + 1;
+			dec->state = LZSS_COPY;
+			break;
+		}
+	}
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Ends a stream. Passes the decoded data left in the output block to the sink and resets the decoder. The
+ * 					padding bits of the last input byte are dropped.
+ *
+ * @param dec 		Decoder state.
+ * @param sink 		Called with the remaining decoded data.
+ * @param arg 		Passed to the sink.
+ * @return 			0 on success, otherwise the error returned by the sink.
+ ****************************************************************************************************************************************/
+int lzss_decode_finish(struct lzss_decoder *dec, lzss_sink_t sink, void *arg)
+{
+	int ret = 0;
+
+	if (dec->out_len > 0)
+	{
+		ret = sink(dec->out, dec->out_len, arg);
+	}
+	lzss_decoder_reset(dec);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Delta codes a trace sample, see TRACE_DELTA_MAX_SIZE for the format.
+ *
+ * @param prev 		Previous sample of the same size, or NULL for the first sample of a reply.
+ * @param cur 		Sample to code.
+ * @param length 	Size of the sample.
+ * @param out 		Destination, at least TRACE_DELTA_MAX_SIZE(length) bytes.
+ * @return 			Size of the coded sample.
+ ****************************************************************************************************************************************/
+size_t trace_delta_encode(const uint8_t *prev, const uint8_t *cur, size_t length, uint8_t *out)
+{
+	size_t in_pos = 0;
+	size_t out_pos = 0;
+
+#define DELTA(i) ((uint8_t)(cur[i] ^ (prev ? prev[i] : 0)))
+
+	while (in_pos < length)
+	{
+		size_t run = 0;
+		while ((in_pos + run < length) && (run < 128) && (DELTA(in_pos + run) == 0))
+		{
+			run++;
+		}
+		if (run > 0)
+		{
+			out[out_pos++] = 0x80 | (run - 1);
+			in_pos += run;
+			continue;
+		}
+
+		// Literals up to the next run of at least two zeros, a single zero is cheaper as literal
+		size_t control = out_pos++;
+		size_t count = 0;
+		while ((in_pos < length) && (count < 128))
+		{
+			if ((DELTA(in_pos) == 0) && (in_pos + 1 < length) && (DELTA(in_pos + 1) == 0))
+			{
+				break;
+			}
+			out[out_pos++] = DELTA(in_pos);
+			in_pos++;
+			count++;
+		}
+		out[control] = count - 1;
+	}
+
+#undef DELTA
+	return out_pos;
+}
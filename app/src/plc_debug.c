@@ -29,21 +29,17 @@ LOG_MODULE_REGISTER(plc_debug, LOG_LEVEL_INF);
 #include <zephyr/sys/ring_buffer.h>
 
 #include "config.h"
+#include "plc_compress.h"
 #include "plc_debug.h"
 #include "plc_loader.h"
+#include "plc_rpc.h"
+#include "plc_settings.h"
 #include "plc_util.h"
 
 /************************************************************************************************************************/
 /*		rte debugging																									*/
 /************************************************************************************************************************/
 
-// Definition of error codes for debugging functionalities
-#define TOO_MANY_TRACED -1
-#define TOO_MANY_FORCED -2
-#define FORCE_VAR_SIZE_OVERFLOW -3
-#define INVALID_FORCE_VALUE -4
-#define DEBUG_SUSPENDED -5
-
 // Ringbuffer for storing trace samples
 static uint8_t __attribute__((section(".ccm_noinit"))) _ring_buffer_data_trace_samples[TRACE_SAMPLE_BUFFER_SIZE];
 struct ring_buf trace_samples = {.buffer = _ring_buffer_data_trace_samples, .size = TRACE_SAMPLE_BUFFER_SIZE};
@@ -58,15 +54,49 @@ uint32_t traced_vars_count = 0;												// Count of currently traced vars
 size_t traced_vars_total_size = 0;											// Total size in bytes of traced variables
 uint32_t __ccm_noinit_section traced_vars_idxs[TRACE_VARS_MAX_COUNT] = {0};	// Indexes of traced variables
 uint32_t __ccm_noinit_section traced_vars_size[TRACE_VARS_MAX_COUNT] = {0};	// List of variable sizes that are being traced
+uint32_t __ccm_noinit_section traced_vars_divisor[TRACE_VARS_MAX_COUNT];	// Sampling divisor, variable is sampled when tick % divisor == 0
+atomic_t trace_records_available = ATOMIC_INIT(0);							// Count of complete trace records in the ringbuffer
+atomic_t trace_records_dropped = ATOMIC_INIT(0);							// Records lost because the ringbuffer was full, oldest first
+atomic_t trace_records_discarded = ATOMIC_INIT(0);							// Stored records removed before a host fetched them
+struct compress_stats trace_compress_stats;									// Cost and gain of the trace delta coding
 
 uint32_t forced_vars_count = 0;												// Count of currently forced vars
 size_t forced_vars_total_size = 0;											// Total size in bytes of forced variables
 uint32_t __ccm_noinit_section forced_vars_idxs[FORCE_VARS_MAX_COUNT] = {0}; // Indexes of forced variables
 uint32_t __ccm_noinit_section forced_vars_size[FORCE_VARS_MAX_COUNT] = {0}; // Sizes of forced variables
+uint8_t __ccm_noinit_section forced_vars_values[FORCE_VALUES_BUFFER_SIZE];	// Packed values of forced variables, passed to force_var
+
+// Staged trace and force configuration, applied by apply_trace_update at the next PLC cycle boundary
+static uint32_t staged_traced_count = 0;
+static size_t staged_traced_total_size = 0;
+static uint32_t __ccm_noinit_section staged_traced_idxs[TRACE_VARS_MAX_COUNT];
+static uint32_t __ccm_noinit_section staged_traced_size[TRACE_VARS_MAX_COUNT];
+static uint32_t __ccm_noinit_section staged_traced_divisor[TRACE_VARS_MAX_COUNT];
+static uint32_t staged_forced_count = 0;
+static size_t staged_forced_total_size = 0;
+static uint32_t __ccm_noinit_section staged_forced_idxs[FORCE_VARS_MAX_COUNT];
+static uint32_t __ccm_noinit_section staged_forced_size[FORCE_VARS_MAX_COUNT];
+static uint8_t __ccm_noinit_section staged_forced_values[FORCE_VALUES_BUFFER_SIZE];
+K_MUTEX_DEFINE(trace_update_mutex);											// Serializes staging and applying of trace changes
+K_MUTEX_DEFINE(stats_update_mutex);											// Serializes staging and applying of the statistics list
 
 K_SEM_DEFINE(plc_cycle_start, 0, 1);										// Semaphore for synchronizing with the PLC cycle
+K_CONDVAR_DEFINE(trace_data_ready);											// Broadcast by the debug thread when new samples were published
+K_MUTEX_DEFINE(trace_wait_mutex);											// Protects the wait for trace_data_ready against lost wakeups
+K_MUTEX_DEFINE(trace_read_mutex);											// Serializes consumers of trace_samples and layout changes, taken before plc_cycle_start
+K_MUTEX_DEFINE(output_write_mutex);											// Serializes writes of the outputs by plc_debug_write_image
+K_SEM_DEFINE(output_write_done, 0, 1);										// Given by the PLC task when the staged outputs were applied
 extern uint32_t __tick;														// Current PLC tick from plc_task.c
 extern uint32_t plc_run;													// PLC running state from plc_loader
+extern uint16_t QW[QW_COUNT];												// Process image from plc_io.c
+extern uint16_t IW[IW_COUNT];
+extern uint8_t QX[QX_COUNT];
+extern uint8_t IX[IX_COUNT];
+static uint8_t staged_qx[QX_COUNT];											// Output values staged by plc_debug_write_image
+static uint16_t staged_qw[QW_COUNT];
+static bool staged_qx_set[QX_COUNT];										// Outputs to overwrite in the next cycle
+static bool staged_qw_set[QW_COUNT];
+static bool staged_outputs = false;											// Set while outputs wait for apply_output_writes
 
 int stop_debug_thread = 0;													// Flag to request stopping of the debug thread
 int debug_thread_state = 0;													// State of the debug thread: 0 = not running, 1 = running
@@ -91,6 +121,19 @@ const char *print_buf(binary_t binary)
 	return staticBuffer;
 }
 
+/****************************************************************************************************************************************
+ * @brief                trace_data_ready_broadcast
+ *                       Wakes up every GetTraceVariables waiting for samples, each rpc session may wait in its own call.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void trace_data_ready_broadcast(void)
+{
+	k_mutex_lock(&trace_wait_mutex, K_FOREVER);
+	k_condvar_broadcast(&trace_data_ready);
+	k_mutex_unlock(&trace_wait_mutex);
+}
+
 /****************************************************************************************************************************************
  * @brief                plc_debug_thread
  *                       Starts when debugging is active and ends when debugging
@@ -130,8 +173,9 @@ void plc_debug_thread(void *, void *, void *)
 			if (publish_debug() == 0) // Read data from PLC
 			{
 				__debug_tick = __tick;						 // Remember the tick when data was copied into traceSample
+				trace_data_ready_broadcast();				 // Wake up all waiting GetTraceVariables
 				int64_t now = k_uptime_get();				 // Get current uptime in milliseconds
-				if ((now - last_trace_sent_timestamp) > DEBUG_TIMEOUT) // Check if timeout has occurred for the IDE to fetch data
+				if (((now - last_trace_sent_timestamp) > DEBUG_TIMEOUT) && !get_flight_recorder_setting()) // Check if timeout has occurred for the IDE to fetch data
 				{
 					LOG_DBG("debug_thread: timeout. exiting now");
 					break; // Exit the thread due to timeout
@@ -150,6 +194,7 @@ void plc_debug_thread(void *, void *, void *)
 
 	// Debug thread exited
 	k_sem_give(&plc_cycle_start); // Unlock the PLC cycle
+	trace_data_ready_broadcast(); // Don't let GetTraceVariables wait for samples that won't come
 	stop_debug_thread = 0;
 	last_trace_timestamp = 0;
 	debug_thread_state = 0; // Mark the debug thread as not running
@@ -167,12 +212,15 @@ void plc_debug_thread_start(void)
 	if (debug_thread_state == 0)
 	{
 		LOG_DBG("Starting debug thread");
+		stop_debug_thread = 0;
 		plc_debug_tid = k_thread_create(&plc_debug_thread_data, plc_debug_stack_area, K_THREAD_STACK_SIZEOF(plc_debug_stack_area), plc_debug_thread, NULL, NULL, NULL,
 										PLC_DEBUG_PRIORITY, 0, K_NO_WAIT);
 		k_thread_name_set(plc_debug_tid, "plc_debug_thread");
 	}
 }
 
+static void stats_resolve_vars(void);
+
 /****************************************************************************************************************************************
  * @brief                __init_debug
  *                       Called before the PLC starts to initialize debugging components.
@@ -182,7 +230,24 @@ void plc_debug_thread_start(void)
 void __init_debug(void)
 {
 	k_sem_give(&plc_cycle_start);
+	k_mutex_lock(&trace_read_mutex, K_FOREVER);
 	ring_buf_init(&trace_samples, TRACE_SAMPLE_BUFFER_SIZE, trace_samples.buffer);
+	atomic_clear(&trace_records_available);
+	atomic_clear(&trace_records_dropped);
+	atomic_clear(&trace_records_discarded);
+	k_mutex_unlock(&trace_read_mutex);
+
+	// Output writes staged for the previous run are not applied
+	staged_outputs = false;
+	memset(staged_qx_set, 0, sizeof(staged_qx_set));
+	memset(staged_qw_set, 0, sizeof(staged_qw_set));
+
+	// The PLC starts with freshly initialized variables, forces from the host have to be applied again
+	forced_vars_count = 0;
+	forced_vars_total_size = 0;
+
+	// A new program may have been loaded since the statistics were configured
+	stats_resolve_vars();
 
 	return;
 }
@@ -196,207 +261,550 @@ void __init_debug(void)
  ****************************************************************************************************************************************/
 void __cleanup_debug(void) { return; }
 
+/****************************************************************************************************************************************
+ * @brief                trace_record_size
+ *                       Calculates the size of the variable data in the trace record of a tick. Only variables whose
+ *                       sampling divisor divides the tick are part of the record, so records of different ticks may
+ *                       differ in size. With all divisors at 1 every record has traced_vars_total_size bytes.
+ * @param tick           PLC tick of the record.
+ * @return               Size of the variable data in bytes, 0 if no variable is sampled on this tick.
+ ****************************************************************************************************************************************/
+static size_t trace_record_size(uint32_t tick)
+{
+	size_t size = 0;
+	for (uint32_t i = 0; i < traced_vars_count; i++)
+	{
+		if ((tick % traced_vars_divisor[i]) == 0)
+			size += traced_vars_size[i];
+	}
+	return size;
+}
+
+/****************************************************************************************************************************************
+ * @brief                trace_discard_oldest
+ *                       Makes room for a new record by discarding the oldest records, they are counted as dropped. The
+ *                       PLC cycle must not wait for a reader, so nothing is discarded while a reader holds the ringbuffer.
+ * @param needed         Number of bytes needed for the new record.
+ * @return               0 if the record fits now, -EBUSY or -ENOSPC otherwise.
+ ****************************************************************************************************************************************/
+static int trace_discard_oldest(size_t needed)
+{
+	if (k_mutex_lock(&trace_read_mutex, K_NO_WAIT) != 0)
+		return -EBUSY;
+
+	while (ring_buf_space_get(&trace_samples) < needed)
+	{
+		uint32_t tick;
+		if (ring_buf_peek(&trace_samples, (uint8_t *)&tick, sizeof(tick)) != sizeof(tick))
+			break;
+		ring_buf_get(&trace_samples, NULL, sizeof(tick) + trace_record_size(tick));
+		atomic_dec(&trace_records_available);
+		atomic_inc(&trace_records_dropped);
+	}
+	int ret = (ring_buf_space_get(&trace_samples) < needed) ? -ENOSPC : 0;
+	k_mutex_unlock(&trace_read_mutex);
+	return ret;
+}
+
 /****************************************************************************************************************************************
  * @brief                publish_debug
- *                       Called every PLC cycle to manage and update the
- *                       debugging data. This includes applying forces to variables, tracing variable
- *                       values, and managing the debug transfer.
+ *                       Called every PLC cycle to manage and update the debugging data. Writes a record of the tick
+ *                       followed by the values of all variables due on this tick into the trace ringbuffer.
  * @param
- * @return               1 on success, -1 on error.
+ * @return               0 on success, -1 on error.
  ****************************************************************************************************************************************/
 #pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
 #pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
 int publish_debug(void)
 {
-    LOG_DBG("publish_debug: start");
-
-    // Check if the ring buffer has enough space for the data
-    LOG_DBG("publish_debug: free space in ringbuffer: %u", ring_buf_space_get(&trace_samples));
-
-    volatile size_t bytes_written = 0;
-    size_t var_size = 0;
-    void *var_value = NULL;
-    uint8_t *data_ptr;
-    uint32_t tick = __tick;
-
-    // Calculate the total size of data: size of 'tick' + total size of variables
-    size_t total_size = sizeof(tick) + (traced_vars_total_size > 0 ? traced_vars_total_size : 1);
-
-    uint32_t ret = ring_buf_put_claim(&trace_samples, &data_ptr, total_size);
-    if ((size_t)ret < total_size)
-    {
-        // Fill the rest of the buffer with 0 if there isn't enough space for all data
-        memset(data_ptr, 0, ret);
-        ring_buf_put_finish(&trace_samples, ret);
-
-        // Immediately read the filled bytes to "wrap" the buffer
-        //uint8_t temp_buf[ret]; // Temporary buffer to discard the filled data
-        ring_buf_get(&trace_samples, NULL, ret);
-
-        // Try again to claim the necessary space, now from the start of the buffer
-        ret = ring_buf_put_claim(&trace_samples, &data_ptr, total_size);
-        if (ret < 0 || (size_t)ret < total_size)
-        {
-            LOG_ERR("publish_debug: Not enough space in the RingBuffer after wrap-around, ret=%d", ret);
-            return -1; // Error handling on retry failure
-        }
-    }
-
-    // Write 'tick' first into the buffer
-    memcpy(data_ptr, &tick, sizeof(tick));
-    bytes_written += sizeof(tick);
-
-    if (traced_vars_total_size > 0)
-    {
-        // Write the data of all monitored variables into the buffer
-        for (uint32_t i = 0; i < traced_vars_count; i++)
-        {
-            // Read variable from PLC
-            int ret = GetDebugVariable(traced_vars_idxs[i], &var_value, &var_size);
-            if (ret == 0)
-            {
-                // Check if the read size matches the expected size
-                if (var_size != traced_vars_size[i])
-                {
-                    LOG_WRN("publish_debug: Unexpected size for variable %u, expected: %u but read: %u", traced_vars_idxs[i], traced_vars_size[i], var_size);
-                }
-
-                // Check if var_value is NULL after calling GetDebugVariable
-                if (var_value == NULL)
-                {
-                    LOG_ERR("publish_debug: Variable value is NULL for index %u", traced_vars_idxs[i]);
-                    ring_buf_put_finish(&trace_samples, bytes_written); // Abort but keep the data already written
-                    return -1;
-                }
-
-                // Copy data into the ring buffer
-                memcpy(data_ptr + bytes_written, var_value, var_size);
-                bytes_written += var_size;
-            }
-            else if (ret > 0)
-            {
-                LOG_ERR("publish_debug: Error reading variable type for idx %u", traced_vars_idxs[i]);
-                ring_buf_put_finish(&trace_samples, bytes_written); // Abort but keep the data already written
-                return -1;
-            }
-            else if (ret < 0)
-            {
-                LOG_ERR("publish_debug: Error reading variable idx %u out of bounds", traced_vars_idxs[i]);
-                ring_buf_put_finish(&trace_samples, bytes_written); // Abort but keep the data already written
-                return -1;
-            }
-        }
-    }
-    else
-    {
-        // Add a 0-byte if no variables are being monitored
-        *(data_ptr + bytes_written) = 0;
-        bytes_written += 1;
-    }
-
-    // Complete the write operation
-    ring_buf_put_finish(&trace_samples, bytes_written);
-    LOG_DBG("publish_debug: end, bytes written to ringbuffer: %u", bytes_written);
-    return 0;
+	size_t var_size = 0;
+	void *var_value = NULL;
+	uint32_t tick = __tick;
+	int result = 0;
+
+	size_t data_size = trace_record_size(tick);
+	if (data_size == 0)
+		return 0; // no variable sampled on this tick
+
+	// Only write complete records, so the reader never sees a record it can't decode. The oldest records are
+	// overwritten, the host gets the latest samples when it falls behind
+	if ((ring_buf_space_get(&trace_samples) < sizeof(tick) + data_size) && (trace_discard_oldest(sizeof(tick) + data_size) != 0))
+	{
+		LOG_DBG("publish_debug: ringbuffer full, sample of tick %u dropped", tick);
+		atomic_inc(&trace_records_dropped);
+		return 0;
+	}
+
+	ring_buf_put(&trace_samples, (uint8_t *)&tick, sizeof(tick));
+
+	for (uint32_t i = 0; i < traced_vars_count; i++)
+	{
+		if ((tick % traced_vars_divisor[i]) != 0)
+			continue;
+
+		// Read variable from PLC
+		int ret = (result == 0) ? GetDebugVariable(traced_vars_idxs[i], &var_value, &var_size) : -1;
+		if ((ret == 0) && (var_value != NULL) && (var_size == traced_vars_size[i]))
+		{
+			ring_buf_put(&trace_samples, var_value, var_size);
+			continue;
+		}
+
+		if (result == 0)
+			LOG_ERR("publish_debug: Error reading variable idx %u, ret=%d size=%u", traced_vars_idxs[i], ret, var_size);
+		result = -1;
+
+		// Pad the record, its size is fixed by the tick
+		static const uint8_t zero[8] = {0};
+		for (size_t pad = traced_vars_size[i]; pad > 0; pad -= MIN(pad, sizeof(zero)))
+			ring_buf_put(&trace_samples, zero, MIN(pad, sizeof(zero)));
+	}
+
+	atomic_inc(&trace_records_available);
+	return result;
 }
 #pragma GCC pop_options
 
 /****************************************************************************************************************************************
- * @brief               SetTraceVariablesList
- *                      Configures the list of variables to be traced or forced, based on input from the host.
- * 						This setup is crucial for determining which variables are included in debugging sessions.
- * @param orders        A structure containing the list of variables to trace or force, along with their configurations.
- * @param debugtoken    A pointer to store the updated debug token, which is used for session management.
- * @return              uint32_t - 0 on successful configuration, non-zero if an error occurred.
+ * @brief                find_var
+ *                       Looks up a variable index in a list of indexes and returns its position and the offset
+ *                       of its value in a packed value buffer.
+ * @param idxs           List of variable indexes.
+ * @param sizes          Sizes of the variables in the list.
+ * @param count          Number of entries in the list.
+ * @param idx            Variable index to look for.
+ * @param offset         Optional pointer to store the offset of the variable in the packed buffer.
+ * @return               Position in the list, -1 if the variable is not in the list.
+ ****************************************************************************************************************************************/
+static int find_var(const uint32_t *idxs, const uint32_t *sizes, uint32_t count, uint32_t idx, size_t *offset)
+{
+	size_t pos = 0;
+	for (uint32_t i = 0; i < count; i++)
+	{
+		if (idxs[i] == idx)
+		{
+			if (offset)
+				*offset = pos;
+			return i;
+		}
+		pos += sizes[i];
+	}
+	return -1;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stage_current_config
+ *                       Copies the active trace and force configuration into the staging area, so that single
+ *                       variables can be added, removed or forced on top of it.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void stage_current_config(void)
+{
+	staged_traced_count = traced_vars_count;
+	staged_traced_total_size = traced_vars_total_size;
+	memcpy(staged_traced_idxs, traced_vars_idxs, traced_vars_count * sizeof(uint32_t));
+	memcpy(staged_traced_size, traced_vars_size, traced_vars_count * sizeof(uint32_t));
+	memcpy(staged_traced_divisor, traced_vars_divisor, traced_vars_count * sizeof(uint32_t));
+
+	staged_forced_count = forced_vars_count;
+	staged_forced_total_size = forced_vars_total_size;
+	memcpy(staged_forced_idxs, forced_vars_idxs, forced_vars_count * sizeof(uint32_t));
+	memcpy(staged_forced_size, forced_vars_size, forced_vars_count * sizeof(uint32_t));
+	memcpy(staged_forced_values, forced_vars_values, forced_vars_total_size);
+}
+
+/****************************************************************************************************************************************
+ * @brief                stage_unforce
+ *                       Removes a variable from the staged force list.
+ * @param idx            Variable index.
+ * @return
+ ****************************************************************************************************************************************/
+static void stage_unforce(uint32_t idx)
+{
+	size_t offset;
+	int pos = find_var(staged_forced_idxs, staged_forced_size, staged_forced_count, idx, &offset);
+	if (pos < 0)
+		return;
+
+	size_t size = staged_forced_size[pos];
+	memmove(staged_forced_values + offset, staged_forced_values + offset + size, staged_forced_total_size - offset - size);
+	memmove(&staged_forced_idxs[pos], &staged_forced_idxs[pos + 1], (staged_forced_count - pos - 1) * sizeof(uint32_t));
+	memmove(&staged_forced_size[pos], &staged_forced_size[pos + 1], (staged_forced_count - pos - 1) * sizeof(uint32_t));
+	staged_forced_total_size -= size;
+	staged_forced_count--;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stage_force
+ *                       Adds or updates a variable in the staged force list. The value is copied into the staging
+ *                       buffer and zero padded to the size of the variable.
+ * @param idx            Variable index.
+ * @param size           Size of the variable in bytes.
+ * @param value          Force value from the host.
+ * @return               0 on success, TOO_MANY_FORCED or FORCE_VAR_SIZE_OVERFLOW on error.
+ ****************************************************************************************************************************************/
+static int stage_force(uint32_t idx, size_t size, const binary_t *value)
+{
+	stage_unforce(idx);
+
+	if (staged_forced_count >= FORCE_VARS_MAX_COUNT)
+		return TOO_MANY_FORCED;
+	if (staged_forced_total_size + size > FORCE_VALUES_BUFFER_SIZE)
+		return FORCE_VAR_SIZE_OVERFLOW;
+
+	uint8_t *dst = staged_forced_values + staged_forced_total_size;
+	memset(dst, 0, size);
+	memcpy(dst, value->data, MIN(value->dataLength, size));
+
+	staged_forced_idxs[staged_forced_count] = idx;
+	staged_forced_size[staged_forced_count] = size;
+	staged_forced_total_size += size;
+	staged_forced_count++;
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stage_trace_var
+ *                       Adds a variable to the staged trace list and stages its force state.
+ * @param idx            Variable index.
+ * @param force          Force value, NULL or empty to release a force.
+ * @param divisor        Sampling divisor, the variable is traced every divisor ticks.
+ * @return               0 on success, negative error code on failure.
  ****************************************************************************************************************************************/
 #pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
 #pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
-uint32_t SetTraceVariablesList(const list_trace_order_1_t *orders, uint32_t *debugtoken)
+static int stage_trace_var(uint32_t idx, const binary_t *force, uint32_t divisor)
 {
-	// TODO: 	Restarting everything when IDE forces a variable feels like a crash due to the delay. 
-	//     		Need a better solution to handle this situation.
-	// 
 	size_t var_size = 0;
 	void *var_value = NULL;
-	traced_vars_total_size = 0;
 
-	// Setting stop_debug_thread to 1 when debug_thread is inactive may cause indefinite
-	// waiting due to reliance on its termination to reset debug_thread_state to 0.
-	if (debug_thread_state == 1) 				// Check if debug_thread is running to safely attempt a stop
+	if (GetDebugVariable(idx, &var_value, &var_size) != 0)
+	{
+		LOG_ERR("stage_trace_var: error reading size of variable idx %u", idx);
+		return TOO_MANY_TRACED;
+	}
+
+	if (find_var(staged_traced_idxs, staged_traced_size, staged_traced_count, idx, NULL) < 0)
+	{
+		if (staged_traced_count >= TRACE_VARS_MAX_COUNT)
+			return TOO_MANY_TRACED;
+
+		staged_traced_idxs[staged_traced_count] = idx;
+		staged_traced_size[staged_traced_count] = var_size;
+		staged_traced_divisor[staged_traced_count] = MAX(divisor, 1);
+		staged_traced_total_size += var_size;
+		staged_traced_count++;
+	}
+
+	if (force && force->data && force->dataLength > 0)
+		return stage_force(idx, var_size, force);
+
+	stage_unforce(idx);
+	return 0;
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief                apply_trace_update
+ *                       Makes the staged configuration the active one. Must be called at a cycle boundary, i.e.
+ *                       while holding plc_cycle_start or while the PLC is stopped. Only forces that changed are
+ *                       passed to the PLC. Trace samples and the debug token are kept unless the sample layout
+ *                       changes. The caller holds trace_read_mutex, readers must not see a record of the old layout
+ *                       with the new sizes.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+#pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
+#pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
+static void apply_trace_update(void)
+{
+	bool changed[FORCE_VARS_MAX_COUNT];
+	size_t offset, staged_offset = 0;
+
+	// Release forces that are no longer requested
+	for (uint32_t i = 0; i < forced_vars_count; i++)
 	{
-		LOG_DBG("SetTraceVariablesList: try to stop debug_thread");
-		stop_debug_thread = 1;        			// Signal to stop debug thread to allow changes to traced variables
-		while (debug_thread_state == 1) 		// Wait until the debug thread has confirmed to stop
+		if (find_var(staged_forced_idxs, staged_forced_size, staged_forced_count, forced_vars_idxs[i], NULL) < 0)
 		{
-			k_msleep(1); 						// Sleep briefly to prevent busy waiting, checking debug_thread's termination
+			force_var(forced_vars_idxs[i], false, NULL);
+			LOG_DBG("apply_trace_update: var %u unforced", forced_vars_idxs[i]);
 		}
 	}
 
-	__debugtoken++;								// on every new set trace we take a new debugtoken
-	ring_buf_reset(&trace_samples); 			// and reset ringbuffer
+	// Find new or changed forces before the active values get overwritten
+	for (uint32_t i = 0; i < staged_forced_count; i++)
+	{
+		int pos = find_var(forced_vars_idxs, forced_vars_size, forced_vars_count, staged_forced_idxs[i], &offset);
+		changed[i] = (pos < 0) || (forced_vars_size[pos] != staged_forced_size[i]) ||
+					 (memcmp(forced_vars_values + offset, staged_forced_values + staged_offset, staged_forced_size[i]) != 0);
+		staged_offset += staged_forced_size[i];
+	}
 
-	if ((orders->elementsCount > 0) && (orders->elements != NULL))
+	forced_vars_count = staged_forced_count;
+	forced_vars_total_size = staged_forced_total_size;
+	memcpy(forced_vars_idxs, staged_forced_idxs, staged_forced_count * sizeof(uint32_t));
+	memcpy(forced_vars_size, staged_forced_size, staged_forced_count * sizeof(uint32_t));
+	memcpy(forced_vars_values, staged_forced_values, staged_forced_total_size);
+
+	offset = 0;
+	for (uint32_t i = 0; i < forced_vars_count; i++)
 	{
-		if (orders->elementsCount > TRACE_VARS_MAX_COUNT)
+		if (changed[i])
 		{
-			LOG_ERR("SetTraceVariablesList: too many traced variables");
-			*debugtoken = TOO_MANY_TRACED;
-			return 0;
+			force_var(forced_vars_idxs[i], true, forced_vars_values + offset);
+			LOG_DBG("apply_trace_update: var %u forced", forced_vars_idxs[i]);
 		}
+		offset += forced_vars_size[i];
+	}
 
-		trace_reset(); // call PLC Function to reset traced variables
-		traced_vars_total_size = 0;
-		for (uint32_t i = 0; i < orders->elementsCount; ++i)
-		{
-			traced_vars_idxs[i] = orders->elements[i].idx; // Var idx to List of traced variables
-			if (GetDebugVariable(traced_vars_idxs[i], &var_value, &var_size) == 0)
-			{
-				traced_vars_size[i] = var_size;		// Variable size in bytes
-				traced_vars_total_size += var_size; // add Variable size to total_size
-				traced_vars_count = i + 1;			// count of traced variables
-			}
-			else
-			{
-				LOG_ERR("SetTraceVariablesList: error reading size of variable idx %u", traced_vars_idxs[i]);
-				*debugtoken = TOO_MANY_TRACED;
-				return 0;
-			}
+	// A different trace list or sampling rate changes the sample layout, samples of the old layout can't be decoded by the IDE
+	if ((staged_traced_count != traced_vars_count) || (memcmp(staged_traced_idxs, traced_vars_idxs, traced_vars_count * sizeof(uint32_t)) != 0) ||
+		(memcmp(staged_traced_divisor, traced_vars_divisor, traced_vars_count * sizeof(uint32_t)) != 0))
+	{
+		traced_vars_count = staged_traced_count;
+		traced_vars_total_size = staged_traced_total_size;
+		memcpy(traced_vars_idxs, staged_traced_idxs, staged_traced_count * sizeof(uint32_t));
+		memcpy(traced_vars_size, staged_traced_size, staged_traced_count * sizeof(uint32_t));
+		memcpy(traced_vars_divisor, staged_traced_divisor, staged_traced_count * sizeof(uint32_t));
 
-			set_trace(orders->elements[i].idx, orders->elements[i].force.data ? true : false, orders->elements[i].force.data);
-			LOG_DBG("SetTraceVariablesList: var %u, size=%u forced: %s", traced_vars_idxs[i], traced_vars_size[i], orders->elements[i].force.data ? "true" : "false");
-		}
+		__debugtoken++;					// new sample layout, new debugtoken
+		ring_buf_reset(&trace_samples); // and drop samples of the old layout
+		atomic_add(&trace_records_discarded, atomic_clear(&trace_records_available));
+		LOG_DBG("apply_trace_update: new trace layout, traced_vars_total_size=%u", traced_vars_total_size);
+	}
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief                lock_cycle_boundary
+ *                       Waits for the end of the current PLC cycle and keeps the next one from starting. Nothing has
+ *                       to be locked while the PLC isn't running.
+ * @param locked         Set to true if plc_cycle_start was taken and has to be given back by unlock_cycle_boundary.
+ * @return               0 on success, -EAGAIN if no cycle boundary was reached within TRACE_UPDATE_TIMEOUT.
+ ****************************************************************************************************************************************/
+static int lock_cycle_boundary(bool *locked)
+{
+	*locked = false;
+	if (!plc_run)
+		return 0;
 
-		LOG_DBG("SetTraceVariablesList: try to start debug_thread, traced_vars_total_size=%u", traced_vars_total_size);
-		if (plc_run)
-			plc_debug_thread_start(); // start debug_thread to read variables from PLC into ringbuffer
+	if (k_sem_take(&plc_cycle_start, K_MSEC(TRACE_UPDATE_TIMEOUT)) != 0)
+		return -EAGAIN;
 
-		*debugtoken = __debugtoken; // return debugtoken to ide
+	*locked = true;
+	return 0;
+}
+
+static void unlock_cycle_boundary(bool locked)
+{
+	if (locked)
+		k_sem_give(&plc_cycle_start);
+}
+
+/****************************************************************************************************************************************
+ * @brief                commit_trace_update
+ *                       Applies the staged configuration at the next cycle boundary. The debug thread keeps running,
+ *                       the caller only waits until the current PLC cycle has finished. The readers of the trace are
+ *                       locked out before the cycle, so the PLC never waits for a reader.
+ * @param
+ * @return               0 on success, TRACE_UPDATE_FAILED if no cycle boundary was reached in time.
+ ****************************************************************************************************************************************/
+static int commit_trace_update(void)
+{
+	bool locked = false;
+	k_mutex_lock(&trace_read_mutex, K_FOREVER);
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		k_mutex_unlock(&trace_read_mutex);
+		LOG_ERR("commit_trace_update: timeout waiting for cycle boundary");
+		return TRACE_UPDATE_FAILED;
+	}
+	apply_trace_update();
+	unlock_cycle_boundary(locked);
+	k_mutex_unlock(&trace_read_mutex);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_debug_trace_add
+ *                       Adds a single variable to the trace list. Changes the sample layout and therefore the
+ *                       debug token.
+ * @param idx            Variable index.
+ * @return               0 on success, negative error code on failure.
+ ****************************************************************************************************************************************/
+int plc_debug_trace_add(uint32_t idx)
+{
+	k_mutex_lock(&trace_update_mutex, K_FOREVER);
+	stage_current_config();
+	int ret = stage_trace_var(idx, NULL, 1);
+	if (ret == 0)
+		ret = commit_trace_update();
+	k_mutex_unlock(&trace_update_mutex);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_debug_trace_remove
+ *                       Removes a single variable from the trace list and releases its force.
+ * @param idx            Variable index.
+ * @return               0 on success, negative error code on failure.
+ ****************************************************************************************************************************************/
+int plc_debug_trace_remove(uint32_t idx)
+{
+	k_mutex_lock(&trace_update_mutex, K_FOREVER);
+	stage_current_config();
+	int pos = find_var(staged_traced_idxs, staged_traced_size, staged_traced_count, idx, NULL);
+	if (pos >= 0)
+	{
+		staged_traced_total_size -= staged_traced_size[pos];
+		memmove(&staged_traced_idxs[pos], &staged_traced_idxs[pos + 1], (staged_traced_count - pos - 1) * sizeof(uint32_t));
+		memmove(&staged_traced_size[pos], &staged_traced_size[pos + 1], (staged_traced_count - pos - 1) * sizeof(uint32_t));
+		memmove(&staged_traced_divisor[pos], &staged_traced_divisor[pos + 1], (staged_traced_count - pos - 1) * sizeof(uint32_t));
+		staged_traced_count--;
+	}
+	stage_unforce(idx);
+	int ret = commit_trace_update();
+	k_mutex_unlock(&trace_update_mutex);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_debug_force
+ *                       Forces or releases a single variable. The trace list and the trace history are kept unless
+ *                       the variable wasn't traced before. Takes effect with the next PLC cycle.
+ * @param idx            Variable index.
+ * @param value          Force value, NULL or empty to release the force.
+ * @return               0 on success, negative error code on failure.
+ ****************************************************************************************************************************************/
+int plc_debug_force(uint32_t idx, const binary_t *value)
+{
+	k_mutex_lock(&trace_update_mutex, K_FOREVER);
+	stage_current_config();
+	int ret = stage_trace_var(idx, value, 1);
+	if (ret == 0)
+		ret = commit_trace_update();
+	k_mutex_unlock(&trace_update_mutex);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief               set_trace_list
+ *                      Stages a complete trace list and applies it at the next cycle boundary. The debug thread keeps
+ * 						running, and if only forces change, the debug token and the trace history are kept.
+ * @param count         Number of orders.
+ * @param orders        Orders from SetTraceVariablesList, or NULL.
+ * @param decimated     Orders with sampling divisor from SetDecimatedTraceVariablesList, or NULL.
+ * @param debugtoken    A pointer to store the updated debug token, which is used for session management.
+ * @return              uint32_t - 0, errors are returned as negative debugtoken.
+ ****************************************************************************************************************************************/
+static uint32_t set_trace_list(uint32_t count, const trace_order *orders, const decimated_trace_order *decimated, uint32_t *debugtoken)
+{
+	int ret = 0;
+	bool has_orders = (count > 0) && ((orders != NULL) || (decimated != NULL));
+
+	if (count > TRACE_VARS_MAX_COUNT)
+	{
+		LOG_ERR("SetTraceVariablesList: too many traced variables");
+		*debugtoken = TOO_MANY_TRACED;
 		return 0;
 	}
-	else
+
+	k_mutex_lock(&trace_update_mutex, K_FOREVER);
+
+	// The IDE always sends the complete list, build it from scratch in the staging area
+	staged_traced_count = 0;
+	staged_traced_total_size = 0;
+	staged_forced_count = 0;
+	staged_forced_total_size = 0;
+	for (uint32_t i = 0; has_orders && (i < count) && (ret == 0); ++i)
+	{
+		if (orders)
+			ret = stage_trace_var(orders[i].idx, &orders[i].force, 1);
+		else
+			ret = stage_trace_var(decimated[i].idx, &decimated[i].force, decimated[i].divisor);
+	}
+
+	if (ret == 0)
+		ret = commit_trace_update();
+	k_mutex_unlock(&trace_update_mutex);
+
+	if (ret != 0)
+	{
+		*debugtoken = ret;
+		return 0;
+	}
+
+	if (!has_orders)
 	{
-		// dont start debug_thread, when no variables are traced
+		// dont keep debug_thread running, when no variables are traced
+		stop_debug_thread = 1;
 		*debugtoken = DEBUG_SUSPENDED;
 		return 0;
 	}
 
+	LOG_DBG("SetTraceVariablesList: traced_vars_total_size=%u", traced_vars_total_size);
+	if (plc_run)
+	{
+		stop_debug_thread = 0;	  // keep a running debug_thread alive
+		plc_debug_thread_start(); // or start it to read variables from PLC into ringbuffer
+	}
+
+	*debugtoken = __debugtoken; // return debugtoken to ide
 	return 0;
 }
-#pragma GCC pop_options
 
 /****************************************************************************************************************************************
- * @brief				GetTraceVariables
- *                      Retrieves the currently traced variables and their values for transmission to the host.
- * 						This function is typically called by the host to fetch debugging data from the PLC.
+ * @brief               SetTraceVariablesList
+ *                      Configures the list of variables to be traced or forced, based on input from the host.
+ * 						Every variable is sampled on every tick.
+ * @param orders        A structure containing the list of variables to trace or force, along with their configurations.
+ * @param debugtoken    A pointer to store the updated debug token, which is used for session management.
+ * @return              uint32_t - 0 on successful configuration, non-zero if an error occurred.
+ ****************************************************************************************************************************************/
+uint32_t SetTraceVariablesList(const list_trace_order_1_t *orders, uint32_t *debugtoken)
+{
+	return set_trace_list(orders->elementsCount, orders->elements, NULL, debugtoken);
+}
+
+/****************************************************************************************************************************************
+ * @brief               SetDecimatedTraceVariablesList
+ *                      Like SetTraceVariablesList, but every variable carries a sampling divisor and is only sampled
+ * 						on ticks divisible by it. Records in the trace are then of mixed size: a record holds the
+ * 						values of all variables due on its tick, in list order. Ticks without a due variable are
+ * 						skipped. The host derives the layout of a record from its tick.
+ * @param orders        A structure containing the list of variables to trace or force with their sampling divisors.
+ * @param debugtoken    A pointer to store the updated debug token, which is used for session management.
+ * @return              uint32_t - 0 on successful configuration, non-zero if an error occurred.
+ ****************************************************************************************************************************************/
+uint32_t SetDecimatedTraceVariablesList(const list_decimated_trace_order_1_t *orders, uint32_t *debugtoken)
+{
+	return set_trace_list(orders->elementsCount, NULL, orders->elements, debugtoken);
+}
+
+/****************************************************************************************************************************************
+ * @brief				collect_trace
+ *                      Waits for trace samples and moves them from the ringbuffer into the reply. The reply is bounded by
+ * 						maxSize, counted as encoded by eRPC: tick, length and data of every sample. At least one sample is
+ * 						returned if one is available, the rest stays in the ringbuffer for the next call. If the session
+ * 						negotiated TRANSFER_ENCODING_TRACE_DELTA the samples are delta coded and the bound applies to the
+ * 						coded size.
  * @param debugToken    The debug token provided by the host, used to validate the session.
+ * @param timeoutMs     Maximum time to wait for samples in milliseconds, limited to TRACE_WAIT_MAX_TIMEOUT.
+ * @param minSamples    Number of samples to wait for, limited to what fits into the trace buffer.
+ * @param maxSize       Maximum size of the samples in the reply, limited to TRACE_RESPONSE_MAX_SIZE, 0 for the limit.
  * @param traces        A pointer to a structure where the traced variables and their values will be stored for transmission.
- * @return              uint32_t - 0, always return 0, Indicate error with traces->PLCstatus
+ * @param more          Optional pointer, set to true if samples were left in the ringbuffer.
+ * @return
  ****************************************************************************************************************************************/
-uint32_t GetTraceVariables(uint32_t debugToken, TraceVariables *traces)
+static void collect_trace(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TraceVariables *traces, bool *more)
 {
-	size_t total_bytes_available = 0;
 	uint32_t estimated_element_count = 0;
 	size_t block_size = 0;
+	size_t reply_size = 0;
+
+	if (more)
+		*more = false;
 
 	last_trace_sent_timestamp = k_uptime_get(); 				// get time in ms for timeout in debug_thread
 
@@ -405,69 +813,1017 @@ uint32_t GetTraceVariables(uint32_t debugToken, TraceVariables *traces)
 		plc_debug_thread_start();
 	}
 
-	if (debugToken != __debugtoken) 							// Check if DebugToken matches the current one
-	{
-		LOG_ERR("GetTraceVariables error: debugToken doesn't match, PLC connection broken");
-		traces->traces.elements = (trace_sample *)k_malloc(1 * sizeof(trace_sample));
-		traces->traces.elements[0].TraceBuffer.data = (uint8_t *)k_malloc(1 * sizeof(uint8_t));
-		traces->traces.elements[0].TraceBuffer.dataLength = 0; // we have no data!
-		traces->PLCstatus = Broken;							   // actual PLC Status
-		traces->traces.elements[0].tick = __tick;			   // Setting the tick for the combined trace element
-		traces->traces.elementsCount = 1;					   // set trace elements
-		return 0;											   // always return 0, Indicate error with traces->PLCstatus
-	}
-
-	// Determine the total size of a data block Including the size of the tick
+	// Size of a record with all variables due, records of decimated variables are smaller
 	block_size = traced_vars_total_size + sizeof(uint32_t);
 
 	uint32_t element_count = 0;
-	uint8_t *data_block;
 
-	while (true) // Wait until data is available in the ring buffer
+	// Never wait for more samples than the ring buffer can hold, or longer than the debug thread waits for the host
+	timeoutMs = MIN(timeoutMs, TRACE_WAIT_MAX_TIMEOUT);
+	minSamples = CLAMP(minSamples, 1, MAX(TRACE_SAMPLE_BUFFER_SIZE / 2 / block_size, 1));
+	maxSize = (maxSize == 0) ? TRACE_RESPONSE_MAX_SIZE : MIN(maxSize, TRACE_RESPONSE_MAX_SIZE);
+
+	int64_t deadline = k_uptime_get() + timeoutMs;
+	k_mutex_lock(&trace_wait_mutex, K_FOREVER);
+	while ((uint32_t)atomic_get(&trace_records_available) < minSamples)
 	{
-		total_bytes_available = ring_buf_size_get(&trace_samples);
-		estimated_element_count = total_bytes_available / block_size;
-		if (estimated_element_count > 0)
+		int64_t remaining = deadline - k_uptime_get();
+		if ((remaining <= 0) || !plc_run || (debug_thread_state == 0) || (debugToken != __debugtoken))
 			break;
 
-		k_msleep(1);
+		k_condvar_wait(&trace_data_ready, &trace_wait_mutex, K_MSEC(remaining)); // Woken up by the debug thread for every published sample
+	}
+	k_mutex_unlock(&trace_wait_mutex);
+
+	traces->traces.elementsCount = 0;
+	traces->traces.elements = NULL;
+	traces->PLCstatus = get_PLCStatus();
+
+	// Records are only counted when complete, tick and size of each record are known before it is consumed. The token
+	// is checked with the layout locked, SetTraceVariablesList may change it while waiting.
+	k_mutex_lock(&trace_read_mutex, K_FOREVER);
+	if (debugToken != __debugtoken) 							// Check if DebugToken matches the current one
+	{
+		k_mutex_unlock(&trace_read_mutex);
+		LOG_ERR("GetTraceVariables error: debugToken doesn't match, PLC connection broken");
+		traces->traces.elements = (trace_sample *)k_malloc(1 * sizeof(trace_sample));
+		if (traces->traces.elements != NULL)
+		{
+			traces->traces.elements[0].TraceBuffer.data = (uint8_t *)k_malloc(1 * sizeof(uint8_t));
+			traces->traces.elements[0].TraceBuffer.dataLength = 0; // we have no data!
+			traces->traces.elements[0].tick = __tick;			   // Setting the tick for the combined trace element
+			traces->traces.elementsCount = 1;					   // set trace elements
+		}
+		traces->PLCstatus = Broken;								   // actual PLC Status
+		return;													   // Indicate error with traces->PLCstatus
+	}
+
+	// Every sample takes at least its tick, its length and one byte of data in the reply
+	estimated_element_count = MIN((uint32_t)atomic_get(&trace_records_available), MAX(maxSize / (TRACE_SAMPLE_OVERHEAD + 1), 1));
+	if (estimated_element_count == 0)
+	{
+		k_mutex_unlock(&trace_read_mutex);
+		return; // nothing published in time, the host polls again
 	}
-	
+
 	// // Allocate memory for trace samples
 	traces->traces.elements = (trace_sample *)k_malloc(estimated_element_count * sizeof(trace_sample));
 	if (traces->traces.elements == NULL)
 	{
+		k_mutex_unlock(&trace_read_mutex);
 		LOG_ERR("GetTraceVariables error: failed to allocate memory for trace elements");
 		traces->PLCstatus = Broken; // error message to ide
-		return 0;					// always return 0, Indicate error with traces->PLCstatus
+		return;						// Indicate error with traces->PLCstatus
+	}
+
+	// Delta coding needs the raw record, the previous raw sample and the coded sample
+	uint8_t *record = NULL;
+	uint8_t *previous = NULL;
+	uint8_t *coded = NULL;
+	size_t previous_size = 0;
+	if (rpc_session_encodings() & TRANSFER_ENCODING_TRACE_DELTA)
+	{
+		record = (uint8_t *)k_malloc(sizeof(uint32_t) + 2 * traced_vars_total_size + TRACE_DELTA_MAX_SIZE(traced_vars_total_size));
+		if (record == NULL)
+		{
+			k_mutex_unlock(&trace_read_mutex);
+			LOG_ERR("GetTraceVariables error: failed to allocate memory for delta coding");
+			traces->PLCstatus = Broken; // error message to ide
+			return;						// Indicate error with traces->PLCstatus
+		}
+		previous = record + sizeof(uint32_t) + traced_vars_total_size;
+		coded = previous + traced_vars_total_size;
 	}
 
-	// Dynamically allocate memory for trace_sample elements
-	while (ring_buf_get_claim(&trace_samples, &data_block, block_size) == block_size)
+	while (element_count < estimated_element_count)
 	{
 		uint32_t tick;
-		memcpy(&tick, data_block, sizeof(uint32_t));	// Read tick from trace sample
+		if (ring_buf_peek(&trace_samples, (uint8_t *)&tick, sizeof(tick)) != sizeof(tick))
+			break;
+
+		size_t data_size = trace_record_size(tick);
+		size_t sample_size = data_size;
+		if (record != NULL)
+		{
+			uint32_t start = k_cycle_get_32();
+			ring_buf_peek(&trace_samples, record, sizeof(tick) + data_size);
+			sample_size = trace_delta_encode((previous_size == data_size) ? previous : NULL, record + sizeof(tick), data_size, coded);
+			trace_compress_stats.cycles += k_cycle_get_32() - start;
+		}
+		if ((element_count > 0) && (reply_size + TRACE_SAMPLE_OVERHEAD + sample_size > maxSize))
+			break; // keep the record for the next page
+
+		ring_buf_get(&trace_samples, NULL, sizeof(tick));
+		atomic_dec(&trace_records_available);
+		reply_size += TRACE_SAMPLE_OVERHEAD + sample_size;
+
+		trace_sample *sample = &traces->traces.elements[element_count++];
+		sample->tick = tick;
+		sample->TraceBuffer.dataLength = 0;
 
 		// Dynamically allocate memory for the data in trace_sample
-		traces->traces.elements[element_count].TraceBuffer.data = (uint8_t *)k_malloc(traced_vars_total_size);
-		if (traces->traces.elements[element_count].TraceBuffer.data == NULL)
+		sample->TraceBuffer.data = (uint8_t *)k_malloc(sample_size);
+		if (sample->TraceBuffer.data == NULL)
 		{
 			LOG_ERR("GetTraceVariables error: failed to allocate memory for trace data");
-			element_count++;
-			continue; // Attempt to read more blocks or abort
+			ring_buf_get(&trace_samples, NULL, data_size); // Skip the record data
+			atomic_inc(&trace_records_discarded);
+			continue;
 		}
 
-		memcpy(traces->traces.elements[element_count].TraceBuffer.data, data_block + sizeof(uint32_t), traced_vars_total_size);
-		traces->traces.elements[element_count].TraceBuffer.dataLength = traced_vars_total_size;
-		traces->traces.elements[element_count].tick = tick;
-
-		// Mark the read block as finished processing
-		ring_buf_get_finish(&trace_samples, block_size);
+		if (record == NULL)
+		{
+			sample->TraceBuffer.dataLength = ring_buf_get(&trace_samples, sample->TraceBuffer.data, data_size);
+			continue;
+		}
 
-		element_count++; // Read next element
+		// The delivered sample becomes the reference of the next one
+		ring_buf_get(&trace_samples, NULL, data_size);
+		memcpy(sample->TraceBuffer.data, coded, sample_size);
+		sample->TraceBuffer.dataLength = sample_size;
+		memcpy(previous, record + sizeof(tick), data_size);
+		previous_size = data_size;
+		trace_compress_stats.raw_bytes += data_size;
+		trace_compress_stats.coded_bytes += sample_size;
 	}
+	if (more)
+		*more = (atomic_get(&trace_records_available) > 0);
+	k_mutex_unlock(&trace_read_mutex);
+	k_free(record);
 	traces->traces.elementsCount = element_count;
-	traces->PLCstatus = get_PLCStatus();
+}
 
-	return 0;
+/****************************************************************************************************************************************
+ * @brief				GetTraceVariables
+ *                      Retrieves the currently traced variables and their values for transmission to the host.
+ * 						This function is typically called by the host to fetch debugging data from the PLC.
+ * 						Waits at most TRACE_WAIT_DEFAULT_TIMEOUT for the first sample. Returns at most
+ * 						TRACE_RESPONSE_MAX_SIZE bytes of samples, the IDE fetches the rest with its next poll.
+ * @param debugToken    The debug token provided by the host, used to validate the session.
+ * @param traces        A pointer to a structure where the traced variables and their values will be stored for transmission.
+ * @return              uint32_t - 0, always return 0, Indicate error with traces->PLCstatus
+ ****************************************************************************************************************************************/
+uint32_t GetTraceVariables(uint32_t debugToken, TraceVariables *traces)
+{
+	return GetTraceVariablesWait(debugToken, TRACE_WAIT_DEFAULT_TIMEOUT, 1, traces);
+}
+
+/****************************************************************************************************************************************
+ * @brief				GetTraceVariablesWait
+ *                      Long-poll variant of GetTraceVariables. Blocks until at least minSamples samples are available,
+ * 						the timeout expires or the debug thread stops. The debug thread signals every published sample,
+ * 						so no polling is needed. An empty list is returned if nothing was published in time.
+ * @param debugToken    The debug token provided by the host, used to validate the session.
+ * @param timeoutMs     Maximum time to wait for samples in milliseconds, limited to TRACE_WAIT_MAX_TIMEOUT.
+ * @param minSamples    Number of samples to wait for, limited to what fits into the trace buffer.
+ * @param traces        A pointer to a structure where the traced variables and their values will be stored for transmission.
+ * @return              uint32_t - 0, always return 0, Indicate error with traces->PLCstatus
+ ****************************************************************************************************************************************/
+uint32_t GetTraceVariablesWait(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, TraceVariables *traces)
+{
+	collect_trace(debugToken, timeoutMs, minSamples, 0, traces, NULL);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief				GetTraceVariablesPage
+ *                      Paged variant of GetTraceVariablesWait. The reply holds at most maxSize bytes of samples and tells
+ * 						the host whether more samples are waiting, so it can fetch them at once instead of waiting for
+ * 						the next poll. dropped counts the samples lost because the trace buffer was full, the oldest
+ * 						samples are overwritten,
+ * 						discarded the recorded samples lost before a host fetched them, both since the PLC was started.
+ * 						A growing count means the host is falling behind.
+ * @param debugToken    The debug token provided by the host, used to validate the session.
+ * @param timeoutMs     Maximum time to wait for samples in milliseconds, limited to TRACE_WAIT_MAX_TIMEOUT.
+ * @param minSamples    Number of samples to wait for, limited to what fits into the trace buffer.
+ * @param maxSize       Maximum size of the samples in the reply, limited to TRACE_RESPONSE_MAX_SIZE, 0 for the limit.
+ * @param page          A pointer to a structure where the samples, the more flag and the counters will be stored.
+ * @return              uint32_t - 0, always return 0, Indicate error with page->samples.PLCstatus
+ ****************************************************************************************************************************************/
+uint32_t GetTraceVariablesPage(uint32_t debugToken, uint32_t timeoutMs, uint32_t minSamples, uint32_t maxSize, TracePage *page)
+{
+	collect_trace(debugToken, timeoutMs, minSamples, maxSize, &page->samples, &page->more);
+	page->dropped = atomic_get(&trace_records_dropped);
+	page->discarded = atomic_get(&trace_records_discarded);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_debug_host_attached
+ *                       Checks whether a host fetched trace samples within DEBUG_TIMEOUT.
+ * @param
+ * @return               true while the IDE polls GetTraceVariables, otherwise false.
+ ****************************************************************************************************************************************/
+bool plc_debug_host_attached(void)
+{
+	return (last_trace_sent_timestamp != 0) && ((k_uptime_get() - last_trace_sent_timestamp) <= DEBUG_TIMEOUT);
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_debug_drain_trace
+ *                       Moves complete trace records from trace_samples into buf, for consumers other than the IDE.
+ *                       Each record is copied as it is stored, the tick followed by the data of the variables due on
+ *                       that tick. If the trace layout differs from the one the caller knows, the current layout is
+ *                       copied into layout and nothing is drained, so records are never decoded with a wrong layout.
+ * @param buf            Destination of the records.
+ * @param size           Size of buf in bytes, only records that fit completely are moved.
+ * @param layout         Layout known by the caller, updated if the trace layout changed.
+ * @param records        Returns the number of records moved.
+ * @return               Number of bytes moved into buf.
+ ****************************************************************************************************************************************/
+size_t plc_debug_drain_trace(uint8_t *buf, size_t size, struct trace_layout *layout, uint32_t *records)
+{
+	size_t used = 0;
+
+	*records = 0;
+	k_mutex_lock(&trace_read_mutex, K_FOREVER);
+	if (layout->token != __debugtoken)
+	{
+		layout->token = __debugtoken;
+		layout->count = traced_vars_count;
+		memcpy(layout->idxs, traced_vars_idxs, traced_vars_count * sizeof(uint32_t));
+		memcpy(layout->size, traced_vars_size, traced_vars_count * sizeof(uint32_t));
+		memcpy(layout->divisor, traced_vars_divisor, traced_vars_count * sizeof(uint32_t));
+	}
+	else
+	{
+		while (atomic_get(&trace_records_available) > 0)
+		{
+			uint32_t tick;
+			if (ring_buf_peek(&trace_samples, (uint8_t *)&tick, sizeof(tick)) != sizeof(tick))
+				break;
+
+			size_t record_size = sizeof(tick) + trace_record_size(tick);
+			if (used + record_size > size)
+				break;
+
+			used += ring_buf_get(&trace_samples, buf + used, record_size);
+			atomic_dec(&trace_records_available);
+			(*records)++;
+		}
+	}
+	k_mutex_unlock(&trace_read_mutex);
+
+	return used;
+}
+
+/************************************************************************************************************************/
+/*		rte statistics																									*/
+/************************************************************************************************************************/
+
+// Value of a watched variable in the type it is aggregated in, integers are exact, floats single precision
+union stats_num
+{
+	int64_t i;					// StatSigned
+	uint64_t u;					// StatUnsigned
+	float f;					// StatFloat, REAL and LREAL
+};
+
+// Running aggregation of one watched variable. update_statistics runs inside the PLC cycle, it only uses integer and
+// single precision float arithmetic, the doubles of var_statistics are calculated when the aggregates are read.
+struct stats_var
+{
+	uint32_t idx;
+	uint8_t type;				// stat_type_enum
+	uint8_t size;				// Variable size in bytes, 1, 2, 4 or 8
+	uint8_t last_raw[8];		// Last raw value for change detection
+	const void *value;			// Location of the variable in the loaded program, resolved when the PLC starts
+	union stats_num min;
+	union stats_num max;
+	union stats_num last;
+	union stats_num sum;		// Sum of all values in the current window, 64 bit integers and floats are summed as float
+	float sum_error;			// Compensation of the float sum
+	uint32_t samples;
+	uint32_t changes;
+	uint32_t timeInState;
+};
+
+static struct stats_var __ccm_noinit_section stats_vars[STATS_VARS_MAX_COUNT];
+static var_statistics __ccm_noinit_section stats_completed[STATS_VARS_MAX_COUNT]; // Aggregates of the last completed window
+static uint32_t stats_vars_count = 0;										// Count of variables with statistics
+static uint32_t stats_window_ms = 0;										// Window length, 0 = aggregate until reconfigured
+static uint32_t stats_window_start = 0;										// Uptime when the current window started
+static uint32_t stats_completed_window = 0;									// Length of the last completed window, 0 = none yet
+static uint32_t stats_last_update = 0;										// Uptime of the last update_statistics call
+
+/****************************************************************************************************************************************
+ * @brief                stats_value
+ *                       Converts the raw value of a variable into the type it is aggregated in.
+ * @param raw            Pointer to the raw value.
+ * @param size           Size of the variable in bytes.
+ * @param type           stat_type_enum of the variable.
+ * @return               The value.
+ ****************************************************************************************************************************************/
+static union stats_num stats_value(const void *raw, uint8_t size, uint8_t type)
+{
+	union
+	{
+		uint8_t u8;
+		int8_t i8;
+		uint16_t u16;
+		int16_t i16;
+		uint32_t u32;
+		int32_t i32;
+		uint64_t u64;
+		int64_t i64;
+		float f32;
+		double f64;
+	} v;
+	union stats_num num = {0};
+	memcpy(&v, raw, size); // PLC variables are not necessarily aligned
+
+	switch (size)
+	{
+	case 1:
+		if (type == StatSigned)
+			num.i = v.i8;
+		else
+			num.u = v.u8;
+		break;
+	case 2:
+		if (type == StatSigned)
+			num.i = v.i16;
+		else
+			num.u = v.u16;
+		break;
+	case 4:
+		if (type == StatFloat)
+			num.f = v.f32;
+		else if (type == StatSigned)
+			num.i = v.i32;
+		else
+			num.u = v.u32;
+		break;
+	default:
+		if (type == StatFloat)
+			num.f = (float)v.f64; // LREAL is aggregated in single precision
+		else if (type == StatSigned)
+			num.i = v.i64;
+		else
+			num.u = v.u64;
+		break;
+	}
+	return num;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_to_double
+ *                       Converts an aggregated value for transmission.
+ * @param num            The value.
+ * @param type           stat_type_enum of the variable.
+ * @return               The value as double.
+ ****************************************************************************************************************************************/
+static double stats_to_double(union stats_num num, uint8_t type)
+{
+	if (type == StatFloat)
+		return num.f;
+	if (type == StatSigned)
+		return (double)num.i;
+	return (double)num.u;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_float_sum
+ *                       Tells whether the sum of a variable is kept as float. 64 bit integers would overflow an integer sum.
+ * @param var            The watched variable.
+ * @return               true if the sum is a float.
+ ****************************************************************************************************************************************/
+static inline bool stats_float_sum(const struct stats_var *var)
+{
+	return (var->type == StatFloat) || (var->size == 8);
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_reset_window
+ *                       Starts a new aggregation window for all watched variables.
+ * @param now            Current uptime in milliseconds.
+ * @return
+ ****************************************************************************************************************************************/
+static void stats_reset_window(uint32_t now)
+{
+	for (uint32_t i = 0; i < stats_vars_count; i++)
+	{
+		stats_vars[i].sum.u = 0;
+		stats_vars[i].sum_error = 0;
+		stats_vars[i].samples = 0;
+		stats_vars[i].changes = 0;
+		stats_vars[i].timeInState = 0;
+	}
+	stats_window_start = now;
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_snapshot
+ *                       Converts the aggregates of a window for transmission, with the mean calculated.
+ * @param dst            Destination array with space for stats_vars_count entries.
+ * @return
+ ****************************************************************************************************************************************/
+static void stats_snapshot(var_statistics *dst)
+{
+	for (uint32_t i = 0; i < stats_vars_count; i++)
+	{
+		const struct stats_var *var = &stats_vars[i];
+		double sum = stats_float_sum(var) ? (double)var->sum.f : stats_to_double(var->sum, var->type);
+
+		memset(&dst[i], 0, sizeof(var_statistics));
+		dst[i].idx = var->idx;
+		dst[i].samples = var->samples;
+		dst[i].changes = var->changes;
+		dst[i].timeInState = var->timeInState;
+		if (var->samples > 0)
+		{
+			dst[i].min = stats_to_double(var->min, var->type);
+			dst[i].max = stats_to_double(var->max, var->type);
+			dst[i].last = stats_to_double(var->last, var->type);
+			dst[i].mean = sum / var->samples;
+		}
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_less
+ *                       Compares two aggregated values.
+ * @param a              First value.
+ * @param b              Second value.
+ * @param type           stat_type_enum of the variable.
+ * @return               true if a is less than b.
+ ****************************************************************************************************************************************/
+static inline bool stats_less(union stats_num a, union stats_num b, uint8_t type)
+{
+	if (type == StatFloat)
+		return a.f < b.f;
+	if (type == StatSigned)
+		return a.i < b.i;
+	return a.u < b.u;
+}
+
+/****************************************************************************************************************************************
+ * @brief                update_statistics
+ *                       Called by the PLC task at the end of every cycle, while plc_cycle_start is held. Updates min,
+ *                       max, sum, last value, change count and the time spent non-zero (time in state) of every
+ *                       watched variable and closes the window when it has elapsed. The variables are read through the
+ *                       locations resolved by stats_resolve_vars, no PLC code is called here.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+void update_statistics(void)
+{
+	if (stats_vars_count == 0)
+		return;
+
+	uint32_t now = k_uptime_get_32();
+	uint32_t elapsed = now - stats_last_update; // time the previous values were held
+	stats_last_update = now;
+
+	for (uint32_t i = 0; i < stats_vars_count; i++)
+	{
+		struct stats_var *var = &stats_vars[i];
+
+		if (var->value == NULL)
+			continue;
+
+		union stats_num value = stats_value(var->value, var->size, var->type);
+		bool was_active = (var->type == StatFloat) ? (var->last.f != 0.0f) : (var->last.u != 0);
+
+		if (var->samples == 0)
+		{
+			var->min = value;
+			var->max = value;
+		}
+		else
+		{
+			if (stats_less(value, var->min, var->type))
+				var->min = value;
+			if (stats_less(var->max, value, var->type))
+				var->max = value;
+			if (memcmp(var->last_raw, var->value, var->size) != 0)
+				var->changes++;
+			if (was_active)
+				var->timeInState += elapsed;
+		}
+
+		if (stats_float_sum(var))
+		{
+			// compensated summation keeps the mean of long windows accurate in single precision
+			float add = (var->type == StatFloat) ? value.f : (var->type == StatSigned) ? (float)value.i : (float)value.u;
+			add -= var->sum_error;
+			float sum = var->sum.f + add;
+			var->sum_error = (sum - var->sum.f) - add;
+			var->sum.f = sum;
+		}
+		else if (var->type == StatSigned)
+		{
+			var->sum.i += value.i;
+		}
+		else
+		{
+			var->sum.u += value.u;
+		}
+		var->last = value;
+		var->samples++;
+		memcpy(var->last_raw, var->value, var->size);
+	}
+
+	if ((stats_window_ms > 0) && ((now - stats_window_start) >= stats_window_ms))
+	{
+		stats_snapshot(stats_completed);
+		stats_completed_window = now - stats_window_start;
+		stats_reset_window(now);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                stats_resolve_vars
+ *                       Looks up the locations of the watched variables in the loaded program. Called before the PLC
+ *                       starts, a variable that doesn't exist in the program any more is skipped by update_statistics.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+#pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
+#pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
+static void stats_resolve_vars(void)
+{
+	for (uint32_t i = 0; i < stats_vars_count; i++)
+	{
+		void *var_value = NULL;
+		size_t var_size = 0;
+
+		if ((GetDebugVariable(stats_vars[i].idx, &var_value, &var_size) != 0) || (var_size != stats_vars[i].size))
+			var_value = NULL;
+		stats_vars[i].value = var_value;
+	}
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief               SetStatisticsVariablesList
+ *                      Configures the variables for which statistics are aggregated on the device. The new list is
+ * 						applied at the next cycle boundary and starts a new window. Concurrent sessions are serialized,
+ * 						the staging area is shared.
+ * @param orders        List of variable indexes and how their values are interpreted.
+ * @param windowMs      Length of an aggregation window in milliseconds, 0 to aggregate until the list is changed.
+ * @return              uint32_t - 0 on success, non-zero if an error occurred.
+ ****************************************************************************************************************************************/
+#pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
+#pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
+uint32_t SetStatisticsVariablesList(const list_stat_order_1_t *orders, uint32_t windowMs)
+{
+	static struct stats_var staged[STATS_VARS_MAX_COUNT];
+	void *var_value = NULL;
+	size_t var_size = 0;
+	bool locked = false;
+
+	if (orders->elementsCount > STATS_VARS_MAX_COUNT)
+	{
+		LOG_ERR("SetStatisticsVariablesList: too many variables");
+		return TOO_MANY_TRACED;
+	}
+
+	k_mutex_lock(&stats_update_mutex, K_FOREVER);
+	for (uint32_t i = 0; i < orders->elementsCount; i++)
+	{
+		if ((GetDebugVariable(orders->elements[i].idx, &var_value, &var_size) != 0) || (var_value == NULL) ||
+			!((var_size == 1) || (var_size == 2) || (var_size == 4) || (var_size == 8)) || ((orders->elements[i].type == StatFloat) && (var_size < 4)))
+		{
+			LOG_ERR("SetStatisticsVariablesList: unsupported variable idx %u, size %u", orders->elements[i].idx, var_size);
+			k_mutex_unlock(&stats_update_mutex);
+			return INVALID_STATS_VAR;
+		}
+
+		memset(&staged[i], 0, sizeof(struct stats_var));
+		staged[i].idx = orders->elements[i].idx;
+		staged[i].type = orders->elements[i].type;
+		staged[i].size = var_size;
+		staged[i].value = var_value;
+	}
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		LOG_ERR("SetStatisticsVariablesList: timeout waiting for cycle boundary");
+		k_mutex_unlock(&stats_update_mutex);
+		return TRACE_UPDATE_FAILED;
+	}
+
+	memcpy(stats_vars, staged, orders->elementsCount * sizeof(struct stats_var));
+	stats_vars_count = orders->elementsCount;
+	stats_window_ms = windowMs;
+	stats_completed_window = 0;
+	stats_last_update = k_uptime_get_32();
+	stats_reset_window(stats_last_update);
+
+	unlock_cycle_boundary(locked);
+	k_mutex_unlock(&stats_update_mutex);
+	return 0;
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief               GetStatistics
+ *                      Returns the aggregates of the last completed window. As long as no window has been completed,
+ * 						the aggregates of the running window are returned.
+ * @param statistics    A pointer to a structure where the aggregates will be stored for transmission.
+ * @return              uint32_t - 0, always return 0, Indicate error with statistics->PLCstatus
+ ****************************************************************************************************************************************/
+uint32_t GetStatistics(TraceStatistics *statistics)
+{
+	bool locked = false;
+
+	statistics->PLCstatus = get_PLCStatus();
+	statistics->window = 0;
+	statistics->stats.elementsCount = 0;
+	statistics->stats.elements = NULL;
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		statistics->PLCstatus = Broken;
+		return 0;
+	}
+
+	if (stats_vars_count > 0)
+	{
+		statistics->stats.elements = (var_statistics *)k_malloc(stats_vars_count * sizeof(var_statistics));
+		if (statistics->stats.elements == NULL)
+		{
+			LOG_ERR("GetStatistics error: failed to allocate memory for statistics");
+			statistics->PLCstatus = Broken;
+		}
+		else if (stats_completed_window > 0)
+		{
+			memcpy(statistics->stats.elements, stats_completed, stats_vars_count * sizeof(var_statistics));
+			statistics->stats.elementsCount = stats_vars_count;
+			statistics->window = stats_completed_window;
+		}
+		else
+		{
+			stats_snapshot(statistics->stats.elements);
+			statistics->stats.elementsCount = stats_vars_count;
+			statistics->window = k_uptime_get_32() - stats_window_start;
+		}
+	}
+
+	unlock_cycle_boundary(locked);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief               ReadVariables
+ *                      Reads a list of variables at one PLC cycle boundary, so all values belong to the same cycle. The
+ * 						trace configuration and the debug thread are not touched. The values are packed in the order of
+ * 						the request, like the variables in a trace sample, and the size of each value is returned with
+ * 						them. The sizes are taken under the cycle lock, a program loaded meanwhile can't split the values
+ * 						differently.
+ * @param idxs          Debug indexes of the variables.
+ * @param snapshot      A pointer to store the tick of the snapshot, the packed values and their sizes.
+ * @return              uint32_t - 0 on success, negative error code on failure.
+ ****************************************************************************************************************************************/
+#pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
+#pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
+uint32_t ReadVariables(const list_uint32_1_t *idxs, variable_snapshot *snapshot)
+{
+	void *var_value = NULL;
+	size_t var_size = 0;
+	size_t offset = 0;
+	bool locked = false;
+	uint32_t ret = 0;
+
+	snapshot->tick = 0;
+	snapshot->values.data = NULL;
+	snapshot->values.dataLength = 0;
+	snapshot->sizes.elements = NULL;
+	snapshot->sizes.elementsCount = 0;
+
+	if (idxs->elementsCount > RW_VARS_MAX_COUNT)
+	{
+		LOG_ERR("ReadVariables: too many variables");
+		return TOO_MANY_TRACED;
+	}
+
+	// Allocate for the largest reply, the PLC cycle isn't held up by the heap
+	snapshot->values.data = (uint8_t *)k_malloc(RW_VALUES_MAX_SIZE);
+	snapshot->sizes.elements = (uint32_t *)k_malloc(MAX(idxs->elementsCount, 1) * sizeof(uint32_t));
+	if ((snapshot->values.data == NULL) || (snapshot->sizes.elements == NULL))
+	{
+		LOG_ERR("ReadVariables error: failed to allocate memory for values");
+		ret = FORCE_VAR_SIZE_OVERFLOW;
+		goto fail;
+	}
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		LOG_ERR("ReadVariables: timeout waiting for cycle boundary");
+		ret = TRACE_UPDATE_FAILED;
+		goto fail;
+	}
+
+	if (plc_get_loader_state() == 0)
+	{
+		LOG_ERR("ReadVariables: no plc program loaded");
+		ret = INVALID_VARIABLE;
+	}
+
+	for (uint32_t i = 0; (ret == 0) && (i < idxs->elementsCount); i++)
+	{
+		if ((GetDebugVariable(idxs->elements[i], &var_value, &var_size) != 0) || (var_value == NULL))
+		{
+			LOG_ERR("ReadVariables: invalid variable idx %u", idxs->elements[i]);
+			ret = INVALID_VARIABLE;
+		}
+		else if (var_size > RW_VALUES_MAX_SIZE - offset)
+		{
+			LOG_ERR("ReadVariables: values don't fit into one reply");
+			ret = FORCE_VAR_SIZE_OVERFLOW;
+		}
+		else
+		{
+			memcpy(snapshot->values.data + offset, var_value, var_size);
+			snapshot->sizes.elements[i] = var_size;
+			offset += var_size;
+		}
+	}
+	snapshot->tick = __tick;
+
+	unlock_cycle_boundary(locked);
+
+	if (ret != 0)
+		goto fail;
+
+	snapshot->values.dataLength = offset;
+	snapshot->sizes.elementsCount = idxs->elementsCount;
+	return 0;
+
+fail:
+	k_free(snapshot->values.data);
+	k_free(snapshot->sizes.elements);
+	snapshot->values.data = NULL;
+	snapshot->sizes.elements = NULL;
+	return ret;
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief               WriteVariables
+ *                      Writes a list of variables at one PLC cycle boundary, all values are in place before the next
+ * 						config_run__. Unlike a force the value is written once, the program may change it afterwards and
+ * 						a forced variable keeps its forced value. Shorter values are zero padded to the variable size.
+ * 						Either all or none of the values are written, the variables are checked under the cycle lock.
+ * @param values        Debug indexes and new values of the variables.
+ * @return              uint32_t - 0 on success, negative error code on failure.
+ ****************************************************************************************************************************************/
+#pragma GCC push_options	// This function invokes dynamically loaded PLC code functions via udynlink, where 
+#pragma GCC optimize("O0")	// disabling optimizations enhances call reliability and ensures stable execution.
+uint32_t WriteVariables(const list_variable_write_1_t *values)
+{
+	void *var_value = NULL;
+	size_t var_size = 0;
+	bool locked = false;
+	uint32_t ret = 0;
+
+	if (values->elementsCount > RW_VARS_MAX_COUNT)
+	{
+		LOG_ERR("WriteVariables: too many variables");
+		return TOO_MANY_FORCED;
+	}
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		LOG_ERR("WriteVariables: timeout waiting for cycle boundary");
+		return TRACE_UPDATE_FAILED;
+	}
+
+	// Variables are looked up under the cycle lock, a program loaded meanwhile can't invalidate them
+	if (plc_get_loader_state() == 0)
+	{
+		LOG_ERR("WriteVariables: no plc program loaded");
+		ret = INVALID_VARIABLE;
+	}
+
+	for (uint32_t i = 0; (ret == 0) && (i < values->elementsCount); i++)
+	{
+		const variable_write *write = &values->elements[i];
+		if ((GetDebugVariable(write->idx, &var_value, &var_size) != 0) || (var_value == NULL))
+		{
+			LOG_ERR("WriteVariables: invalid variable idx %u", write->idx);
+			ret = INVALID_VARIABLE;
+		}
+		else if ((write->value.data == NULL) || (write->value.dataLength == 0) || (write->value.dataLength > var_size))
+		{
+			LOG_ERR("WriteVariables: invalid value for variable idx %u", write->idx);
+			ret = INVALID_FORCE_VALUE;
+		}
+	}
+
+	for (uint32_t i = 0; (ret == 0) && (i < values->elementsCount); i++)
+	{
+		const variable_write *write = &values->elements[i];
+		GetDebugVariable(write->idx, &var_value, &var_size); // checked above, the program can't change under the lock
+		memset(var_value, 0, var_size);
+		memcpy(var_value, write->value.data, write->value.dataLength);
+	}
+
+	unlock_cycle_boundary(locked);
+	return ret;
+}
+#pragma GCC pop_options
+
+/****************************************************************************************************************************************
+ * @brief               check_image_ranges
+ *                      Checks that the ranges lie within the process image.
+ * @param ranges        Ranges of the process image.
+ * @param count         Number of ranges.
+ * @return              0 if all ranges are valid, otherwise INVALID_VARIABLE.
+ ****************************************************************************************************************************************/
+static int check_image_ranges(const struct image_range *ranges, size_t count)
+{
+	static const uint32_t area_size[] = {
+		[IMAGE_IX] = IX_COUNT,
+		[IMAGE_QX] = QX_COUNT,
+		[IMAGE_IW] = IW_COUNT,
+		[IMAGE_QW] = QW_COUNT,
+	};
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if ((ranges[i].area > IMAGE_QW) || (ranges[i].count == 0) || (ranges[i].start >= area_size[ranges[i].area]) ||
+			(ranges[i].count > area_size[ranges[i].area] - ranges[i].start))
+		{
+			LOG_ERR("check_image_ranges: invalid range %u of area %d", ranges[i].start, ranges[i].area);
+			return INVALID_VARIABLE;
+		}
+	}
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief               plc_debug_read_image
+ *                      Copies ranges of the process image at one PLC cycle boundary, so all values belong to the same
+ * 						cycle. The values are packed in the order of the ranges.
+ * @param ranges        Ranges of the process image.
+ * @param count         Number of ranges.
+ * @param values        Receives the values, one element per bit or word.
+ * @param tick          Receives the tick of the snapshot.
+ * @return              0 on success, INVALID_VARIABLE for a range outside the image, TRACE_UPDATE_FAILED if no cycle
+ * 						boundary was reached in time.
+ ****************************************************************************************************************************************/
+int plc_debug_read_image(const struct image_range *ranges, size_t count, uint16_t *values, uint32_t *tick)
+{
+	bool locked = false;
+
+	if (check_image_ranges(ranges, count) != 0)
+		return INVALID_VARIABLE;
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		LOG_ERR("plc_debug_read_image: timeout waiting for cycle boundary");
+		return TRACE_UPDATE_FAILED;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		for (uint32_t n = ranges[i].start; n < ranges[i].start + ranges[i].count; n++)
+		{
+			switch (ranges[i].area)
+			{
+			case IMAGE_IX:
+				*values++ = IX[n];
+				break;
+			case IMAGE_QX:
+				*values++ = QX[n];
+				break;
+			case IMAGE_IW:
+				*values++ = IW[n];
+				break;
+			case IMAGE_QW:
+				*values++ = QW[n];
+				break;
+			}
+		}
+	}
+	*tick = __tick;
+
+	unlock_cycle_boundary(locked);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief               apply_output_writes
+ *                      Called by the PLC task after config_run__, while plc_cycle_start is held. Overwrites the outputs
+ * 						staged by plc_debug_write_image, so the values reach plc_update_outputs of this cycle even if
+ * 						the program drives them.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+void apply_output_writes(void)
+{
+	if (!staged_outputs)
+		return;
+
+	for (size_t n = 0; n < QX_COUNT; n++)
+	{
+		if (staged_qx_set[n])
+			QX[n] = staged_qx[n];
+	}
+	for (size_t n = 0; n < QW_COUNT; n++)
+	{
+		if (staged_qw_set[n])
+			QW[n] = staged_qw[n];
+	}
+	memset(staged_qx_set, 0, sizeof(staged_qx_set));
+	memset(staged_qw_set, 0, sizeof(staged_qw_set));
+	staged_outputs = false;
+	k_sem_give(&output_write_done);
+}
+
+/****************************************************************************************************************************************
+ * @brief               plc_debug_write_image
+ *                      Writes ranges of the outputs for one PLC cycle. The values are staged at a cycle boundary and
+ * 						applied after the next config_run__, so they are set by that cycle's plc_update_outputs. An
+ * 						output driven by the program gets the program's value again in the following cycle, other
+ * 						outputs keep the written value. Inputs are updated by the I/O before every cycle and can't be
+ * 						written. Returns after the outputs were updated, either all or none of the values are written.
+ * @param ranges        Ranges of QX or QW.
+ * @param count         Number of ranges.
+ * @param values        New values in the order of the ranges, bits are set for any value other than 0.
+ * @return              0 on success, INVALID_VARIABLE for a range outside the outputs, DEBUG_SUSPENDED if the PLC isn't
+ * 						running and the outputs are held off, TRACE_UPDATE_FAILED if no cycle applied the values in time,
+ * 						WRITE_UNCONFIRMED if the values could neither be confirmed nor withdrawn, they may still be applied.
+ ****************************************************************************************************************************************/
+int plc_debug_write_image(const struct image_range *ranges, size_t count, const uint16_t *values)
+{
+	bool locked = false;
+	int ret = 0;
+
+	if (check_image_ranges(ranges, count) != 0)
+		return INVALID_VARIABLE;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if ((ranges[i].area != IMAGE_QX) && (ranges[i].area != IMAGE_QW))
+		{
+			LOG_ERR("plc_debug_write_image: area %d is not an output", ranges[i].area);
+			return INVALID_VARIABLE;
+		}
+	}
+
+	k_mutex_lock(&output_write_mutex, K_FOREVER);
+
+	if (lock_cycle_boundary(&locked) != 0)
+	{
+		LOG_ERR("plc_debug_write_image: timeout waiting for cycle boundary");
+		k_mutex_unlock(&output_write_mutex);
+		return TRACE_UPDATE_FAILED;
+	}
+
+	// Without a running cycle plc_update_outputs keeps the outputs off, nothing would be written
+	if (!locked)
+	{
+		LOG_ERR("plc_debug_write_image: plc not running");
+		k_mutex_unlock(&output_write_mutex);
+		return DEBUG_SUSPENDED;
+	}
+
+	for (size_t i = 0; i < count; i++)
+	{
+		for (uint32_t n = ranges[i].start; n < ranges[i].start + ranges[i].count; n++)
+		{
+			if (ranges[i].area == IMAGE_QX)
+			{
+				staged_qx[n] = (*values++ != 0);
+				staged_qx_set[n] = true;
+			}
+			else
+			{
+				staged_qw[n] = *values++;
+				staged_qw_set[n] = true;
+			}
+		}
+	}
+	k_sem_reset(&output_write_done);
+	staged_outputs = true;
+
+	unlock_cycle_boundary(locked);
+
+	if (k_sem_take(&output_write_done, K_MSEC(TRACE_UPDATE_TIMEOUT)) != 0)
+	{
+		// The staged values are only withdrawn at a cycle boundary, otherwise the PLC task may be applying them
+		if (lock_cycle_boundary(&locked) != 0)
+		{
+			LOG_ERR("plc_debug_write_image: outputs neither applied nor withdrawn in time");
+			ret = WRITE_UNCONFIRMED;
+		}
+		else
+		{
+			if (staged_outputs) // not applied by the cycle meanwhile
+			{
+				LOG_ERR("plc_debug_write_image: outputs not applied in time");
+				staged_outputs = false;
+				memset(staged_qx_set, 0, sizeof(staged_qx_set));
+				memset(staged_qw_set, 0, sizeof(staged_qw_set));
+				ret = TRACE_UPDATE_FAILED;
+			}
+			unlock_cycle_boundary(locked);
+		}
+	}
+
+	k_mutex_unlock(&output_write_mutex);
+	return ret;
 }
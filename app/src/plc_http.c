@@ -56,14 +56,20 @@ LOG_MODULE_REGISTER(plc_http, LOG_LEVEL_DBG);
 
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <poll.h>
 #include <fcntl.h>
+#include <errno.h>
 #include <time.h>
 #include <unistd.h>
+#include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <strings.h>
 #include <ctype.h>
 
 #include <zephyr/kernel.h>
+#include <zephyr/fs/fs.h>
 #include <zephyr/logging/log_ctrl.h>
 #include <zephyr/data/json.h>
 #include <mbedtls/sha1.h>
@@ -73,19 +79,47 @@ LOG_MODULE_REGISTER(plc_http, LOG_LEVEL_DBG);
 #include "plc_settings.h"
 #include "plc_util.h"
 #include "plc_http.h"
+#include "plc_debug.h"
+#include "plc_loader.h"
+#include "plc_recorder.h"
+#include "plc_blobstore.h"
+#include "plc_http_cache.h"
+#include "plc_www_bundle.h"
 
 
 #define STATUS_PUBLISH_INTERVAL (1000)			// Time in milliseconds between status updates
 #define SOCKET_TIMEOUT (100 * USEC_PER_MSEC) 	// Socket timeout in microseconds
 
-#define HTTP_RESPONSE_TEMPLATE "HTTP/1.1 200 OK\r\nContent-Type: %s\r\n\r\n"
+#define HTTP_RESPONSE_TEMPLATE "HTTP/1.1 %s\r\nContent-Type: %s\r\nContent-Length: %u\r\n%sConnection: %s\r\n\r\n"
+#define HTTP_NOT_MODIFIED_TEMPLATE "HTTP/1.1 304 Not Modified\r\n%sConnection: %s\r\n\r\n"
+#define HTTP_DATE_FORMAT "%a, %d %b %Y %H:%M:%S GMT"
 
 extern uint32_t plc_initialized;
 extern uint32_t plc_run;
 
-__ccm_noinit_section char receive_buffer[1024];		// Buffer for receiving HTTP requests
-__ccm_noinit_section char temp_buffer[1024];	 	// Copy of the buffer, for parsing
-__ccm_noinit_section char file_buffer[1024]; 		// Buffer for reading files
+// Slot of the connection table, a request is received and its response sent before the next request is parsed
+struct http_connection
+{
+	int fd;								 // -1 if the slot is free
+	int64_t deadline;					 // uptime at which the connection is closed without progress
+	bool keep_alive;					 // connection stays open after the response
+	bool sending;						 // response pending, the socket is polled for POLLOUT
+	bool file_open;						 // response content is read from file
+	bool recorder_locked;				 // flight recorder is locked until the file is sent
+	bool bundled;						 // web bundle is acquired until the file is sent
+	struct fs_file_t file;
+	const uint8_t *body;				 // body sent from memory, NULL if it is read from file
+	const uint8_t *cached;				 // RAM cache slot held until the response is sent
+	size_t body_remaining;				 // body not sent yet, not read yet for files
+	size_t request_len;					 // received bytes in request, may hold pipelined requests
+	size_t out_len;
+	size_t out_pos;						 // sent bytes of out
+	char request[HTTP_REQUEST_BUFFER_SIZE + 1];
+	char out[HTTP_SEND_BUFFER_SIZE];
+};
+
+__ccm_noinit_section struct http_connection http_connections[HTTP_MAX_CONNECTIONS];
+static __ccm_noinit_section char api_body[HTTP_SEND_BUFFER_SIZE]; // API responses are formatted here and copied into the send buffer
 
 // WebSocket opcode definitions
 typedef enum
@@ -107,7 +141,7 @@ k_tid_t websocket_thread; // Thread ID for the WebSocket communication thread
 
 /************************************************************************************************************************************/
 /* HTTP server thread																												*/
-/* This thread handles incoming HTTP requests and upgrades to WebSocket when requested.												*/
+/* This thread serves all HTTP connections from one poll loop and upgrades to WebSocket when requested.							*/
 /************************************************************************************************************************************/
 #define HTTP_SERVER_STACK_SIZE 3072
 #define HTTP_SERVER_PRIORITY 5
@@ -210,65 +244,6 @@ void send_status_update()
 }
 
 
-/**
- * @brief Handles a status request by sending JSON-encoded status information.
- *
- * @param client_fd The file descriptor for the client socket.
- */
-void handle_status_request(int client_fd)
-{
-	struct status_info status = {
-		.plcModuleLoaded = plc_initialized,
-		.plcStarted = plc_run,
-		.ipAddress = get_ip_address(),
-		.rpcServer = false,
-		.modbusServer = false,
-		.modbusClient = false,
-		.canOpen = false,
-	};
-
-	ssize_t needed_buf_len = json_calc_encoded_len(status_info_descr, ARRAY_SIZE(status_info_descr), &status);
-
-	if (needed_buf_len < 0)
-	{
-		LOG_ERR("Error calculating the required JSON length");
-		return;
-	}
-
-	char *json_content = k_malloc((size_t)needed_buf_len + 1);
-	if (!json_content)
-	{
-		LOG_ERR("Failed to allocate memory for json_content");
-		return;
-	}
-
-	int ret = json_obj_encode_buf(status_info_descr, ARRAY_SIZE(status_info_descr), &status, json_content, (size_t)needed_buf_len + 1);
-	if (ret < 0)
-	{
-		const char *error_message = "{\"error\": \"Could not encode JSON\"}";
-		strncpy(json_content, error_message, (size_t)needed_buf_len + 1);
-	}
-
-	int content_length = strlen(json_content);
-
-	int total_length = snprintf(NULL, 0, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %d\r\n\r\n%s", content_length, json_content) + 1;
-
-	char *response = k_malloc(total_length);
-	if (!response)
-	{
-		LOG_ERR("Failed to allocate memory for response");
-		k_free(json_content);
-		return;
-	}
-
-	snprintf(response, total_length, "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %d\r\n\r\n%s", content_length, json_content);
-
-	send(client_fd, response, total_length - 1, 0); 
-
-	k_free(json_content);
-	k_free(response);
-}
-
 /************************************************************************************************************************************/
 /* 													Server part																		*/
 /************************************************************************************************************************************/
@@ -692,173 +667,1162 @@ const char *get_content_type(const char *file_path)
 }
 
 /**
- * @brief Sends a file to a client over a socket.
+ * @brief Entry point for the WebSocket server thread.
+ *
+ * @param client_fd Pointer to the client socket file descriptor.
+ * @param arg2 Unused parameter.
+ * @param arg3 Unused parameter.
+ */
+void plc_websocket_server(void *client_fd, void *arg2, void *arg3)
+{
+
+	int websocket_fd = (int)client_fd;
+	LOG_DBG("WebSocket-Thread started");
+
+	handle_websocket_communication(websocket_fd);
+
+	close(websocket_fd);
+	LOG_DBG("WebSocket thread ended");
+}
+
+/************************************************************************************************************************************/
+/* 													Connection handling																*/
+/************************************************************************************************************************************/
+
+/**
+ * @brief Releases the file, the cache slot and the flight recorder held by a response.
+ *
+ * @param conn The connection of the response.
+ */
+static void http_response_end(struct http_connection *conn)
+{
+	if (conn->file_open)
+	{
+		fs_close(&conn->file);
+		conn->file_open = false;
+	}
+	if (conn->cached)
+	{
+		http_cache_release(conn->cached);
+		conn->cached = NULL;
+	}
+	if (conn->recorder_locked)
+	{
+		flight_recorder_unlock();
+		conn->recorder_locked = false;
+	}
+	if (conn->bundled)
+	{
+		www_bundle_release();
+		conn->bundled = false;
+	}
+	conn->body = NULL;
+	conn->body_remaining = 0;
+	conn->sending = false;
+}
+
+/**
+ * @brief Closes a connection and releases everything held by its response.
+ *
+ * @param conn The connection to close.
+ */
+static void http_connection_close(struct http_connection *conn)
+{
+	http_response_end(conn);
+	close(conn->fd);
+	conn->fd = -1;
+}
+
+/**
+ * @brief Prepares the status line and headers of a response in the send buffer.
+ *
+ * @param conn The connection to respond on.
+ * @param status The status code and reason phrase, e.g. "200 OK".
+ * @param content_type The MIME type of the body.
+ * @param content_length The length of the body that follows the headers.
+ * @param headers Additional header lines, each terminated by CRLF.
+ * @return true if the headers fit into the send buffer, otherwise false.
+ */
+static bool http_response_begin(struct http_connection *conn, const char *status, const char *content_type, size_t content_length,
+								const char *headers)
+{
+	int len = snprintf(conn->out, sizeof(conn->out), HTTP_RESPONSE_TEMPLATE, status, content_type, (unsigned int)content_length,
+					   headers, conn->keep_alive ? "keep-alive" : "close");
+	if (len < 0 || len >= (int)sizeof(conn->out))
+	{
+		return false;
+	}
+	conn->out_len = len;
+	conn->out_pos = 0;
+	conn->sending = true;
+	return true;
+}
+
+/**
+ * @brief Sends an error response with a short html body.
+ *
+ * @param conn The connection to respond on.
+ * @param status The status code and reason phrase, e.g. "404 Not Found".
+ */
+static void http_respond_error(struct http_connection *conn, const char *status)
+{
+	LOG_DBG("http %s", status);
+	size_t body_length = strlen(status) + 9;
+	if (http_response_begin(conn, status, "text/html", body_length, ""))
+	{
+		conn->out_len += snprintf(&conn->out[conn->out_len], sizeof(conn->out) - conn->out_len, "<h1>%s</h1>", status);
+	}
+}
+
+/**
+ * @brief Sends a file. The headers are prepared here, the content is read chunk by chunk while the socket is writable.
  *
- * @param client_fd The file descriptor of the client socket.
+ * @param conn The connection to respond on.
  * @param file_path The path to the file to be sent.
+ * @param content_type The MIME type of the file.
+ * @param headers Additional header lines, each terminated by CRLF.
+ * @return true if the file is sent, false if an error response is sent instead.
  */
-void send_file(int client_fd, const char *file_path)
+static bool http_respond_file(struct http_connection *conn, const char *file_path, const char *content_type, const char *headers)
 {
-	struct stat stat_buf;
+	struct fs_dirent entry;
 
-	if (stat(file_path, &stat_buf) == 0 && S_ISREG(stat_buf.st_mode))
+	if (fs_stat(file_path, &entry) != 0 || entry.type != FS_DIR_ENTRY_FILE)
 	{
-		FILE *file = fopen(file_path, "r");
-		if (file != NULL)
-		{
-			ssize_t nread;
+		LOG_DBG("file %s not found", file_path);
+		http_respond_error(conn, "404 Not Found");
+		return false;
+	}
 
-			const char *content_type = get_content_type(file_path);
+	fs_file_t_init(&conn->file);
+	if (fs_open(&conn->file, file_path, FS_O_READ) != 0)
+	{
+		LOG_DBG("cant send file %s, Internal Server Error", file_path);
+		http_respond_error(conn, "500 Internal Server Error");
+		return false;
+	}
+	conn->file_open = true;
+	conn->body_remaining = entry.size;
 
-			char header[512];
-			snprintf(header, sizeof(header), HTTP_RESPONSE_TEMPLATE, content_type);
-			send(client_fd, header, strlen(header), 0);
+	http_response_begin(conn, "200 OK", content_type, entry.size, headers);
+	LOG_DBG("send file %s with content-type %s", file_path, content_type);
+	return true;
+}
 
-			while ((nread = fread(file_buffer, 1, sizeof(file_buffer), file)) > 0)
-			{
-				send(client_fd, file_buffer, nread, 0);
-			}
+/**
+ * @brief Sends the JSON encoded status information.
+ *
+ * @param conn The connection to respond on.
+ */
+static void http_respond_status(struct http_connection *conn)
+{
+	struct status_info status = {
+		.messageType = "status",
+		.plcModuleLoaded = plc_initialized,
+		.loadSource = plc_loader_get_modulename(),
+		.plcAutostart = get_plc_autostart_setting(),
+		.startSource = plc_loader_get_autostart_source(),
+		.plcStarted = plc_run,
+		.cycleTime = "-",
+		.ipAddress = get_ip_address(),
+		.ipStatus = get_ip_assignment_method(),
+		.rpcServer = false,
+		.modbusServer = false,
+		.modbusClient = false,
+		.canOpen = false,
+	};
+
+	ssize_t needed_buf_len = json_calc_encoded_len(status_info_descr, ARRAY_SIZE(status_info_descr), &status);
+	if (needed_buf_len < 0)
+	{
+		LOG_ERR("Error calculating the required JSON length");
+		http_respond_error(conn, "500 Internal Server Error");
+		return;
+	}
+
+	// the body is encoded straight behind the headers
+	if (!http_response_begin(conn, "200 OK", "application/json", needed_buf_len, "") ||
+		conn->out_len + needed_buf_len + 1 > sizeof(conn->out) ||
+		json_obj_encode_buf(status_info_descr, ARRAY_SIZE(status_info_descr), &status, &conn->out[conn->out_len], needed_buf_len + 1) < 0)
+	{
+		http_respond_error(conn, "500 Internal Server Error");
+		return;
+	}
+	conn->out_len += needed_buf_len;
+}
+
+/**
+ * @brief Decodes percent escapes and '+' of a query or form parameter in place.
+ *
+ * @param s The parameter.
+ */
+static void http_url_decode(char *s)
+{
+	char *out = s;
 
-			fclose(file);
-			LOG_DBG("send file %s with content-type %s", file_path, content_type);
+	for (char *in = s; *in; in++)
+	{
+		if (*in == '%' && isxdigit((unsigned char)in[1]) && isxdigit((unsigned char)in[2]))
+		{
+			char hex[3] = {in[1], in[2], '\0'};
+			*out++ = (char)strtoul(hex, NULL, 16);
+			in += 2;
 		}
 		else
 		{
-			LOG_DBG("cant send file %s, Internal Server Error", file_path);
-			const char *response = "HTTP/1.1 500 Internal Server Error\r\nContent-Type: "
-								   "text/html\r\n\r\n<h1>500 Internal Server Error</h1>";
-			send(client_fd, response, strlen(response), 0);
+			*out++ = (*in == '+') ? ' ' : *in;
 		}
 	}
+	*out = '\0';
+}
+
+/**
+ * @brief Splits the next name=value pair off a query or form body and decodes both in place.
+ *
+ * @param cursor The remaining parameters, advanced behind the pair.
+ * @param value Receives the value, an empty string if the pair has no '='.
+ * @return The name, or NULL if no parameters are left.
+ */
+static char *http_param_next(char **cursor, char **value)
+{
+	char *name;
+
+	do
+	{
+		name = strsep(cursor, "&");
+	} while (name && name[0] == '\0');
+	if (!name)
+	{
+		return NULL;
+	}
+
+	*value = strchr(name, '=');
+	if (*value)
+	{
+		*(*value)++ = '\0';
+	}
 	else
 	{
-		LOG_DBG("file %s not found", file_path);
-		const char *response = "HTTP/1.1 404 Not Found\r\nContent-Type: "
-							   "text/html\r\n\r\n<h1>404 Not Found</h1>";
-		send(client_fd, response, strlen(response), 0);
+		*value = &name[strlen(name)];
 	}
+	http_url_decode(name);
+	http_url_decode(*value);
+	return name;
 }
 
 /**
- * @brief Entry point for the WebSocket server thread.
+ * @brief Parses an unsigned number that ends with one of the given characters or the end of the string.
  *
- * @param client_fd Pointer to the client socket file descriptor.
- * @param arg2 Unused parameter.
- * @param arg3 Unused parameter.
+ * @param s The number, advanced behind it.
+ * @param end Characters allowed behind the number.
+ * @param number Receives the number.
+ * @return true if a number was found.
  */
-void plc_websocket_server(void *client_fd, void *arg2, void *arg3)
+static bool http_param_number(char **s, const char *end, unsigned long *number)
 {
+	char *next;
 
-	int websocket_fd = (int)client_fd;
-	LOG_DBG("WebSocket-Thread started");
+	if (!isdigit((unsigned char)**s))
+	{
+		return false;
+	}
+	*number = strtoul(*s, &next, 10);
+	if (*next != '\0' && !strchr(end, *next))
+	{
+		return false;
+	}
+	*s = next;
+	return true;
+}
 
-	handle_websocket_communication(websocket_fd);
+/**
+ * @brief Appends formatted text to the body of an API response.
+ *
+ * @param body The body buffer.
+ * @param size The size of the body buffer.
+ * @param len The length of the body, set beyond size if the text doesn't fit.
+ */
+static void http_body_printf(char *body, size_t size, size_t *len, const char *fmt, ...)
+{
+	va_list args;
 
-	close(websocket_fd);
-	LOG_DBG("WebSocket thread ended");
+	if (*len >= size)
+	{
+		return;
+	}
+	va_start(args, fmt);
+	*len += vsnprintf(&body[*len], size - *len, fmt, args);
+	va_end(args);
 }
 
 /**
- * Processes HTTP requests on a client socket. Handles WebSocket upgrades,
- * serves static files, and returns appropriate HTTP responses. Prevents
- * directory traversal and closes the client socket after serving the request.
+ * @brief Sends a JSON body. API responses are never cached by the client.
  *
- * @param client_fd Client socket file descriptor.
+ * @param conn The connection to respond on.
+ * @param body The body.
+ * @param len The length of the body.
  */
-void process_request(int client_fd)
+static void http_respond_json(struct http_connection *conn, const char *body, size_t len)
 {
-	int bytes_received = recv(client_fd, receive_buffer, sizeof(receive_buffer), 0);
-	if (bytes_received > 0)
+	if (!http_response_begin(conn, "200 OK", "application/json", len, "Cache-Control: no-store\r\n") ||
+		conn->out_len + len > sizeof(conn->out))
 	{
-		strncpy(temp_buffer, receive_buffer, sizeof(temp_buffer));
-		temp_buffer[sizeof(temp_buffer) - 1] = '\0';
+		LOG_ERR("http api response of %u bytes doesn't fit", (unsigned int)len);
+		http_respond_error(conn, "413 Content Too Large");
+		return;
+	}
+	memcpy(&conn->out[conn->out_len], body, len);
+	conn->out_len += len;
+}
+
+/**
+ * @brief Sends the error response for a failed access to the PLC data.
+ *
+ * @param conn The connection to respond on.
+ * @param ret The error code of plc_debug.
+ */
+static void http_respond_plc_error(struct http_connection *conn, int ret)
+{
+	if (ret == TRACE_UPDATE_FAILED)
+		http_respond_error(conn, "503 Service Unavailable");
+	else if (ret == DEBUG_SUSPENDED)
+		http_respond_error(conn, "409 Conflict");
+	else if (ret == WRITE_UNCONFIRMED)
+		http_respond_error(conn, "504 Gateway Timeout");
+	else
+		http_respond_error(conn, "400 Bad Request");
+}
 
-		char *method = strtok(temp_buffer, " ");
-		char *uri = strtok(NULL, " ");
+/**
+ * @brief Reads or writes ranges of the process image at one PLC cycle boundary.
+ * GET /api/io?IX=0:16&QW=4 answers {"tick":n,"IX":[...],"QW":[...]} with count values from start, count defaults to 1.
+ * POST /api/io with the form body QX=0:1,0,1&QW=4:100 writes the values from start, only QX and QW can be written.
+ * The written values are set by the next PLC cycle, outputs driven by the program get its value again one cycle later.
+ * The answer is sent when the outputs were updated, 409 Conflict if the PLC isn't running, 503 Service Unavailable if
+ * nothing was written and 504 Gateway Timeout if the write could not be confirmed, the outputs may still change.
+ *
+ * @param conn The connection to respond on.
+ * @param post true to write the ranges.
+ * @param params The query of a read or the body of a write.
+ */
+static void http_api_io(struct http_connection *conn, bool post, char *params)
+{
+	static const char *const area_names[] = {
+		[IMAGE_IX] = "IX",
+		[IMAGE_QX] = "QX",
+		[IMAGE_IW] = "IW",
+		[IMAGE_QW] = "QW",
+	};
+	static __ccm_noinit_section uint16_t values[HTTP_API_MAX_VALUES];
+	struct image_range ranges[HTTP_API_MAX_RANGES];
+	size_t range_count = 0;
+	size_t value_count = 0;
+	unsigned long number;
+	uint32_t tick;
+	char *name;
+	char *value;
+	int area;
+	int ret;
+
+	while ((name = http_param_next(&params, &value)) != NULL)
+	{
+		for (area = IMAGE_QW; area >= IMAGE_IX; area--)
+		{
+			if (strcmp(name, area_names[area]) == 0)
+			{
+				break;
+			}
+		}
+		if (area < IMAGE_IX || range_count == HTTP_API_MAX_RANGES || !http_param_number(&value, ":", &number))
+		{
+			http_respond_error(conn, "400 Bad Request");
+			return;
+		}
+		struct image_range *range = &ranges[range_count++];
+		range->area = area;
+		range->start = number;
+		range->count = 0;
 
-		if (method && uri && strcmp(method, "GET") == 0)
+		if (post)
 		{
-			if (strcmp(uri, "/ws") == 0)
+			// start:value,value,...
+			if (area == IMAGE_IX || area == IMAGE_IW)
 			{
-				if (is_websocket_upgrade_request(receive_buffer))
-				{
-					const char *websocket_key = extract_websocket_key(receive_buffer);
-					if (websocket_key)
-					{
-						process_websocket_handshake(client_fd, websocket_key);
-						websocket_thread = k_thread_create(&plc_websocket_server_data, websocket_thread_stack_, K_THREAD_STACK_SIZEOF(websocket_thread_stack_),
-														   plc_websocket_server, (void *)client_fd, NULL, NULL, WEBSOCKET_SERVER_PRIORITY, 0, K_NO_WAIT);
-						k_thread_name_set(websocket_thread, "websocket_thread");
-						return;
-					}
-				}
+				http_respond_error(conn, "403 Forbidden");
+				return;
+			}
+			if (*value++ != ':')
+			{
+				http_respond_error(conn, "400 Bad Request");
+				return;
 			}
-			else
+			do
 			{
-				char file_path[32] = HTTP_ROOT;
-				if (strstr(uri, "..") != 0)
+				if (value_count == HTTP_API_MAX_VALUES || !http_param_number(&value, ",", &number) || number > UINT16_MAX)
 				{
-					const char *response = "HTTP/1.1 400 Bad Request\r\nContent-Type: "
-										   "text/html\r\n\r\n<h1>Bad Request</h1>";
-					send(client_fd, response, strlen(response), 0);
-					close(client_fd);
+					http_respond_error(conn, "400 Bad Request");
 					return;
 				}
-				if (strcmp(uri, "/") == 0)
-				{
-					strcat(file_path, "index.html");
-				}
-				else if (strcmp(uri, "status") == 0) 
+				values[value_count++] = number;
+				range->count++;
+			} while (*value++ == ',');
+		}
+		else
+		{
+			// start or start:count, every area once so the areas are the keys of the reply
+			range->count = 1;
+			if (*value == ':')
+			{
+				value++;
+				if (!http_param_number(&value, "", &number) || number == 0)
 				{
-					LOG_DBG("http status request");
-					handle_status_request(client_fd);
-					close(client_fd);
+					http_respond_error(conn, "400 Bad Request");
 					return;
 				}
-				else
+				range->count = MIN(number, HTTP_API_MAX_VALUES + 1);
+			}
+			for (size_t i = 0; i + 1 < range_count; i++)
+			{
+				if (ranges[i].area == range->area)
 				{
-					strcat(file_path, uri);
+					http_respond_error(conn, "400 Bad Request");
+					return;
 				}
-				send_file(client_fd, file_path);
-				close(client_fd);
+			}
+			value_count += range->count;
+			if (value_count > HTTP_API_MAX_VALUES)
+			{
+				http_respond_error(conn, "413 Content Too Large");
 				return;
 			}
 		}
 	}
+	if (range_count == 0)
+	{
+		http_respond_error(conn, "400 Bad Request");
+		return;
+	}
 
-	LOG_DBG("http 400 bad request");
-	const char *response = "HTTP/1.1 400 Bad Request\r\nContent-Type: "
-						   "text/html\r\n\r\n<h1>Bad Request</h1>";
-	send(client_fd, response, strlen(response), 0);
+	size_t len = 0;
+	if (post)
+	{
+		ret = plc_debug_write_image(ranges, range_count, values);
+		if (ret != 0)
+		{
+			http_respond_plc_error(conn, ret);
+			return;
+		}
+		http_body_printf(api_body, sizeof(api_body), &len, "{\"written\":%u}", (unsigned int)value_count);
+	}
+	else
+	{
+		ret = plc_debug_read_image(ranges, range_count, values, &tick);
+		if (ret != 0)
+		{
+			http_respond_plc_error(conn, ret);
+			return;
+		}
+		http_body_printf(api_body, sizeof(api_body), &len, "{\"tick\":%u", tick);
+		value_count = 0;
+		for (size_t i = 0; i < range_count; i++)
+		{
+			http_body_printf(api_body, sizeof(api_body), &len, ",\"%s\":[", area_names[ranges[i].area]);
+			for (uint32_t n = 0; n < ranges[i].count; n++)
+			{
+				http_body_printf(api_body, sizeof(api_body), &len, n == 0 ? "%u" : ",%u", values[value_count++]);
+			}
+			http_body_printf(api_body, sizeof(api_body), &len, "]");
+		}
+		http_body_printf(api_body, sizeof(api_body), &len, "}");
+	}
+	http_respond_json(conn, api_body, len);
 }
 
 /**
- * @brief Initializes and runs the HTTP server.
- *
- * This function creates a server socket bound to HTTP_SERVER_PORT and listens
- * for incoming connections. For each connection, it accepts the client socket
- * and processes the request through process_request(). The server runs indefinitely
- * until an error occurs or the system shuts it down.
+ * @brief Reads or writes variables by their debug index at one PLC cycle boundary.
+ * GET /api/vars?idx=3,5,7 answers {"tick":n,"values":["01","2a000000",...]} with the values in the order of the indexes,
+ * each as hex string of its bytes in memory order. POST /api/vars with the form body 3=01&5=2a000000 writes the values,
+ * shorter values are zero padded to the size of the variable.
  *
- * @param arg1 Unused parameter.
- * @param arg2 Unused parameter.
- * @param arg3 Unused parameter.
+ * @param conn The connection to respond on.
+ * @param post true to write the variables.
+ * @param params The query of a read or the body of a write.
  */
-void plc_http_server(void *, void *, void *)
+static void http_api_vars(struct http_connection *conn, bool post, char *params)
 {
-	int server_fd, client_fd;
-	struct sockaddr_in server_addr, client_addr;
-	socklen_t client_addr_len = sizeof(client_addr);
-
-	server_fd = socket(AF_INET, SOCK_STREAM, 0);
-	if (server_fd < 0)
+	static __ccm_noinit_section uint8_t data[RW_VALUES_MAX_SIZE];
+	uint32_t idxs[RW_VARS_MAX_COUNT];
+	variable_write writes[RW_VARS_MAX_COUNT];
+	uint32_t count = 0;
+	size_t data_len = 0;
+	unsigned long number;
+	char *name;
+	char *value;
+	int ret;
+
+	while ((name = http_param_next(&params, &value)) != NULL)
 	{
-		return;
-	}
-
-	memset(&server_addr, 0, sizeof(server_addr));
-	server_addr.sin_family = AF_INET;
-	server_addr.sin_addr.s_addr = INADDR_ANY;
+		if (post)
+		{
+			// idx=hex
+			size_t hex_len = strlen(value);
+			if (count == RW_VARS_MAX_COUNT || !http_param_number(&name, "", &number) || hex_len == 0 || hex_len % 2 != 0 ||
+				hex_len / 2 > sizeof(data) - data_len || hex2bin(value, hex_len, &data[data_len], hex_len / 2) != hex_len / 2)
+			{
+				http_respond_error(conn, "400 Bad Request");
+				return;
+			}
+			writes[count].idx = number;
+			writes[count].value.data = &data[data_len];
+			writes[count].value.dataLength = hex_len / 2;
+			data_len += hex_len / 2;
+			count++;
+		}
+		else if (strcmp(name, "idx") == 0)
+		{
+			// idx=index,index,...
+			do
+			{
+				if (count == RW_VARS_MAX_COUNT || !http_param_number(&value, ",", &number))
+				{
+					http_respond_error(conn, "400 Bad Request");
+					return;
+				}
+				idxs[count++] = number;
+			} while (*value++ == ',');
+		}
+		else
+		{
+			http_respond_error(conn, "400 Bad Request");
+			return;
+		}
+	}
+	if (count == 0)
+	{
+		http_respond_error(conn, "400 Bad Request");
+		return;
+	}
+
+	size_t len = 0;
+	if (post)
+	{
+		list_variable_write_1_t list = {.elements = writes, .elementsCount = count};
+		ret = (int)WriteVariables(&list);
+		if (ret != 0)
+		{
+			http_respond_plc_error(conn, ret);
+			return;
+		}
+		http_body_printf(api_body, sizeof(api_body), &len, "{\"written\":%u}", count);
+		http_respond_json(conn, api_body, len);
+		return;
+	}
+
+	list_uint32_1_t list = {.elements = idxs, .elementsCount = count};
+	variable_snapshot snapshot;
+	ret = (int)ReadVariables(&list, &snapshot);
+	if (ret != 0)
+	{
+		http_respond_plc_error(conn, ret);
+		return;
+	}
+
+	// the values are packed, split them by the sizes read at the same cycle boundary
+	size_t offset = 0;
+	http_body_printf(api_body, sizeof(api_body), &len, "{\"tick\":%u,\"values\":[", snapshot.tick);
+	for (uint32_t i = 0; i < snapshot.sizes.elementsCount; i++)
+	{
+		size_t var_size = snapshot.sizes.elements[i];
+		http_body_printf(api_body, sizeof(api_body), &len, i == 0 ? "\"" : ",\"");
+		if (len + 2 * var_size < sizeof(api_body))
+		{
+			len += bin2hex(&snapshot.values.data[offset], var_size, &api_body[len], sizeof(api_body) - len);
+		}
+		else
+		{
+			len = sizeof(api_body);
+		}
+		http_body_printf(api_body, sizeof(api_body), &len, "\"");
+		offset += var_size;
+	}
+	http_body_printf(api_body, sizeof(api_body), &len, "]}");
+	k_free(snapshot.values.data);
+	k_free(snapshot.sizes.elements);
+	http_respond_json(conn, api_body, len);
+}
+
+/**
+ * @brief Handles the JSON API for the process image and the PLC variables, e.g. for a SCADA gateway polling once per
+ * cycle. All values of a request are read or written at the same PLC cycle boundary.
+ *
+ * @param conn The connection to respond on.
+ * @param name The route below /api/.
+ * @param post true for POST, the parameters are the form body, otherwise GET with the parameters in the query.
+ * @param params The parameters, modified while they are parsed.
+ */
+static void http_api_request(struct http_connection *conn, const char *name, bool post, char *params)
+{
+	LOG_DBG("http api %s %s", post ? "POST" : "GET", name);
+	if (strcmp(name, "io") == 0)
+	{
+		http_api_io(conn, post, params);
+	}
+	else if (strcmp(name, "vars") == 0)
+	{
+		http_api_vars(conn, post, params);
+	}
+	else
+	{
+		http_respond_error(conn, "404 Not Found");
+	}
+}
+
+/**
+ * @brief Looks up a header field of a request.
+ *
+ * @param request The request, NUL terminated after the header block.
+ * @param name The name of the header field.
+ * @param length Receives the length of the value.
+ * @return The value of the field, or NULL if the request has no such field.
+ */
+static const char *http_header_value(const char *request, const char *name, size_t *length)
+{
+	size_t name_length = strlen(name);
+
+	for (const char *line = strstr(request, "\r\n"); line; line = strstr(line, "\r\n"))
+	{
+		line += 2;
+		if (strncasecmp(line, name, name_length) == 0 && line[name_length] == ':')
+		{
+			const char *value = &line[name_length + 1];
+			while (*value == ' ' || *value == '\t')
+			{
+				value++;
+			}
+			const char *end = strstr(value, "\r\n");
+			*length = end ? (size_t)(end - value) : strlen(value);
+			return value;
+		}
+	}
+	return NULL;
+}
+
+/**
+ * @brief Checks if a header field of a request contains a token, e.g. an encoding or an entity tag.
+ *
+ * @param request The request, NUL terminated after the header block.
+ * @param name The name of the header field.
+ * @param token The token to search for, compared case insensitive.
+ * @return true if the field is present and contains the token.
+ */
+static bool http_header_contains(const char *request, const char *name, const char *token)
+{
+	size_t length;
+	size_t token_length = strlen(token);
+	const char *value = http_header_value(request, name, &length);
+
+	for (size_t i = 0; value && i + token_length <= length; i++)
+	{
+		if (strncasecmp(&value[i], token, token_length) == 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * @brief Sends a web file. The file is sent from the web bundle in flash if it is bundled, otherwise from HTTP_ROOT.
+ * A precompressed .gz variant is sent if the client accepts gzip. Bundled files and files installed by NewPLC get their
+ * md5 as ETag and their install time as Last-Modified, the browser revalidates them with a conditional GET that is
+ * answered with 304 Not Modified while the file is unchanged. Small files from HTTP_ROOT are sent from the RAM cache.
+ *
+ * @param conn The connection to respond on.
+ * @param request The request, NUL terminated after the header block.
+ * @param name The path of the file relative to HTTP_ROOT.
+ */
+static void http_respond_asset(struct http_connection *conn, const char *request, const char *name)
+{
+	const char *content_type = get_content_type(name);
+	bool accept_gzip = http_header_contains(request, "Accept-Encoding", "gzip");
+	const struct www_bundle_entry *bundled = NULL;
+	char path[sizeof(HTTP_ROOT) + HTTP_URI_MAX_LENGTH + 3];
+	char headers[192];
+	char etag[2 * sizeof(((struct blob_info *)0)->id) + 3];
+	char last_modified[32] = "";
+	struct fs_dirent entry;
+	struct blob_info info;
+	bool gzip = false;
+	int len;
+
+	if (www_bundle_acquire())
+	{
+		if (accept_gzip)
+		{
+			snprintf(path, sizeof(path), "%s.gz", name);
+			bundled = www_bundle_find(path);
+			gzip = (bundled != NULL);
+		}
+		if (!bundled)
+		{
+			bundled = www_bundle_find(name);
+		}
+		if (bundled)
+		{
+			conn->bundled = true; // released with the response
+			memcpy(info.id, bundled->id, sizeof(info.id));
+			info.size = bundled->size;
+			info.installed = bundled->installed;
+		}
+		else
+		{
+			www_bundle_release();
+		}
+	}
+
+	len = snprintf(headers, sizeof(headers), "Vary: Accept-Encoding\r\n");
+	if (!bundled)
+	{
+		if (accept_gzip)
+		{
+			snprintf(path, sizeof(path), "%s%s.gz", HTTP_ROOT, name);
+			gzip = (fs_stat(path, &entry) == 0) && (entry.type == FS_DIR_ENTRY_FILE);
+		}
+		if (!gzip)
+		{
+			snprintf(path, sizeof(path), "%s%s", HTTP_ROOT, name);
+		}
+
+		if (!blob_store_stat(path, &info)) // not installed by NewPLC, sent without validators
+		{
+			if (gzip)
+			{
+				strcat(headers, "Content-Encoding: gzip\r\n");
+			}
+			http_respond_file(conn, path, content_type, headers);
+			return;
+		}
+	}
+
+	etag[0] = '"';
+	bin2hex(info.id, sizeof(info.id), &etag[1], sizeof(etag) - 2);
+	strcat(etag, "\"");
+	len += snprintf(&headers[len], sizeof(headers) - len, "ETag: %s\r\nCache-Control: no-cache\r\n", etag);
+	if (info.installed != 0)
+	{
+		struct tm tm;
+		time_t installed = info.installed;
+		gmtime_r(&installed, &tm);
+		strftime(last_modified, sizeof(last_modified), HTTP_DATE_FORMAT, &tm);
+		len += snprintf(&headers[len], sizeof(headers) - len, "Last-Modified: %s\r\n", last_modified);
+	}
+
+	// If-None-Match takes precedence, the browser sends back the Last-Modified value unchanged for If-Modified-Since
+	size_t length;
+	const char *since = http_header_value(request, "If-Modified-Since", &length);
+	if (http_header_value(request, "If-None-Match", &length) ? http_header_contains(request, "If-None-Match", etag)
+															  : (since && last_modified[0] && strncmp(since, last_modified, strlen(last_modified)) == 0))
+	{
+		LOG_DBG("http %s not modified", name);
+		len = snprintf(conn->out, sizeof(conn->out), HTTP_NOT_MODIFIED_TEMPLATE, headers, conn->keep_alive ? "keep-alive" : "close");
+		conn->out_len = MIN(len, sizeof(conn->out));
+		conn->out_pos = 0;
+		conn->sending = true;
+		return;
+	}
+
+	if (gzip)
+	{
+		snprintf(&headers[len], sizeof(headers) - len, "Content-Encoding: gzip\r\n");
+	}
+
+	const uint8_t *data;
+	if (bundled)
+	{
+		data = www_bundle_data(bundled); // sent straight from flash
+	}
+	else
+	{
+		data = http_cache_acquire(path, &info);
+		conn->cached = data;
+	}
+	if (data)
+	{
+		conn->body = data;
+		conn->body_remaining = info.size;
+		http_response_begin(conn, "200 OK", content_type, info.size, headers);
+		return;
+	}
+	http_respond_file(conn, path, content_type, headers);
+}
+
+/**
+ * @brief Hands a connection over to the WebSocket thread after the handshake. Only one WebSocket client is served.
+ *
+ * @param conn The connection of the upgrade request.
+ * @param request The upgrade request.
+ */
+static void http_upgrade_websocket(struct http_connection *conn, const char *request)
+{
+	const char *websocket_key = extract_websocket_key(request);
+	if (!is_websocket_upgrade_request(request) || !websocket_key)
+	{
+		http_respond_error(conn, "400 Bad Request");
+		return;
+	}
+	if (websocket_connected)
+	{
+		http_respond_error(conn, "503 Service Unavailable");
+		return;
+	}
+
+	// the websocket thread owns the socket from now on
+	int flags = fcntl(conn->fd, F_GETFL, 0);
+	fcntl(conn->fd, F_SETFL, flags & ~O_NONBLOCK);
+	process_websocket_handshake(conn->fd, websocket_key);
+
+	websocket_connected = true;
+	websocket_thread = k_thread_create(&plc_websocket_server_data, websocket_thread_stack_, K_THREAD_STACK_SIZEOF(websocket_thread_stack_),
+									   plc_websocket_server, (void *)conn->fd, NULL, NULL, WEBSOCKET_SERVER_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(websocket_thread, "websocket_thread");
+	conn->fd = -1;
+}
+
+/**
+ * @brief Handles a complete request and prepares the response. Prevents directory traversal.
+ *
+ * @param conn The connection the request was received on.
+ * @param request The request, NUL terminated after the header block.
+ * @param body The body of the request, NUL terminated.
+ */
+static void http_handle_request(struct http_connection *conn, char *request, char *body)
+{
+	char request_line[HTTP_URI_MAX_LENGTH + 24];
+	char *save;
+	size_t length;
+
+	// the request line is split in a copy, the header fields are looked up in the request
+	length = strcspn(request, "\r");
+	if (length >= sizeof(request_line))
+	{
+		conn->keep_alive = false;
+		http_respond_error(conn, "414 URI Too Long");
+		return;
+	}
+	memcpy(request_line, request, length);
+	request_line[length] = '\0';
+
+	char *method = strtok_r(request_line, " ", &save);
+	char *uri = strtok_r(NULL, " ", &save);
+	char *version = strtok_r(NULL, " ", &save);
+	if (!method || !uri || !version || strncmp(version, "HTTP/1.", 7) != 0)
+	{
+		conn->keep_alive = false;
+		http_respond_error(conn, "400 Bad Request");
+		return;
+	}
+	if (strlen(uri) >= HTTP_URI_MAX_LENGTH)
+	{
+		http_respond_error(conn, "414 URI Too Long");
+		return;
+	}
+
+	// HTTP/1.1 keeps the connection open unless the client closes it, HTTP/1.0 only on request
+	const char *connection = http_header_value(request, "Connection", &length);
+	if (connection && length >= 5 && strncasecmp(connection, "close", 5) == 0)
+	{
+		conn->keep_alive = false;
+	}
+	else if (connection && strncasecmp(connection, "keep-alive", 10) == 0)
+	{
+		conn->keep_alive = true;
+	}
+	else
+	{
+		conn->keep_alive = strcmp(version, "HTTP/1.1") == 0;
+	}
+
+	// POST is only used to write through the API
+	bool post = strcmp(method, "POST") == 0;
+	if (!post && strcmp(method, "GET") != 0)
+	{
+		http_respond_error(conn, "405 Method Not Allowed");
+		return;
+	}
+
+	char *query = strchr(uri, '?');
+	if (query)
+	{
+		*query++ = '\0';
+	}
+	else
+	{
+		query = &uri[strlen(uri)];
+	}
+
+	if (strncmp(uri, "/api/", 5) == 0)
+	{
+		http_api_request(conn, &uri[5], post, post ? body : query);
+	}
+	else if (post)
+	{
+		http_respond_error(conn, "405 Method Not Allowed");
+	}
+	else if (strcmp(uri, "/ws") == 0)
+	{
+		http_upgrade_websocket(conn, request);
+	}
+	else if (strcmp(uri, "/status") == 0)
+	{
+		LOG_DBG("http status request");
+		http_respond_status(conn);
+	}
+	else if (uri[0] != '/' || strstr(uri, "..") != 0)
+	{
+		http_respond_error(conn, "400 Bad Request");
+	}
+	else if (strcmp(uri, "/trace.rec") == 0)
+	{
+		LOG_DBG("http flight recorder download");
+		flight_recorder_lock(); // Pending samples are written and the file doesn't change while it is sent
+		conn->recorder_locked = http_respond_file(conn, FLIGHT_RECORDER_FILE, get_content_type(FLIGHT_RECORDER_FILE), "");
+		if (!conn->recorder_locked)
+		{
+			flight_recorder_unlock();
+		}
+	}
+	else
+	{
+		http_respond_asset(conn, request, strcmp(uri, "/") == 0 ? "index.html" : &uri[1]);
+	}
+}
+
+/**
+ * @brief Handles the complete requests in the receive buffer, one after the other as long as no response is pending.
+ * Pipelined requests wait in the buffer until the response to the previous one is sent.
+ *
+ * @param conn The connection to process.
+ */
+static void http_connection_process(struct http_connection *conn)
+{
+	while (conn->fd >= 0 && !conn->sending && conn->request_len > 0)
+	{
+		conn->request[conn->request_len] = '\0';
+		char *end = strstr(conn->request, "\r\n\r\n");
+		if (!end)
+		{
+			if (conn->request_len == HTTP_REQUEST_BUFFER_SIZE)
+			{
+				conn->keep_alive = false;
+				conn->request_len = 0;
+				http_respond_error(conn, "431 Request Header Fields Too Large");
+			}
+			return; // wait for the rest of the header
+		}
+
+		size_t header_length = end + 4 - conn->request;
+		end[2] = '\0';
+
+		// the body is only used by POST requests to the API
+		size_t body_length = 0;
+		size_t length;
+		const char *content_length = http_header_value(conn->request, "Content-Length", &length);
+		if (content_length)
+		{
+			body_length = strtoul(content_length, NULL, 10);
+		}
+		if (header_length + body_length > HTTP_REQUEST_BUFFER_SIZE)
+		{
+			conn->keep_alive = false;
+			conn->request_len = 0;
+			http_respond_error(conn, "413 Content Too Large");
+			return;
+		}
+		if (conn->request_len < header_length + body_length)
+		{
+			end[2] = '\r';
+			return; // wait for the rest of the body
+		}
+
+		// the body is terminated in place, the byte behind it belongs to the next pipelined request
+		char *body = &conn->request[header_length];
+		char next = body[body_length];
+		body[body_length] = '\0';
+		http_handle_request(conn, conn->request, body);
+		body[body_length] = next;
+
+		conn->request_len -= header_length + body_length;
+		memmove(conn->request, &conn->request[header_length + body_length], conn->request_len);
+	}
+}
+
+/**
+ * @brief Reads from a readable connection and handles the requests received.
+ *
+ * @param conn The connection to read from.
+ */
+static void http_connection_receive(struct http_connection *conn)
+{
+	ssize_t received = recv(conn->fd, &conn->request[conn->request_len], HTTP_REQUEST_BUFFER_SIZE - conn->request_len, 0);
+	if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+	{
+		return;
+	}
+	if (received <= 0)
+	{
+		http_connection_close(conn); // closed by the client or reset
+		return;
+	}
+
+	conn->request_len += received;
+	conn->deadline = k_uptime_get() + HTTP_CONNECTION_TIMEOUT;
+	http_connection_process(conn);
+}
+
+/**
+ * @brief Continues the pending response on a writable connection. File content is read as soon as the send buffer
+ * is empty. A finished response closes the connection or continues with the next pipelined request.
+ *
+ * @param conn The connection to send on.
+ */
+static void http_connection_send(struct http_connection *conn)
+{
+	const void *data;
+	size_t length;
+
+	if (conn->out_pos == conn->out_len && conn->body_remaining > 0 && conn->file_open)
+	{
+		ssize_t nread = fs_read(&conn->file, conn->out, MIN(sizeof(conn->out), conn->body_remaining));
+		if (nread <= 0)
+		{
+			LOG_ERR("http error reading file: %d", (int)nread);
+			http_connection_close(conn); // headers are sent already, the client sees a short response
+			return;
+		}
+		conn->out_len = nread;
+		conn->out_pos = 0;
+		conn->body_remaining -= nread;
+	}
+
+	if (conn->out_pos < conn->out_len)
+	{
+		data = &conn->out[conn->out_pos];
+		length = conn->out_len - conn->out_pos;
+	}
+	else
+	{
+		data = conn->body; // body in memory is sent without copy
+		length = conn->body_remaining;
+	}
+
+	ssize_t sent = send(conn->fd, data, length, 0);
+	if (sent < 0)
+	{
+		if (errno != EAGAIN && errno != EWOULDBLOCK)
+		{
+			http_connection_close(conn);
+		}
+		return;
+	}
+	if (conn->out_pos < conn->out_len)
+	{
+		conn->out_pos += sent;
+	}
+	else
+	{
+		conn->body += sent;
+		conn->body_remaining -= sent;
+	}
+	conn->deadline = k_uptime_get() + HTTP_CONNECTION_TIMEOUT;
+
+	if (conn->out_pos < conn->out_len || conn->body_remaining > 0)
+	{
+		return;
+	}
+
+	http_response_end(conn);
+	if (!conn->keep_alive)
+	{
+		http_connection_close(conn);
+		return;
+	}
+	http_connection_process(conn);
+}
+
+/**
+ * @brief Accepts a new connection into a free slot of the connection table.
+ *
+ * @param server_fd The listening socket.
+ */
+static void http_connection_accept(int server_fd)
+{
+	struct sockaddr_in client_addr;
+	socklen_t client_addr_len = sizeof(client_addr);
+
+	int client_fd = accept(server_fd, (struct sockaddr *)&client_addr, &client_addr_len);
+	if (client_fd < 0)
+	{
+		return;
+	}
+
+	for (int i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+	{
+		struct http_connection *conn = &http_connections[i];
+		if (conn->fd < 0)
+		{
+			int flags = fcntl(client_fd, F_GETFL, 0);
+			fcntl(client_fd, F_SETFL, flags | O_NONBLOCK);
+
+			conn->fd = client_fd;
+			conn->deadline = k_uptime_get() + HTTP_CONNECTION_TIMEOUT;
+			conn->keep_alive = false;
+			conn->sending = false;
+			conn->file_open = false;
+			conn->recorder_locked = false;
+			conn->bundled = false;
+			conn->body = NULL;
+			conn->cached = NULL;
+			conn->body_remaining = 0;
+			conn->request_len = 0;
+			conn->out_len = 0;
+			conn->out_pos = 0;
+			return;
+		}
+	}
+	close(client_fd); // listen socket is only polled while a slot is free
+}
+
+/**
+ * @brief Initializes and runs the HTTP server.
+ *
+ * This function creates a server socket bound to HTTP_SERVER_PORT and serves up to HTTP_MAX_CONNECTIONS clients
+ * from one poll() loop. Connections are kept alive between requests and closed after HTTP_CONNECTION_TIMEOUT
+ * without progress, so a slow client doesn't stall the others.
+ *
+ * @param arg1 Unused parameter.
+ * @param arg2 Unused parameter.
+ * @param arg3 Unused parameter.
+ */
+void plc_http_server(void *, void *, void *)
+{
+	int server_fd;
+	struct sockaddr_in server_addr;
+	struct pollfd fds[HTTP_MAX_CONNECTIONS + 1];
+
+	for (int i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+	{
+		http_connections[i].fd = -1;
+	}
+
+	server_fd = socket(AF_INET, SOCK_STREAM, 0);
+	if (server_fd < 0)
+	{
+		return;
+	}
+
+	memset(&server_addr, 0, sizeof(server_addr));
+	server_addr.sin_family = AF_INET;
+	server_addr.sin_addr.s_addr = INADDR_ANY;
 	server_addr.sin_port = htons(HTTP_SERVER_PORT);
 
 	if (bind(server_fd, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
@@ -876,10 +1840,69 @@ void plc_http_server(void *, void *, void *)
 	LOG_INF("HTTP-Server listen on Port %d", HTTP_SERVER_PORT);
 	while (true)
 	{
-		client_fd = accept(server_fd, (struct sockaddr *)&client_addr, &client_addr_len);
-		if (client_fd >= 0)
+		int64_t now = k_uptime_get();
+		int timeout = -1;
+		bool slot_free = false;
+
+		// fds[0] is the listening socket, fds[i + 1] belongs to http_connections[i], negative fds are ignored by poll
+		for (int i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+		{
+			struct http_connection *conn = &http_connections[i];
+			fds[i + 1].fd = conn->fd;
+			fds[i + 1].events = conn->sending ? POLLOUT : POLLIN;
+			fds[i + 1].revents = 0;
+			if (conn->fd < 0)
+			{
+				slot_free = true;
+				continue;
+			}
+			int remaining = (int)MAX(conn->deadline - now, 0);
+			if (timeout < 0 || remaining < timeout)
+			{
+				timeout = remaining;
+			}
+		}
+		fds[0].fd = slot_free ? server_fd : -1;
+		fds[0].events = POLLIN;
+		fds[0].revents = 0;
+
+		if (poll(fds, ARRAY_SIZE(fds), timeout) < 0)
+		{
+			LOG_ERR("http poll error: %d", errno);
+			k_msleep(100);
+			continue;
+		}
+
+		now = k_uptime_get();
+		for (int i = 0; i < HTTP_MAX_CONNECTIONS; i++)
+		{
+			struct http_connection *conn = &http_connections[i];
+			if (conn->fd < 0 || fds[i + 1].fd != conn->fd)
+			{
+				continue;
+			}
+			if (fds[i + 1].revents & (POLLERR | POLLNVAL))
+			{
+				http_connection_close(conn);
+			}
+			else if (fds[i + 1].revents & (POLLIN | POLLHUP))
+			{
+				http_connection_receive(conn);
+			}
+			else if (fds[i + 1].revents & POLLOUT)
+			{
+				http_connection_send(conn);
+			}
+			else if (now >= conn->deadline)
+			{
+				LOG_DBG("http connection timed out");
+				http_connection_close(conn);
+			}
+		}
+
+		if (fds[0].revents & POLLIN)
 		{
-			process_request(client_fd);
+			http_connection_accept(server_fd);
 		}
 	}
 }
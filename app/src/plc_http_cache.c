@@ -0,0 +1,180 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_http_cache, LOG_LEVEL_INF);
+
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+
+#include "config.h"
+#include "plc_http_cache.h"
+
+/***************************************************************************************************************************************/
+/*		RAM cache for web files																								 		   */
+/***************************************************************************************************************************************/
+
+// Small web files installed by NewPLC are kept in HTTP_CACHE_SLOTS slots of HTTP_CACHE_SLOT_SIZE bytes and sent straight
+// from RAM. A slot is valid as long as the blobID of its path is unchanged. Each hit counts for the slot, each miss halves
+// the count of the least used slot until it reaches 0 and the slot is reused, so the hottest files stay cached.
+// Only the http thread uses the cache.
+
+#if HTTP_CACHE_SLOTS > 0
+
+struct http_cache_slot
+{
+	char path[BLOB_STORE_PATH_SIZE];
+	uint8_t id[16];
+	uint32_t size;
+	uint16_t hits;
+	uint8_t users; // connections sending from this slot
+	bool valid;
+};
+
+static struct http_cache_slot cache_slots[HTTP_CACHE_SLOTS];
+static uint8_t cache_data[HTTP_CACHE_SLOTS][HTTP_CACHE_SLOT_SIZE] __aligned(4);
+
+/****************************************************************************************************************************************
+ * @brief 			Reads a file into a slot.
+ *
+ * @param slot 		Slot index.
+ * @param path 		Path of the file.
+ * @param info 		blobID and size of the file.
+ * @return 			true if the file was read completely.
+ ****************************************************************************************************************************************/
+static bool http_cache_load(int slot, const char *path, const struct blob_info *info)
+{
+	struct http_cache_slot *entry = &cache_slots[slot];
+	struct fs_file_t file;
+
+	entry->valid = false;
+	fs_file_t_init(&file);
+	if (fs_open(&file, path, FS_O_READ) != 0)
+	{
+		return false;
+	}
+	ssize_t count = fs_read(&file, cache_data[slot], info->size);
+	fs_close(&file);
+	if (count != info->size)
+	{
+		return false;
+	}
+
+	strcpy(entry->path, path);
+	memcpy(entry->id, info->id, sizeof(entry->id));
+	entry->size = info->size;
+	entry->hits = 1;
+	entry->valid = true;
+	LOG_DBG("cached %s, %u bytes", path, info->size);
+	return true;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Gets the content of a web file from the cache, the file is cached if it is small enough and a slot is free
+ * 					or cold enough.
+ *
+ * @param path 		Path of the installed file.
+ * @param info 		blobID and size of the file, from blob_store_stat.
+ * @return 			Content of the file, valid until http_cache_release. NULL if the file is read from the filesystem.
+ ****************************************************************************************************************************************/
+const uint8_t *http_cache_acquire(const char *path, const struct blob_info *info)
+{
+	int victim = -1;
+
+	if ((info->size > HTTP_CACHE_SLOT_SIZE) || (strlen(path) >= BLOB_STORE_PATH_SIZE))
+	{
+		return NULL;
+	}
+
+	for (int i = 0; i < HTTP_CACHE_SLOTS; i++)
+	{
+		struct http_cache_slot *entry = &cache_slots[i];
+		if (entry->valid && (strcmp(entry->path, path) == 0))
+		{
+			if ((entry->size != info->size) || (memcmp(entry->id, info->id, sizeof(entry->id)) != 0))
+			{
+				if (entry->users > 0)
+				{
+					return NULL; // Old content is still sent
+				}
+				victim = i; // Content changed by NewPLC
+				break;
+			}
+			if (entry->hits < UINT16_MAX)
+			{
+				entry->hits++;
+			}
+			entry->users++;
+			return cache_data[i];
+		}
+		if (entry->users == 0 && (victim < 0 || !entry->valid || (cache_slots[victim].valid && entry->hits < cache_slots[victim].hits)))
+		{
+			victim = i;
+		}
+	}
+
+	if (victim < 0)
+	{
+		return NULL;
+	}
+	struct http_cache_slot *entry = &cache_slots[victim];
+	if (entry->valid && (strcmp(entry->path, path) != 0))
+	{
+		entry->hits /= 2;
+		if (entry->hits > 0)
+		{
+			return NULL;
+		}
+	}
+	if (!http_cache_load(victim, path, info))
+	{
+		return NULL;
+	}
+	entry->users++;
+	return cache_data[victim];
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Releases content returned by http_cache_acquire.
+ *
+ * @param data 		Content of the file.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void http_cache_release(const uint8_t *data)
+{
+	for (int i = 0; i < HTTP_CACHE_SLOTS; i++)
+	{
+		if ((data == cache_data[i]) && (cache_slots[i].users > 0))
+		{
+			cache_slots[i].users--;
+			return;
+		}
+	}
+}
+
+#else
+
+const uint8_t *http_cache_acquire(const char *path, const struct blob_info *info) { return NULL; }
+void http_cache_release(const uint8_t *data) {}
+
+#endif
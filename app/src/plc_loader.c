@@ -38,6 +38,7 @@ LOG_MODULE_REGISTER(plc_loader, LOG_LEVEL_DBG);
 #include "config.h"
 #include "udynlink.h"
 #include "plc_network.h"
+#include "plc_debug.h"
 #include "plc_loader.h"
 #include "plc_log_rte.h"
 #include "plc_settings.h"
@@ -109,15 +110,15 @@ K_SEM_DEFINE(sem_plc_run, 0, 1);
 #define MAX_RAM_BUFFER_SIZE 128
 #define PLC_PARTITION plc_partition
 #define PLC_PARTITION_ID FIXED_PARTITION_ID(PLC_PARTITION)
-#define SIGN (((uint32_t)'M' << 24) | ((uint32_t)'L' << 16) | ((uint32_t)'D' << 8) | (uint32_t)'U')
 #define READ_BLOCK_SIZE 1024
 
-// udynlink file header
-typedef struct
-{
-	uint32_t sign;
-	uint32_t crc;
-} file_header_t;
+// Flash slots for uploaded plc modules, a second slot is used if the board defines plc_partition_b
+#if FIXED_PARTITION_EXISTS(plc_partition_b)
+static const uint8_t plc_flash_slots[] = {PLC_PARTITION_ID, FIXED_PARTITION_ID(plc_partition_b)};
+#else
+static const uint8_t plc_flash_slots[] = {PLC_PARTITION_ID};
+#endif
+static int plc_loaded_slot = -1; // Slot the loaded module runs from, -1 if loaded to ram
 
 /****************************************************************************************************************************************
  * @brief    Checks the CRC of the given buffer against the CRC stored in the buffer's header. This function assumes the first part
@@ -153,7 +154,7 @@ void plc_loader_task(void *, void *, void *)
 	if (get_plc_autostart_setting())
 	{
 		LOG_INF("PLC autostart enabled");
-		int ret = load_plc_module(PLC_BIN_FILE);
+		int ret = load_plc_module(plc_module_source());
 		if (ret == 0)
 		{
 			LOG_INF("PLC loaded, now try to start");
@@ -186,7 +187,7 @@ void plc_loader_task(void *, void *, void *)
 				{
 					LOG_WRN("Failed to unload plc module");
 				}
-				load_plc_module(PLC_BIN_FILE);
+				load_plc_module(plc_module_source());
 			}
 			else
 				LOG_WRN("plc running, cant load new plc module");
@@ -332,6 +333,68 @@ int write_plc_programm_flash(int state)
 	return 0;
 }
 
+/****************************************************************************************************************************************
+ * @brief               		plc_module_source
+ * 								returns where the plc module is loaded from at start
+ * @param	void
+ *
+ * @return 	char*				PLC_FLASH_MODULE if a flash slot is active, otherwise PLC_BIN_FILE
+ *
+ ****************************************************************************************************************************************/
+char *plc_module_source(void) { return (get_plc_flash_slot_setting() >= 0) ? PLC_FLASH_MODULE : PLC_BIN_FILE; }
+
+/****************************************************************************************************************************************
+ * @brief               		plc_flash_slot_area
+ * @param	int	slot			flash slot
+ *
+ * @return 	int					flash area id of the slot, the first slot for invalid slots
+ *
+ ****************************************************************************************************************************************/
+int plc_flash_slot_area(int slot)
+{
+	if ((slot < 0) || (slot >= ARRAY_SIZE(plc_flash_slots)))
+		return plc_flash_slots[0];
+	return plc_flash_slots[slot];
+}
+
+/****************************************************************************************************************************************
+ * @brief               		plc_flash_inactive_slot
+ * 								returns a flash slot which can be erased for a new plc module, the active
+ * 								slot and the slot of the loaded module are never used, so the installed module
+ * 								and its md5 stay valid until NewPLC switches to the new one. No slot is returned
+ * 								while the plc runs, erasing the internal flash stalls the execution from it
+ * @param	void
+ *
+ * @return 	int					slot number, -1 if no slot is free or the plc is running
+ *
+ ****************************************************************************************************************************************/
+int plc_flash_inactive_slot(void)
+{
+	if (plc_run != 0)
+		return -1;
+
+	for (int slot = 0; slot < ARRAY_SIZE(plc_flash_slots); slot++)
+	{
+		if ((slot != get_plc_flash_slot_setting()) && !((plc_initialized > 0) && (slot == plc_loaded_slot)))
+			return slot;
+	}
+	return -1;
+}
+
+/****************************************************************************************************************************************
+ * @brief               		plc_flash_activate_slot
+ * 								sets the flash slot the plc module is loaded from
+ * @param	int	slot			flash slot, -1 to load plc.bin from the filesystem
+ *
+ * @return 	void
+ *
+ ****************************************************************************************************************************************/
+void plc_flash_activate_slot(int slot)
+{
+	LOG_INF("plc module flash slot %d activated", slot);
+	set_plc_flash_slot_setting(slot);
+}
+
 /****************************************************************************************************************************************
  * @brief               		erase plc_partition
  *
@@ -362,24 +425,31 @@ int erase_plc_programm_flash(int state)
 		plc_initialized = 0;
 	}
 
-	err = flash_area_open(PLC_PARTITION_ID, &plc_partition_area);
-	if (err)
+	if (get_plc_flash_slot_setting() >= 0)
+		plc_flash_activate_slot(-1);
+
+	for (int slot = 0; slot < ARRAY_SIZE(plc_flash_slots); slot++)
 	{
-		LOG_ERR("Error while opening the flash partition: %d", err);
-		return -EAGAIN;
-	}
+		err = flash_area_open(plc_flash_slots[slot], &plc_partition_area);
+		if (err)
+		{
+			LOG_ERR("Error while opening the flash partition: %d", err);
+			return -EAGAIN;
+		}
 
-	LOG_INF("erase plc_partition");
+		LOG_INF("erase plc_partition %d", slot);
 
-	err = flash_area_erase(plc_partition_area, 0, plc_partition_area->fa_size);
-	if (err)
-	{
-		LOG_ERR("error while erasing plc_partition: %d %d %s", err, errno, strerror(errno));
-		return -EAGAIN;
-	}
+		err = flash_area_erase(plc_partition_area, 0, plc_partition_area->fa_size);
+		if (err)
+		{
+			LOG_ERR("error while erasing plc_partition: %d %d %s", err, errno, strerror(errno));
+			flash_area_close(plc_partition_area);
+			return -EAGAIN;
+		}
 
-	LOG_INF("plc_partition erased.");
-	flash_area_close(plc_partition_area);
+		LOG_INF("plc_partition %d erased.", slot);
+		flash_area_close(plc_partition_area);
+	}
 
 	if (state == 1) // erase also plc.bin and extra_files
 	{
@@ -425,7 +495,7 @@ int load_plc_module(char *filename)
 	fs_file_t_init(&file);
 
 	int ret = 0;
-	if (strcmp(filename, "FLASH")) // try to load file
+	if (strcmp(filename, PLC_FLASH_MODULE)) // try to load file
 	{
 		int ret = fs_stat(filename, &dirent);
 		if (ret == 0)
@@ -464,6 +534,7 @@ int load_plc_module(char *filename)
 				{
 					const char *mod_name = udynlink_get_module_name(&mod);
 					LOG_INF("loaded plc module %s from ram", mod_name);
+					plc_loaded_slot = -1;
 					file_loader_ret = 1;
 				}
 			}
@@ -478,10 +549,11 @@ int load_plc_module(char *filename)
 			return ret;
 		}
 	}
-	else if (!strcmp(filename, "FLASH")) 					// try to load flash
+	else if (!strcmp(filename, PLC_FLASH_MODULE)) 			// try to load flash
 	{
 		const struct flash_area *pfa;
-		if (flash_area_open(PLC_PARTITION_ID, &pfa) != 0) 	// Prepare the flash partition
+		int slot = MAX(get_plc_flash_slot_setting(), 0); 	// active slot, the first slot if none is active
+		if (flash_area_open(plc_flash_slot_area(slot), &pfa) != 0) // Prepare the flash partition
 		{
 			LOG_ERR("Error opening flash partition");
 			return -EIO;
@@ -497,6 +569,7 @@ int load_plc_module(char *filename)
 			{
 				const char *mod_name = udynlink_get_module_name(&mod);
 				LOG_INF("loaded plc module %s from flash partition at 0x%06x", mod_name, (uint32_t)pfa->fa_off);
+				plc_loaded_slot = slot;
 				flash_loader_ret = 1;
 			}
 		}
@@ -568,6 +641,7 @@ int unload_plc_module(void)
 	if ((plc_run == 0) && (plc_initialized == 1))
 	{
 		plc_initialized = 0;
+		rte_log_deferred_flush(); // log queued messages of the module before it is gone
 		ret = udynlink_unload_module(&mod);
 		if (ret == UDYNLINK_OK)
 			LOG_INF("plc module unloaded");
@@ -668,6 +742,8 @@ uint32_t udynlink_external_resolve_symbol(const char *name)
 		return (uint32_t)&printk;
 	else if (!strcmp(name, "rte_log_inf"))
 		return (uint32_t)&rte_log_inf;
+	else if (!strcmp(name, "rte_log_inf_deferred"))
+		return (uint32_t)&rte_log_inf_deferred;
 	else if (!strcmp(name, "puts"))
 		return (uint32_t)&puts;
 	else if (!strcmp(name, "putchar"))
@@ -1077,9 +1153,9 @@ static int cmd_plc_force_var(const struct shell *sh, size_t argc, char **argv)
 	uint32_t idx = atoi(argv[1]);
 	bool forced = atoi(argv[2]);
 	uint32_t val = atoi(argv[3]);
+	binary_t value = {.data = (uint8_t *)&val, .dataLength = sizeof(val)};
 
-	force_var(idx, forced, &val);
-	return 0;
+	return plc_debug_force(idx, forced ? &value : NULL); // applied at the next cycle boundary
 }
 
 /****************************************************************************************************************************************
@@ -0,0 +1,402 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+#ifdef CONFIG_PLC_LOG_BACKEND_FILE
+#include <stdio.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_core.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "config.h"
+
+/************************************************************************************************************************/
+/*		system log file backend																							*/
+/************************************************************************************************************************/
+
+// The backend needs deferred log mode, the process function runs in the log thread and formats the message there,
+// outside of any lock, immediate mode would format in every logging thread and interrupt. Only the formatted output is
+// passed to sys_log_ring under sys_log_lock, the ring is shared with the work queue. The file is written by the own
+// work queue of the backend in blocks of SYS_LOG_WRITE_SIZE bytes at block aligned file offsets, a slow file system
+// doesn't hold up the log thread or the system work queue. Output that waits longer than SYS_LOG_FLUSH_PERIOD is written as partial block,
+// the next write fills up the block, so later blocks are aligned again. The file is rotated to sys1.log .. sysN.log
+// when it exceeds SYS_LOG_FILE_MAX_SIZE. Messages of the file system and storage drivers are not written, writing
+// the log would produce more of them. Each module may write SYS_LOG_RATE_LIMIT messages per second, further messages
+// are counted and reported.
+
+#define SYS_LOG_WORKQ_STACK_SIZE 1536
+#define SYS_LOG_WORKQ_PRIORITY 14
+
+static uint8_t sys_log_output_buf[128];										// Line buffer of log_output
+static uint8_t __ccm_noinit_section sys_log_ring_data[SYS_LOG_BUFFER_SIZE];
+static struct ring_buf sys_log_ring = {.buffer = sys_log_ring_data, .size = SYS_LOG_BUFFER_SIZE}; // Output waiting to be written
+static uint8_t __ccm_noinit_section sys_log_block[SYS_LOG_WRITE_SIZE];		// Block passed to fs_write
+static struct k_spinlock sys_log_lock;										// Protects the ring and sys_log_lost
+static uint32_t sys_log_lost = 0;											// Bytes lost because the ring was full
+
+// File state, only used by the work queue
+static struct fs_file_t sys_log_file;
+static bool sys_log_file_open = false;
+static uint32_t sys_log_file_size = 0;
+
+// Rate limiting and module filter per log source, only used by the log thread
+enum
+{
+	SYS_LOG_SOURCE_UNKNOWN = 0,
+	SYS_LOG_SOURCE_WRITTEN,
+	SYS_LOG_SOURCE_EXCLUDED,
+};
+static uint16_t sys_log_rate_count[SYS_LOG_MAX_SOURCES];
+static uint8_t sys_log_source_state[SYS_LOG_MAX_SOURCES];
+static uint32_t sys_log_rate_window = 0;									// Uptime in seconds of the current window
+static uint32_t sys_log_suppressed = 0;										// Messages suppressed in the current window
+
+K_THREAD_STACK_DEFINE(sys_log_workq_stack, SYS_LOG_WORKQ_STACK_SIZE);
+static struct k_work_q sys_log_workq;
+static bool sys_log_workq_started = false;
+static void sys_log_write_handler(struct k_work *work);
+static void sys_log_flush_handler(struct k_work *work);
+K_WORK_DEFINE(sys_log_write_work, sys_log_write_handler);
+K_WORK_DELAYABLE_DEFINE(sys_log_flush_work, sys_log_flush_handler);
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_file_name
+ *                       Builds the name of the log file with the given rotation index, 0 is the current file.
+ * @param buf            Destination of the name.
+ * @param size           Size of buf.
+ * @param index          Rotation index.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_file_name(char *buf, size_t size, int index)
+{
+	if (index == 0)
+		snprintf(buf, size, "%s.log", SYS_LOG_FILE_BASE);
+	else
+		snprintf(buf, size, "%s%d.log", SYS_LOG_FILE_BASE, index);
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_rotate
+ *                       Closes the current log file and shifts the older files, the oldest one is deleted.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_rotate(void)
+{
+	char from[32], to[32];
+
+	fs_close(&sys_log_file);
+	sys_log_file_open = false;
+
+	sys_log_file_name(to, sizeof(to), SYS_LOG_FILE_COUNT - 1);
+	fs_unlink(to);
+	for (int i = SYS_LOG_FILE_COUNT - 2; i >= 0; i--)
+	{
+		sys_log_file_name(from, sizeof(from), i);
+		sys_log_file_name(to, sizeof(to), i + 1);
+		fs_rename(from, to);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_write
+ *                       Appends the output in the ring to the log file, each write ends at a block boundary of the file.
+ *                       The output is kept in the ring if the file system isn't available yet, e.g. during boot.
+ * @param partial        true to write a last partial block, otherwise only complete blocks are written.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_write(bool partial)
+{
+	char name[32];
+	struct fs_dirent entry;
+	bool written = false;
+
+	for (;;)
+	{
+		if (!sys_log_file_open)
+		{
+			sys_log_file_name(name, sizeof(name), 0);
+			fs_file_t_init(&sys_log_file);
+			if (fs_open(&sys_log_file, name, FS_O_CREATE | FS_O_WRITE | FS_O_APPEND) < 0)
+				break;
+			sys_log_file_open = true;
+			sys_log_file_size = (fs_stat(name, &entry) == 0) ? entry.size : 0;
+		}
+
+		size_t block_space = SYS_LOG_WRITE_SIZE - (sys_log_file_size % SYS_LOG_WRITE_SIZE);
+		k_spinlock_key_t key = k_spin_lock(&sys_log_lock);
+		size_t pending = ring_buf_size_get(&sys_log_ring);
+		size_t length = (pending >= block_space || partial) ? ring_buf_peek(&sys_log_ring, sys_log_block, MIN(pending, block_space)) : 0;
+		k_spin_unlock(&sys_log_lock, key);
+		if (length == 0)
+			break;
+
+		if (fs_write(&sys_log_file, sys_log_block, length) != length)
+		{
+			fs_close(&sys_log_file); // Reopened with the next write, the output stays in the ring
+			sys_log_file_open = false;
+			break;
+		}
+		written = true;
+		sys_log_file_size += length;
+
+		key = k_spin_lock(&sys_log_lock);
+		ring_buf_get(&sys_log_ring, NULL, length);
+		k_spin_unlock(&sys_log_lock, key);
+
+		if (sys_log_file_size >= SYS_LOG_FILE_MAX_SIZE)
+		{
+			sys_log_rotate();
+			written = false;
+		}
+	}
+
+	if (written)
+	{
+		fs_sync(&sys_log_file);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_write_handler
+ *                       Writes the complete blocks, submitted when a block is pending.
+ * @param work           Work item.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_write_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	sys_log_write(false);
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_flush_handler
+ *                       Writes output that waits longer than SYS_LOG_FLUSH_PERIOD.
+ * @param work           Work item.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_flush_handler(struct k_work *work)
+{
+	ARG_UNUSED(work);
+
+	sys_log_write(true);
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_put
+ *                       Adds output to the ring.
+ * @param data           Output.
+ * @param length         Length of the output.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_put(const uint8_t *data, size_t length)
+{
+	k_spinlock_key_t key = k_spin_lock(&sys_log_lock);
+	sys_log_lost += length - ring_buf_put(&sys_log_ring, data, length);
+	k_spin_unlock(&sys_log_lock, key);
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_out
+ *                       Output function of log_output, called by the log thread.
+ * @param data           Formatted output.
+ * @param length         Length of the output.
+ * @param ctx            Unused.
+ * @return               Number of bytes consumed, always all of them.
+ ****************************************************************************************************************************************/
+static int sys_log_out(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	sys_log_put(data, length);
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(sys_log_output, sys_log_out, sys_log_output_buf, sizeof(sys_log_output_buf));
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_rate_limited
+ *                       Counts a message of a log source and checks whether the source exceeded its rate.
+ * @param slot           Rate limit slot of the log source.
+ * @return               true if the message has to be suppressed.
+ ****************************************************************************************************************************************/
+static bool sys_log_rate_limited(uint32_t slot)
+{
+	uint32_t now = (uint32_t)(k_uptime_get() / MSEC_PER_SEC);
+
+	if (now != sys_log_rate_window)
+	{
+		if (sys_log_suppressed > 0)
+		{
+			char line[64];
+			int len = snprintf(line, sizeof(line), "--- %u messages suppressed by rate limit ---\r\n", sys_log_suppressed);
+			sys_log_put((uint8_t *)line, len);
+		}
+		k_spinlock_key_t key = k_spin_lock(&sys_log_lock);
+		uint32_t lost = (ring_buf_space_get(&sys_log_ring) >= 64) ? sys_log_lost : 0;
+		sys_log_lost -= lost;
+		k_spin_unlock(&sys_log_lock, key);
+		if (lost > 0)
+		{
+			char line[64];
+			int len = snprintf(line, sizeof(line), "--- %u bytes of log output lost ---\r\n", lost);
+			sys_log_put((uint8_t *)line, len);
+		}
+		memset(sys_log_rate_count, 0, sizeof(sys_log_rate_count));
+		sys_log_rate_window = now;
+		sys_log_suppressed = 0;
+	}
+
+	if (sys_log_rate_count[slot] >= SYS_LOG_RATE_LIMIT)
+	{
+		sys_log_suppressed++;
+		return true;
+	}
+	sys_log_rate_count[slot]++;
+	return false;
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_excluded
+ *                       Checks whether a log source belongs to the file system or a storage driver, the result is cached.
+ * @param domain_id      Domain of the log source.
+ * @param source_id      Id of the log source.
+ * @param slot           Cache slot of the log source, sources beyond SYS_LOG_MAX_SOURCES share the last one and
+ *                       aren't cached.
+ * @return               true if messages of the source are not written.
+ ****************************************************************************************************************************************/
+static bool sys_log_excluded(uint8_t domain_id, int16_t source_id, uint32_t slot)
+{
+	static const char *const excluded[] = SYS_LOG_EXCLUDED_MODULES;
+
+	if (source_id < 0)
+		return false;
+	if (slot == source_id && sys_log_source_state[slot] != SYS_LOG_SOURCE_UNKNOWN)
+		return sys_log_source_state[slot] == SYS_LOG_SOURCE_EXCLUDED;
+
+	const char *name = log_source_name_get(domain_id, source_id);
+	bool match = false;
+	for (size_t i = 0; name && !match && i < ARRAY_SIZE(excluded); i++)
+	{
+		match = strncmp(name, excluded[i], strlen(excluded[i])) == 0;
+	}
+
+	if (slot == source_id)
+		sys_log_source_state[slot] = match ? SYS_LOG_SOURCE_EXCLUDED : SYS_LOG_SOURCE_WRITTEN;
+	return match;
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_process
+ *                       Backend process function, formats a message into the ring and schedules the file write. Runs
+ *                       in the log thread, messages are formatted one after the other.
+ * @param backend        The backend.
+ * @param msg            Log message.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	ARG_UNUSED(backend);
+
+	const void *source = log_msg_get_source(&msg->log);
+	int16_t source_id = -1;
+	if (source != NULL)
+	{
+		source_id = IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ? log_dynamic_source_id((struct log_source_dynamic_data *)source)
+															 : log_const_source_id((const struct log_source_const_data *)source);
+	}
+	uint32_t slot = CLAMP(source_id, 0, SYS_LOG_MAX_SOURCES - 1);
+
+	if (!sys_log_excluded(log_msg_get_domain(&msg->log), source_id, slot) && !sys_log_rate_limited(slot))
+	{
+		log_output_msg_process(&sys_log_output, &msg->log, LOG_OUTPUT_FLAG_LEVEL | LOG_OUTPUT_FLAG_TIMESTAMP | LOG_OUTPUT_FLAG_FORMAT_TIMESTAMP);
+	}
+	k_spinlock_key_t key = k_spin_lock(&sys_log_lock);
+	bool block_pending = ring_buf_size_get(&sys_log_ring) >= SYS_LOG_WRITE_SIZE;
+	k_spin_unlock(&sys_log_lock, key);
+
+	if (sys_log_workq_started)
+	{
+		if (block_pending)
+			k_work_submit_to_queue(&sys_log_workq, &sys_log_write_work);
+		k_work_schedule_for_queue(&sys_log_workq, &sys_log_flush_work, K_MSEC(SYS_LOG_FLUSH_PERIOD)); // Keeps a pending flush, doesn't postpone it
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_dropped
+ *                       Reports messages dropped by the logging core.
+ * @param backend        The backend.
+ * @param cnt            Number of dropped messages.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_dropped(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	log_output_dropped_process(&sys_log_output, cnt);
+}
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_panic
+ *                       Stops writing to file, messages after a panic are not written. The file system can't be used
+ *                       safely from the panic context.
+ * @param backend        The backend.
+ * @return
+ ****************************************************************************************************************************************/
+static void sys_log_panic(const struct log_backend *const backend)
+{
+	log_backend_disable(backend);
+}
+
+static const struct log_backend_api sys_log_backend_api = {
+	.process = sys_log_process,
+	.dropped = sys_log_dropped,
+	.panic = sys_log_panic,
+};
+
+LOG_BACKEND_DEFINE(sys_log_backend_file, sys_log_backend_api, true);
+
+/****************************************************************************************************************************************
+ * @brief                sys_log_workq_init
+ *                       Starts the work queue of the backend, output logged before is written with the first flush.
+ * @param
+ * @return               0
+ ****************************************************************************************************************************************/
+static int sys_log_workq_init(void)
+{
+	const struct k_work_queue_config config = {.name = "sys_log_workq"};
+
+	k_work_queue_start(&sys_log_workq, sys_log_workq_stack, K_THREAD_STACK_SIZEOF(sys_log_workq_stack), SYS_LOG_WORKQ_PRIORITY, &config);
+	sys_log_workq_started = true;
+	k_work_schedule_for_queue(&sys_log_workq, &sys_log_flush_work, K_MSEC(SYS_LOG_FLUSH_PERIOD));
+	return 0;
+}
+
+SYS_INIT(sys_log_workq_init, APPLICATION, CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#endif
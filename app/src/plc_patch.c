@@ -0,0 +1,375 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_patch, LOG_LEVEL_INF);
+
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <mbedtls/md5.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+
+#include "config.h"
+#include "plc_loader.h"
+#include "plc_patch.h"
+#include "plc_settings.h"
+#include "plc_upload.h"
+
+/***************************************************************************************************************************************/
+/*		plc module patches																									 		   */
+/***************************************************************************************************************************************/
+
+// The patch is applied while it is received, the commands may be split anywhere between the chunks. The new module is
+// passed to upload_write, the target of the upload was opened by the rpc thread like for a complete module. Size, crc of
+// the udynlink header and md5 of the new module are checked by module_patch_end.
+
+enum module_patch_state
+{
+	PATCH_HEADER,
+	PATCH_OP,
+	PATCH_OFFSET,
+	PATCH_LENGTH,
+	PATCH_COPY,
+	PATCH_ADD,
+	PATCH_DATA,
+	PATCH_FAILED,
+};
+
+struct module_patch
+{
+	struct module_patch_header header;
+	size_t header_fill;
+	uint8_t state;
+	uint8_t op;
+	uint8_t shift;							// LEB128 bits read into value
+	uint32_t value;
+	uint32_t offset;						// stored module offset of the command
+	uint32_t length;						// bytes of the command left
+	uint32_t written;						// bytes of the new module
+	uint32_t crc;							// crc of the new module without its header
+	file_header_t module_header;
+	mbedtls_md5_context md5;
+	const struct flash_area *base_flash;	// stored module in a flash slot
+	struct fs_file_t base_file;				// or in PLC_BIN_FILE
+};
+
+static struct module_patch __ccm_noinit_section patch;
+static bool patch_open = false;				// stored module is open, a patch is being applied
+static uint8_t __ccm_noinit_section patch_block[MODULE_PATCH_BLOCK_SIZE];
+
+/****************************************************************************************************************************************
+ * @brief 			Reads from the stored module.
+ *
+ * @param offset 	Offset in the stored module.
+ * @param data 		Destination.
+ * @param length 	Number of bytes.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int module_patch_read_base(uint32_t offset, uint8_t *data, size_t length)
+{
+	if (patch.base_flash != NULL)
+	{
+		if (offset + length > patch.base_flash->fa_size)
+		{
+			return -EINVAL;
+		}
+		return flash_area_read(patch.base_flash, offset, data, length);
+	}
+
+	int ret = fs_seek(&patch.base_file, offset, FS_SEEK_SET);
+	if (ret == 0)
+	{
+		ret = fs_read(&patch.base_file, data, length);
+		ret = (ret == length) ? 0 : (ret < 0) ? ret : -EINVAL;
+	}
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Passes data of the new module to the upload and updates its checks.
+ *
+ * @param data 		Data of the new module.
+ * @param length 	Number of bytes.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int module_patch_emit(const uint8_t *data, size_t length)
+{
+	if (patch.written + length > patch.header.target_size)
+	{
+		LOG_ERR("patch exceeds the module size %u", patch.header.target_size);
+		return -EFBIG;
+	}
+
+	size_t header = 0;
+	if (patch.written < sizeof(file_header_t))
+	{
+		header = MIN(sizeof(file_header_t) - patch.written, length);
+		memcpy((uint8_t *)&patch.module_header + patch.written, data, header);
+	}
+	patch.crc = crc32_ieee_update(patch.crc, data + header, length - header);
+	mbedtls_md5_update(&patch.md5, data, length);
+	patch.written += length;
+	return upload_write(data, length);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Checks the complete patch header against the stored plc.
+ *
+ * @return 			0 if the patch belongs to the stored plc, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int module_patch_check_header(void)
+{
+	char md5[33] = {0};
+
+	FILE *fp = fopen(PLC_MD5_FILE, "r");
+	if (fp == NULL)
+	{
+		LOG_ERR("no md5 file found, patch refused");
+		return -ENOENT;
+	}
+	fread(md5, 1, sizeof(md5) - 1, fp);
+	fclose(fp);
+
+	if (memcmp(md5, patch.header.base_md5, sizeof(patch.header.base_md5)) != 0)
+	{
+		LOG_ERR("patch does not belong to the stored plc %s", md5);
+		return -ESTALE;
+	}
+	LOG_INF("applying patch to plc %s, new module %u bytes", md5, patch.header.target_size);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Opens the stored module for a new patch.
+ *
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int module_patch_begin(void)
+{
+	int ret;
+
+	module_patch_end();
+	memset(&patch, 0, sizeof(patch));
+	mbedtls_md5_init(&patch.md5);
+	mbedtls_md5_starts(&patch.md5);
+	patch.state = PATCH_HEADER;
+
+	int slot = get_plc_flash_slot_setting();
+	if (slot >= 0)
+	{
+		ret = flash_area_open(plc_flash_slot_area(slot), &patch.base_flash);
+	}
+	else
+	{
+		fs_file_t_init(&patch.base_file);
+		ret = fs_open(&patch.base_file, PLC_BIN_FILE, FS_O_READ);
+	}
+	if (ret != 0)
+	{
+		LOG_ERR("cant open stored plc module: %d", ret);
+		patch.base_flash = NULL;
+		return ret;
+	}
+	patch_open = true;
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Applies the next part of the patch.
+ *
+ * @param data 		Patch data.
+ * @param length 	Number of bytes.
+ * @return 			0 on success, negative error code if the patch is invalid or the new module can't be written.
+ ****************************************************************************************************************************************/
+int module_patch_write(const uint8_t *data, size_t length)
+{
+	int ret = 0;
+
+	if (!patch_open)
+	{
+		return -EBADF;
+	}
+
+	while ((ret == 0) && ((length > 0) || (patch.state == PATCH_COPY)))
+	{
+		switch (patch.state)
+		{
+		case PATCH_HEADER:
+		{
+			size_t count = MIN(length, sizeof(patch.header) - patch.header_fill);
+			memcpy((uint8_t *)&patch.header + patch.header_fill, data, count);
+			patch.header_fill += count;
+			data += count;
+			length -= count;
+			if (patch.header_fill == sizeof(patch.header))
+			{
+				ret = module_patch_check_header();
+				patch.state = PATCH_OP;
+			}
+			break;
+		}
+
+		case PATCH_OP:
+			patch.op = *data++;
+			length--;
+			if (patch.op > MODULE_PATCH_DATA)
+			{
+				LOG_ERR("invalid patch command %u", patch.op);
+				ret = -EBADMSG;
+			}
+			patch.state = (patch.op == MODULE_PATCH_DATA) ? PATCH_LENGTH : PATCH_OFFSET;
+			break;
+
+		case PATCH_OFFSET:
+		case PATCH_LENGTH:
+			if (patch.shift >= 32)
+			{
+				ret = -EBADMSG;
+				break;
+			}
+			patch.value |= (uint32_t)(*data & 0x7f) << patch.shift;
+			patch.shift += 7;
+			if ((*data++ & 0x80) == 0)
+			{
+				if (patch.state == PATCH_OFFSET)
+				{
+					patch.offset = patch.value;
+					patch.state = PATCH_LENGTH;
+				}
+				else
+				{
+					patch.length = patch.value;
+					patch.state = (patch.op == MODULE_PATCH_COPY) ? PATCH_COPY : (patch.op == MODULE_PATCH_ADD) ? PATCH_ADD : PATCH_DATA;
+				}
+				patch.value = 0;
+				patch.shift = 0;
+			}
+			length--;
+			break;
+
+		case PATCH_COPY:
+		{
+			size_t count = MIN(patch.length, sizeof(patch_block));
+			ret = module_patch_read_base(patch.offset, patch_block, count);
+			if (ret == 0)
+			{
+				ret = module_patch_emit(patch_block, count);
+			}
+			patch.offset += count;
+			patch.length -= count;
+			break;
+		}
+
+		case PATCH_ADD:
+		{
+			size_t count = MIN(MIN(patch.length, length), sizeof(patch_block));
+			ret = module_patch_read_base(patch.offset, patch_block, count);
+			for (size_t i = 0; i < count; i++)
+			{
+				patch_block[i] += data[i];
+			}
+			if (ret == 0)
+			{
+				ret = module_patch_emit(patch_block, count);
+			}
+			patch.offset += count;
+			patch.length -= count;
+			data += count;
+			length -= count;
+			break;
+		}
+
+		case PATCH_DATA:
+		{
+			size_t count = MIN(patch.length, length);
+			ret = module_patch_emit(data, count);
+			patch.length -= count;
+			data += count;
+			length -= count;
+			break;
+		}
+
+		default:
+			ret = -EBADMSG; // a previous part was invalid
+			break;
+		}
+
+		if (((patch.state == PATCH_COPY) || (patch.state == PATCH_ADD) || (patch.state == PATCH_DATA)) && (patch.length == 0))
+		{
+			patch.state = PATCH_OP;
+		}
+	}
+	if (ret != 0)
+	{
+		patch.state = PATCH_FAILED;
+	}
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Closes the stored module and checks the new module.
+ *
+ * @return 			0 if the new module is complete and valid, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int module_patch_end(void)
+{
+	uint8_t md5[16];
+
+	if (!patch_open)
+	{
+		return -EBADF;
+	}
+	patch_open = false;
+	if (patch.base_flash != NULL)
+	{
+		flash_area_close(patch.base_flash);
+		patch.base_flash = NULL;
+	}
+	else
+	{
+		fs_close(&patch.base_file);
+	}
+
+	mbedtls_md5_finish(&patch.md5, md5);
+	mbedtls_md5_free(&patch.md5);
+	if ((patch.state != PATCH_OP) || (patch.written != patch.header.target_size))
+	{
+		LOG_ERR("patch incomplete, %u of %u bytes", patch.written, patch.header.target_size);
+		return -EBADMSG;
+	}
+	if ((patch.module_header.sign != SIGN) || (patch.module_header.crc != patch.crc))
+	{
+		LOG_ERR("patched module invalid, crc 0x%08x expected 0x%08x", patch.crc, patch.module_header.crc);
+		return -EBADMSG;
+	}
+	if (memcmp(md5, patch.header.target_md5, sizeof(md5)) != 0)
+	{
+		LOG_ERR("patched module md5 mismatch");
+		return -EBADMSG;
+	}
+	LOG_INF("patch applied, new module %u bytes", patch.written);
+	return 0;
+}
@@ -0,0 +1,305 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_recorder, LOG_LEVEL_INF);
+
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+
+#include "config.h"
+#include "plc_debug.h"
+#include "plc_recorder.h"
+#include "plc_settings.h"
+
+/************************************************************************************************************************/
+/*		rte flight recorder																								*/
+/************************************************************************************************************************/
+
+extern uint32_t plc_run;													// PLC running state from plc_loader
+extern uint32_t traced_vars_count;											// Count of currently traced vars from plc_debug
+extern int debug_thread_state;												// State of the debug thread from plc_debug
+
+K_MUTEX_DEFINE(flight_recorder_mutex);										// Protects the recording file and the chunk buffer
+
+static uint8_t __ccm_noinit_section recorder_chunk[FLIGHT_RECORDER_CHUNK_SIZE]; // Chunk being filled, written as a whole
+static struct trace_layout __ccm_noinit_section recorder_layout;			// Layout of the current recording
+static struct fs_file_t recorder_file;
+static bool recorder_open = false;											// Recording file is open
+static bool recorder_dirty = false;											// Chunk holds records that are not on file
+static size_t recorder_record_max = 0;										// Size of a record with all variables due
+static int64_t recorder_last_write = 0;										// Uptime of the last chunk write
+
+/****************************************************************************************************************************************
+ * @brief                recorder_write_chunk
+ *                       Writes the chunk buffer to its slot in the recording file. A partially filled chunk is written
+ *                       again to the same slot once more records were added.
+ * @param
+ * @return               0 on success, negative errno on failure.
+ ****************************************************************************************************************************************/
+static int recorder_write_chunk(void)
+{
+	struct flight_recorder_chunk *chunk = (struct flight_recorder_chunk *)recorder_chunk;
+	off_t offset = (off_t)((chunk->seq - 1) % FLIGHT_RECORDER_CHUNK_COUNT + 1) * FLIGHT_RECORDER_CHUNK_SIZE;
+
+	int ret = fs_seek(&recorder_file, offset, FS_SEEK_SET);
+	if (ret == 0)
+	{
+		ret = fs_write(&recorder_file, recorder_chunk, FLIGHT_RECORDER_CHUNK_SIZE);
+		ret = (ret == FLIGHT_RECORDER_CHUNK_SIZE) ? fs_sync(&recorder_file) : -EIO;
+	}
+	if (ret < 0)
+	{
+		LOG_ERR("flight recorder: failed to write chunk %u (%d)", chunk->seq, ret);
+	}
+
+	recorder_dirty = false;
+	recorder_last_write = k_uptime_get();
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief                recorder_next_chunk
+ *                       Starts the next chunk, overwriting the oldest one once the file is full.
+ * @param seq            Sequence number of the new chunk.
+ * @return
+ ****************************************************************************************************************************************/
+static void recorder_next_chunk(uint32_t seq)
+{
+	struct flight_recorder_chunk *chunk = (struct flight_recorder_chunk *)recorder_chunk;
+
+	memset(recorder_chunk, 0, FLIGHT_RECORDER_CHUNK_SIZE);
+	chunk->seq = seq;
+}
+
+/****************************************************************************************************************************************
+ * @brief                recorder_close
+ *                       Writes pending records and closes the recording file.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void recorder_close(void)
+{
+	if (recorder_open)
+	{
+		if (recorder_dirty)
+		{
+			recorder_write_chunk();
+		}
+		fs_close(&recorder_file);
+		recorder_open = false;
+		LOG_INF("flight recorder: recording closed");
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                recorder_start
+ *                       Starts a new recording for recorder_layout. The previous recording is discarded, its records
+ *                       can't be decoded with the new layout. Nothing is recorded while no variable is traced, the
+ *                       last recording stays on file until a new trace list is set.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void recorder_start(void)
+{
+	struct flight_recorder_header *header = (struct flight_recorder_header *)recorder_chunk;
+
+	recorder_close();
+	if (recorder_layout.count == 0)
+		return;
+
+	recorder_record_max = sizeof(uint32_t);
+	for (uint32_t i = 0; i < recorder_layout.count; i++)
+	{
+		recorder_record_max += recorder_layout.size[i];
+	}
+	if (recorder_record_max > FLIGHT_RECORDER_CHUNK_SIZE - sizeof(struct flight_recorder_chunk))
+	{
+		LOG_ERR("flight recorder: trace record of %u bytes exceeds chunk size", recorder_record_max);
+		return;
+	}
+
+	fs_file_t_init(&recorder_file);
+	int ret = fs_open(&recorder_file, FLIGHT_RECORDER_FILE, FS_O_CREATE | FS_O_RDWR);
+	if (ret < 0)
+	{
+		LOG_ERR("flight recorder: failed to open %s (%d)", FLIGHT_RECORDER_FILE, ret);
+		return;
+	}
+	recorder_open = true;
+
+	// The header takes the first chunk, so all data chunks are aligned to the chunk size
+	memset(recorder_chunk, 0, FLIGHT_RECORDER_CHUNK_SIZE);
+	header->magic = FLIGHT_RECORDER_MAGIC;
+	header->version = FLIGHT_RECORDER_VERSION;
+	header->header_size = sizeof(struct flight_recorder_header);
+	header->chunk_size = FLIGHT_RECORDER_CHUNK_SIZE;
+	header->chunk_count = FLIGHT_RECORDER_CHUNK_COUNT;
+	memcpy(&header->layout, &recorder_layout, sizeof(recorder_layout));
+
+	ret = fs_truncate(&recorder_file, 0);
+	if (ret == 0)
+	{
+		ret = fs_seek(&recorder_file, 0, FS_SEEK_SET);
+	}
+	if (ret == 0)
+	{
+		ret = fs_write(&recorder_file, recorder_chunk, FLIGHT_RECORDER_CHUNK_SIZE);
+		ret = (ret == FLIGHT_RECORDER_CHUNK_SIZE) ? fs_sync(&recorder_file) : -EIO;
+	}
+	if (ret < 0)
+	{
+		LOG_ERR("flight recorder: failed to write header (%d)", ret);
+		fs_close(&recorder_file);
+		recorder_open = false;
+		return;
+	}
+
+	recorder_next_chunk(1);
+	recorder_dirty = false;
+	recorder_last_write = k_uptime_get();
+	LOG_INF("flight recorder: recording %u variables to %s", recorder_layout.count, FLIGHT_RECORDER_FILE);
+}
+
+/****************************************************************************************************************************************
+ * @brief                recorder_drain
+ *                       Moves the published trace records into the chunk buffer. Full chunks are written at once,
+ *                       a partially filled chunk after FLIGHT_RECORDER_FLUSH_PERIOD, so the file sees few large
+ *                       sequential writes.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+static void recorder_drain(void)
+{
+	struct flight_recorder_chunk *chunk = (struct flight_recorder_chunk *)recorder_chunk;
+	size_t payload_size = FLIGHT_RECORDER_CHUNK_SIZE - sizeof(struct flight_recorder_chunk);
+	uint32_t token = recorder_layout.token;
+	uint32_t records;
+	size_t size;
+
+	if (!recorder_open) // Nothing to record to, only watch for a new trace layout
+	{
+		plc_debug_drain_trace(recorder_chunk, 0, &recorder_layout, &records);
+		if (recorder_layout.token != token)
+		{
+			recorder_start();
+		}
+		return;
+	}
+
+	do
+	{
+		uint8_t *payload = recorder_chunk + sizeof(struct flight_recorder_chunk);
+
+		size = plc_debug_drain_trace(payload + chunk->used, payload_size - chunk->used, &recorder_layout, &records);
+		if (recorder_layout.token != token)
+		{
+			recorder_start(); // The records of the old layout were written by recorder_close
+			return;
+		}
+		if (size > 0)
+		{
+			chunk->used += size;
+			chunk->records += records;
+			recorder_dirty = true;
+		}
+
+		if (payload_size - chunk->used < recorder_record_max)
+		{
+			recorder_write_chunk();
+			recorder_next_chunk(chunk->seq + 1);
+		}
+	} while (size > 0);
+
+	if (recorder_dirty && ((k_uptime_get() - recorder_last_write) >= FLIGHT_RECORDER_FLUSH_PERIOD))
+	{
+		recorder_write_chunk();
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                flight_recorder_lock
+ *                       Writes pending records and keeps the recorder from changing the file, e.g. while the file is
+ *                       downloaded. Samples are kept in the trace buffer meanwhile.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+void flight_recorder_lock(void)
+{
+	k_mutex_lock(&flight_recorder_mutex, K_FOREVER);
+	if (recorder_open && recorder_dirty)
+	{
+		recorder_write_chunk();
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief                flight_recorder_unlock
+ *                       Lets the recorder continue after flight_recorder_lock.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+void flight_recorder_unlock(void) { k_mutex_unlock(&flight_recorder_mutex); }
+
+/****************************************************************************************************************************************
+ * @brief                flight_recorder_thread
+ *                       Drains trace_samples into the recording file while the flight recorder is enabled and no IDE
+ *                       fetches the samples. Keeps the debug thread running, so the history doesn't end when the
+ *                       IDE disconnects.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+#define FLIGHT_RECORDER_STACK_SIZE 1536
+#define FLIGHT_RECORDER_PRIORITY 7
+
+void flight_recorder_thread(void *, void *, void *)
+{
+	recorder_layout.token = 0;
+	recorder_layout.count = 0;
+
+	while (true)
+	{
+		k_msleep(FLIGHT_RECORDER_PERIOD);
+
+		k_mutex_lock(&flight_recorder_mutex, K_FOREVER);
+		if (!get_flight_recorder_setting())
+		{
+			recorder_close();
+			recorder_layout.token = 0; // Start a new recording when enabled again
+		}
+		else
+		{
+			if (plc_run && (debug_thread_state == 0) && (traced_vars_count > 0))
+			{
+				plc_debug_thread_start(); // Publish samples without IDE
+			}
+			if (!plc_debug_host_attached()) // The IDE consumes the samples while it is attached
+			{
+				recorder_drain();
+			}
+		}
+		k_mutex_unlock(&flight_recorder_mutex);
+	}
+}
+
+K_THREAD_DEFINE_CCM(flight_recorder, FLIGHT_RECORDER_STACK_SIZE, flight_recorder_thread, NULL, NULL, NULL, FLIGHT_RECORDER_PRIORITY, 0, PLC_TASK_STARTUP_DELAY);
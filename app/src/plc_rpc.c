@@ -22,8 +22,12 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(plc_rpc, LOG_LEVEL_DBG);
 
+#include <errno.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
 
 #include <mbedtls/md5.h>
 #include <zephyr/fs/fs.h>
@@ -36,15 +40,21 @@ LOG_MODULE_REGISTER(plc_rpc, LOG_LEVEL_DBG);
 #include "erpc_PLCObject_common.h"
 #include "erpc_error_handler.h"
 #include "erpc_server_setup.h"
-#include "erpc_transport_setup.h"
 
 #include "config.h"
+#include "plc_blobstore.h"
+#include "plc_compress.h"
 #include "plc_filesys.h"
 #include "plc_loader.h"
+#include "plc_patch.h"
 #include "plc_rpc.h"
+#include "plc_rpc_session.h"
+#include "plc_settings.h"
+#include "plc_upload.h"
+#include "plc_www_bundle.h"
 
-mbedtls_md5_context complete_ctx;  					// md5 context over all received chunks
-mbedtls_md5_context temporary_ctx; 					// md5 context for actual chunk
+mbedtls_md5_context complete_ctx;  					// md5 context over all received chunks, without TRANSFER_ENCODING_UPLOAD_HANDLE
+mbedtls_md5_context temporary_ctx; 					// md5 context for the blobID after each chunk
 
 extern uint32_t plc_run; 
 
@@ -53,7 +63,13 @@ uint16_t erpc_port = ERPC_SERVER_PORT;
 struct file_upload file_uploads[MAX_FILE_UPLOADS]; 	// File uploads
 int num_uploads = 0;							   	
 
+static uint32_t upload_encodings = 0;				// transfer encodings of the current upload
+static __ccm_noinit_section struct lzss_decoder upload_decoder;
+struct compress_stats upload_compress_stats;
+static uint32_t upload_sink_cycles;				// cycles spent behind the decoder, not counted as codec cost
+
 int rpc_connection_active = 0;
+K_MUTEX_DEFINE(rpc_state_mutex);					// Serializes the calls that change blob or plc state across sessions
 extern uint32_t reload_plc_file;
 
 extern int32_t plc_logCounts[];
@@ -61,11 +77,56 @@ extern int32_t plc_logCounts[];
 /***************************************************************************************************************************************/
 /*		rpc server thread																								     		   */
 /***************************************************************************************************************************************/
-#define RPC_SERVER_STACK_SIZE 4096
+#define RPC_SERVER_STACK_SIZE 2048
 #define RPC_SERVER_PRIORITY 5
 extern void rpc_server_task(void *, void *, void *);
 K_THREAD_DEFINE_CCM(rpc_server, RPC_SERVER_STACK_SIZE, rpc_server_task, NULL, NULL, NULL, RPC_SERVER_PRIORITY, 0, RPC_SERVER_STARTUP_DELAY);
 
+// session workers, started by the rpc server thread
+#define RPC_SESSION_STACK_SIZE 4096
+#define RPC_SESSION_PRIORITY 5
+Z_KERNEL_STACK_ARRAY_DEFINE_IN(rpc_session_stacks, RPC_SESSION_COUNT, RPC_SESSION_STACK_SIZE, __ccm_noinit_section);
+struct k_thread rpc_session_threads[RPC_SESSION_COUNT];
+__ccm_noinit_section struct rpc_session rpc_sessions[RPC_SESSION_COUNT];
+
+// accepted connection waiting for a free session worker
+struct rpc_connection
+{
+	int fd;
+	struct sockaddr_in peer;
+};
+K_MSGQ_DEFINE(rpc_connection_queue, sizeof(struct rpc_connection), RPC_SESSION_COUNT, 4);
+
+/****************************************************************************************************************************************
+ * @brief 			Finds the session served by the calling thread.
+ *
+ * @return 			Pointer to the session, or NULL if not called from a session worker.
+ ****************************************************************************************************************************************/
+static struct rpc_session *rpc_current_session(void)
+{
+	k_tid_t thread = k_current_get();
+
+	for (int i = 0; i < RPC_SESSION_COUNT; i++)
+	{
+		if (thread == &rpc_session_threads[i])
+		{
+			return &rpc_sessions[i];
+		}
+	}
+	return NULL;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Gets the transfer encodings negotiated by the calling session.
+ *
+ * @return 			TRANSFER_ENCODING_* flags, 0 outside of a session.
+ ****************************************************************************************************************************************/
+uint32_t rpc_session_encodings(void)
+{
+	struct rpc_session *session = rpc_current_session();
+	return (session != NULL) ? session->encodings : 0;
+}
+
 /***************************************************************************************************************************************/
 /*		common plc rpc functions from plcObject																				 		   */
 /***************************************************************************************************************************************/
@@ -92,6 +153,29 @@ uint32_t GetPLCID(PSKID *plcID)
 	return 0;
 }
 
+/****************************************************************************************************************************************
+ * @brief 			Negotiates the transfer encodings of the calling session.
+ * 					The client requests the encodings it can handle, the reply holds the subset the device supports. The
+ * 					encodings stay in effect until the next call or the end of the connection, see plc_compress.h.
+ *
+ * @param requested	Requested TRANSFER_ENCODING_* flags.
+ * @param accepted 	Pointer to receive the accepted flags.
+ * @return 			Returns 0 on success, 1 if not called from a session.
+ ****************************************************************************************************************************************/
+uint32_t SetTransferEncoding(uint32_t requested, uint32_t *accepted)
+{
+	struct rpc_session *session = rpc_current_session();
+	if (session == NULL)
+	{
+		return 1;
+	}
+
+	session->encodings = requested & TRANSFER_ENCODINGS_SUPPORTED;
+	*accepted = session->encodings;
+	LOG_INF("Session %u: transfer encodings 0x%x", session->id, session->encodings);
+	return 0;
+}
+
 /****************************************************************************************************************************************
  * @brief 			Gets the current status of the PLC.
  * 					Determines the PLC's status by checking its state and loader state, then stores this status in the provided structure.
@@ -228,7 +312,7 @@ uint32_t RepairPLC(void)
 
 /****************************************************************************************************************************************
  * @brief 			Initializes a file upload structure.
- * 					Sets the filename, blobID data, and blobID data length to initial values and the file pointer to NULL.
+ * 					Sets the filename, blobID data, and blobID data length to initial values and marks the upload as closed.
  *
  * @param fu 		Pointer to a file_upload structure to be initialized.
  * @return 			None.
@@ -238,7 +322,11 @@ void init_file_upload(struct file_upload *fu)
 	memset(fu->filename, 0, sizeof(fu->filename));		 
 	memset(fu->blobID.data, 0, sizeof(fu->blobID.data)); 
 	fu->blobID.dataLength = 0;							 
-	fu->file_pointer = NULL;							
+	fu->open = false;
+	fu->flash_slot = -1;
+	fu->patch = false;
+	fu->patch_valid = false;
+	fu->size = 0;
 }
 
 /****************************************************************************************************************************************
@@ -257,14 +345,14 @@ void init_file_uploads()
 
 /****************************************************************************************************************************************
  * @brief 			Adds a new file upload to the uploads list.
- * 					Saves the filename, blobID, and file pointer for a new file upload in the next available slot in the file_uploads array.
+ * 					Saves the filename and blobID for a new open file upload in the next available slot in the file_uploads array. The
+ * 					file is created when the first chunk is appended.
  *
  * @param filename 	The name of the file being uploaded.
  * @param blobID 	Pointer to the blobID associated with the file.
- * @param file_pointer The file pointer to the file being uploaded.
  * @return 			None.
  ****************************************************************************************************************************************/
-void add_file_upload(char *filename, struct binary_t *blobID, FILE *file_pointer)
+void add_file_upload(char *filename, struct binary_t *blobID)
 {
 	if (num_uploads < MAX_FILE_UPLOADS)
 	{
@@ -272,7 +360,11 @@ void add_file_upload(char *filename, struct binary_t *blobID, FILE *file_pointer
 		file_uploads[num_uploads].filename[32] = '\0';
 		memcpy(file_uploads[num_uploads].blobID.data, blobID->data, blobID->dataLength);
 		file_uploads[num_uploads].blobID.dataLength = blobID->dataLength;
-		file_uploads[num_uploads].file_pointer = file_pointer;
+		file_uploads[num_uploads].open = true;
+		file_uploads[num_uploads].flash_slot = -1;
+		file_uploads[num_uploads].patch = false;
+		file_uploads[num_uploads].patch_valid = false;
+		file_uploads[num_uploads].size = 0;
 		num_uploads++;
 	}
 }
@@ -294,41 +386,35 @@ void update_last_blobID(const struct binary_t *blobID)
 }
 
 /****************************************************************************************************************************************
- * @brief 			Retrieves the filename associated with a given blobID.
- * 					Searches the file uploads list for a matching blobID and returns the associated filename.
+ * @brief 			Retrieves the file upload associated with a given blobID.
+ * 					Searches the file uploads list for a matching blobID.
  *
- * @param blobID 	Pointer to the blobID structure used to find the corresponding filename.
- * @return 			Returns the filename associated with the given blobID or NULL if not found.
+ * @param blobID 	Pointer to the blobID structure used to find the corresponding file upload.
+ * @return 			Returns the file upload associated with the given blobID or NULL if not found.
  ****************************************************************************************************************************************/
-char *get_filename_from_blobID(const struct binary_t *blobID)
+struct file_upload *get_upload_from_blobID(const struct binary_t *blobID)
 {
 	for (int i = 0; i < num_uploads; i++)
 	{
 		if (memcmp(&file_uploads[i].blobID.data, blobID->data, blobID->dataLength) == 0 && file_uploads[i].blobID.dataLength == blobID->dataLength)
 		{
-			return file_uploads[i].filename;
+			return &file_uploads[i];
 		}
 	}
 	return NULL;
 }
 
 /****************************************************************************************************************************************
- * @brief 			Retrieves the file pointer associated with a given blobID.
- * 					Searches the file uploads list for a matching blobID and returns the associated file pointer.
+ * @brief 			Retrieves the filename associated with a given blobID.
+ * 					Searches the file uploads list for a matching blobID and returns the associated filename.
  *
- * @param blobID 	Pointer to the blobID structure used to find the corresponding file pointer.
- * @return 			Returns the file pointer associated with the given blobID or NULL if not found.
+ * @param blobID 	Pointer to the blobID structure used to find the corresponding filename.
+ * @return 			Returns the filename associated with the given blobID or NULL if not found.
  ****************************************************************************************************************************************/
-FILE *get_file_pointer_from_blobID(const struct binary_t *blobID)
+char *get_filename_from_blobID(const struct binary_t *blobID)
 {
-	for (int i = 0; i < num_uploads; i++)
-	{
-		if (memcmp(file_uploads[i].blobID.data, blobID->data, blobID->dataLength) == 0 && file_uploads[i].blobID.dataLength == blobID->dataLength)
-		{
-			return file_uploads[i].file_pointer;
-		}
-	}
-	return NULL; // Datei nicht gefunden
+	struct file_upload *upload = get_upload_from_blobID(blobID);
+	return (upload != NULL) ? upload->filename : NULL;
 }
 
 /****************************************************************************************************************************************
@@ -350,19 +436,12 @@ struct blob_t get_last_blobID()
 }
 
 /****************************************************************************************************************************************
- * @brief 			Checks if the last file pointer in the uploads list is valid.
- * 					Verifies whether the file pointer of the most recent file upload entry is not NULL, indicating an ongoing file upload.
+ * @brief 			Checks if the last file upload in the uploads list is still open.
+ * 					Only the most recent file upload can be open, chunks are always appended to it.
  *
- * @return 			Returns the file pointer if valid, otherwise NULL.
+ * @return 			Returns true if there is an ongoing file upload, otherwise false.
  ****************************************************************************************************************************************/
-FILE *is_last_file_pointer_valid()
-{
-	if (num_uploads > 0 && file_uploads[num_uploads - 1].file_pointer != NULL)
-	{
-		return file_uploads[num_uploads - 1].file_pointer;
-	}
-	return NULL;
-}
+bool is_last_upload_open() { return num_uploads > 0 && file_uploads[num_uploads - 1].open; }
 
 /****************************************************************************************************************************************
  * @brief 			Generates a random filename for a temporary file.
@@ -416,24 +495,115 @@ binary_t blob_to_binary(struct blob_t blob)
 }
 
 /****************************************************************************************************************************************
- * @brief 		Finalizes the upload process for a file.
- * 				Closes the file associated with the given blobID and updates the blobID in the file uploads list.
+ * @brief 		Finalizes the upload process for the current file.
+ * 				Queues the remaining data of the ongoing file upload and closes the file, the storage worker writes it in the
+ * 				background. An upload without chunks is created as empty file, a patched plc module is checked.
  *
- * @param blobID Pointer to the blobID of the file to finalize.
- * @return 		Returns 0 on success, 1 if the file pointer is NULL or the file cannot be closed.
+ * @return 		Returns 0 on success, 1 if there is no ongoing file upload.
  ****************************************************************************************************************************************/
-uint32_t finish_fileUpload(const binary_t *blobID)
+uint32_t finish_fileUpload(void)
 {
-	update_last_blobID(blobID); // update the last blobID for file
-	FILE *fp = get_file_pointer_from_blobID(blobID);
-	if (fp != NULL)
+	if (is_last_upload_open())
 	{
-		fclose(fp);
+		if (file_uploads[num_uploads - 1].size == 0)
+		{
+			upload_open(file_uploads[num_uploads - 1].filename);
+		}
+		if (file_uploads[num_uploads - 1].patch)
+		{
+			file_uploads[num_uploads - 1].patch_valid = (module_patch_end() == 0);
+		}
+		upload_close();
+		upload_hash_end(); // the storage worker finishes the blobID of a TRANSFER_ENCODING_UPLOAD_HANDLE upload
+		file_uploads[num_uploads - 1].open = false;
 		return 0;
 	}
 	return 1;
 }
 
+/****************************************************************************************************************************************
+ * @brief 		Starts writing the current file upload with its first chunk.
+ * 				A plc module, recognized by the udynlink signature, is streamed into an inactive flash slot while the plc is
+ * 				stopped. Other files, or a plc module while no flash slot is free, are written to the temporary file, so the
+ * 				installed module is kept until NewPLC succeeds. If the session negotiated
+ * 				TRANSFER_ENCODING_MODULE_PATCH a module patch is applied to the stored module and the result is written instead.
+ *
+ * @param upload Pointer to the current file upload.
+ * @param data	Pointer to the first data of the file.
+ * @param length Length of the data.
+ * @return 		Returns 0 on success, other values if the file cannot be created.
+ ****************************************************************************************************************************************/
+static int start_fileUpload(struct file_upload *upload, const uint8_t *data, size_t length)
+{
+	uint32_t sign = 0;
+	int slot = -1;
+
+	if (length >= sizeof(file_header_t))
+	{
+		memcpy(&sign, data, sizeof(sign));
+	}
+	if ((sign == MODULE_PATCH_SIGN) && (upload_encodings & TRANSFER_ENCODING_MODULE_PATCH))
+	{
+		int ret = module_patch_begin(); // the stored module is read before another slot is chosen
+		if (ret != 0)
+		{
+			return ret;
+		}
+		upload->patch = true;
+	}
+	if ((sign == SIGN) || upload->patch)
+	{
+		slot = plc_flash_inactive_slot();
+	}
+
+	if (slot >= 0)
+	{
+		LOG_INF("streaming plc module to flash slot %d", slot);
+		upload->flash_slot = slot;
+		return upload_open_flash(plc_flash_slot_area(slot));
+	}
+	return upload_open(upload->filename);
+}
+
+/****************************************************************************************************************************************
+ * @brief 		Appends data to the current file upload and to the md5 over all chunks.
+ * 				Used directly for plain chunks and as sink of the decoder for compressed chunks, the md5 and thereby the
+ * 				blobIDs are always calculated over the uncompressed file. The data of a module patch is applied, not written.
+ * 				With TRANSFER_ENCODING_UPLOAD_HANDLE the storage worker calculates the md5 over the written data instead.
+ *
+ * @param data	Pointer to the data.
+ * @param length Length of the data.
+ * @param arg	Pointer to the current file upload.
+ * @return 		Returns 0 on success, 3 if the file cannot be created and 4 if the data cannot be written.
+ ****************************************************************************************************************************************/
+static int append_fileUpload(const uint8_t *data, size_t length, void *arg)
+{
+	struct file_upload *upload = arg;
+	uint32_t start = k_cycle_get_32();
+
+	if ((upload->size == 0) && (start_fileUpload(upload, data, length) != 0))
+	{
+		LOG_ERR("Failed to open file");
+		return 3; // Error: Failed to open file
+	}
+
+	// Queue data for the storage worker, a failed write of an earlier chunk is reported here
+	int err = upload->patch ? module_patch_write(data, length) : upload_write(data, length);
+	if (err != 0)
+	{
+		LOG_ERR("Failed to write %u bytes to file: %d", length, err);
+		return 4; // Error: Failed to write data to file
+	}
+	upload->size += length;
+	if (!(upload_encodings & TRANSFER_ENCODING_UPLOAD_HANDLE))
+	{
+		mbedtls_md5_update(&complete_ctx, data, length);
+	}
+
+	upload_sink_cycles += k_cycle_get_32() - start;
+	return 0;
+}
+
 /****************************************************************************************************************************************
  * @brief 		Updates the blobID for the current file upload.
  * 				Updates the blobID of the most recent file upload entry with a new blobID.
@@ -445,7 +615,8 @@ void update_fileUpload(binary_t *blobID) { update_last_blobID(blobID); }
 
 /****************************************************************************************************************************************
  * @brief 		Prepares for a new file upload by checking and finalizing any ongoing upload.
- * 				Finalizes any ongoing file upload and starts a new upload process by generating a random filename and opening a new file.
+ * 				Finalizes any ongoing file upload and starts a new upload process by generating a random filename and opening a new file
+ * 				in the storage worker.
  *
  * @param blobID Pointer to the blobID for the new file upload.
  * @return 		Returns 0 on success, other error codes for specific failures.
@@ -454,18 +625,10 @@ uint32_t prepare_fileUpload(binary_t *blobID)
 {
 	char filename[33] = {0};
 
-	FILE *fp = is_last_file_pointer_valid(); // check if there is actually a file upload
-	if (fp != NULL)
-	{
-		struct blob_t lastBlobID = get_last_blobID();
-		binary_t lastBlob = blob_to_binary(lastBlobID);
-		finish_fileUpload(&lastBlob); // finish the last upload before starting new
-		k_free(lastBlob.data);
-	}
+	finish_fileUpload(); // finish the last upload before starting new
 
 	generate_random_filename(filename, TMP_FILE_PATH); // begin new file upload
-	fp = fopen(filename, "wb");
-	add_file_upload(filename, blobID, fp); // add upload to upload list
+	add_file_upload(filename, blobID);				   // add upload to upload list, the file is created with the first chunk
 	return 0;
 }
 
@@ -518,7 +681,7 @@ void delete_tmp_files(const char *directory)
 /****************************************************************************************************************************************
  * @brief 	Deletes all old file blobs and reinitializes the file uploads array.
  * 			This function is called to clear out any old file blobs from the temporary file directory and to reinitialize the file uploads
- * 			array, effectively resetting the file upload environment.
+ * 			array, effectively resetting the file upload environment. An ongoing upload is closed and a previous write error cleared.
  *
  * @return Returns 0 on success.
  ****************************************************************************************************************************************/
@@ -526,15 +689,45 @@ uint32_t PurgeBlobs(void)
 {
 	LOG_INF("starting file upload");
 	uint32_t result = 0;
+	upload_reset();
 	delete_tmp_files(TMP_FILE_PATH);
 	init_file_uploads();
 	return result;
 }
 
+/****************************************************************************************************************************************
+ * @brief 	Reports which blobs are already stored on the PLC.
+ * 			Extra files installed by a previous NewPLC are kept with their md5 blobID. The client only has to upload the missing blobs
+ * 			and can pass the blobID of a stored blob to NewPLC directly.
+ *
+ * @param blobIDs Pointer to the list of blobIDs to check.
+ * @param present Pointer to a list receiving true for each stored blob.
+ * @return Returns 0 on success, 1 on memory allocation failure.
+ ****************************************************************************************************************************************/
+uint32_t QueryBlobs(const list_binary_1_t *blobIDs, list_bool_1_t *present)
+{
+	upload_sync(); // blobIDs calculated by the storage worker are final
+	present->elementsCount = 0;
+	present->elements = (bool *)k_malloc(blobIDs->elementsCount * sizeof(bool));
+	if ((present->elements == NULL) && (blobIDs->elementsCount > 0))
+	{
+		LOG_ERR("QueryBlobs Memory allocation failed");
+		return 1; // Error: Memory allocation failed
+	}
+
+	for (uint32_t i = 0; i < blobIDs->elementsCount; i++)
+	{
+		present->elements[i] = (get_upload_from_blobID(&blobIDs->elements[i]) != NULL) || blob_store_lookup(&blobIDs->elements[i], NULL, 0);
+	}
+	present->elementsCount = blobIDs->elementsCount;
+	return 0;
+}
+
 /****************************************************************************************************************************************
  * @brief 	Starts the file upload process by initializing MD5 contexts and preparing for file upload.
  * 			Initializes the MD5 contexts for a complete file and for the current chunk. Also, prepares for a new file upload by allocating
- * 			memory for the blobID and setting up the file upload infrastructure.
+ * 			memory for the blobID and setting up the file upload infrastructure. If the session negotiated TRANSFER_ENCODING_UPLOAD_HANDLE
+ * 			the md5 over the seed and the file is calculated by the storage worker, the returned blobID is the handle of the upload.
  *
  * @param seed Pointer to the initial data chunk (seed) for the file being uploaded.
  * @param blobID Pointer to a structure where the blobID for the new file will be stored.
@@ -566,14 +759,25 @@ uint32_t SeedBlob(const binary_t *seed, binary_t *blobID)
 	mbedtls_md5_finish(&temporary_ctx, blobID->data);
 	blobID->dataLength = 16;
 
+	// The encoding is fixed for the whole upload, the seed itself is never compressed
+	upload_encodings = rpc_session_encodings();
+	lzss_decoder_reset(&upload_decoder);
+
 	prepare_fileUpload(blobID);
+	if ((upload_encodings & TRANSFER_ENCODING_UPLOAD_HANDLE) && is_last_upload_open())
+	{
+		upload_hash_begin(seed->data, seed->dataLength, file_uploads[num_uploads - 1].blobID.data);
+	}
 	return result;
 }
 
 /****************************************************************************************************************************************
  * @brief 	Appends a data chunk to the current file blob and updates the MD5 hash.
- * 			This function updates the complete file's MD5 context with the new data chunk, calculates the new MD5 hash, writes the data to
- * 			the file, and updates the file upload list with the new blobID.
+ * 			This function updates the complete file's MD5 context with the new data chunk, calculates the new MD5 hash, hands the data to
+ * 			the storage worker, and updates the file upload list with the new blobID. The data is written to the file while the next
+ * 			chunk is received. If the session negotiated TRANSFER_ENCODING_UPLOAD_LZSS every chunk is a complete heatshrink stream
+ * 			that is decoded on the fly, the blobIDs stay the md5 of the uncompressed data. With TRANSFER_ENCODING_UPLOAD_HANDLE the chunk
+ * 			is not hashed here, newBlobID is the unchanged handle and the md5 is calculated by the storage worker next to the write.
  *
  * @param data Pointer to the data chunk being uploaded.
  * @param blobID Pointer to the current blobID associated with the file.
@@ -591,6 +795,13 @@ uint32_t AppendChunkToBlob(const binary_t *data, const binary_t *blobID, binary_
 		return 2; // Error: Invalid parameters
 	}
 
+	struct blob_t lastBlobID = get_last_blobID();
+	if (!is_last_upload_open() || lastBlobID.dataLength != blobID->dataLength || memcmp(lastBlobID.data, blobID->data, blobID->dataLength))
+	{
+		LOG_ERR("No file upload for blobID");
+		return 3; // Error: Chunk does not belong to the ongoing upload
+	}
+
 	// Allocate memory for newBlobID
 	newBlobID->data = k_malloc(16); // Allocate memory for MD5 hash (16 bytes)
 	if (newBlobID->data == NULL)
@@ -599,37 +810,58 @@ uint32_t AppendChunkToBlob(const binary_t *data, const binary_t *blobID, binary_
 		return 1; // Error: Memory allocation failed
 	}
 
-	// Calculate MD5 hash of the concatenated data
-	mbedtls_md5_update(&complete_ctx, data->data, data->dataLength);
-	memcpy(&temporary_ctx, &complete_ctx, sizeof(mbedtls_md5_context));
-	mbedtls_md5_finish(&temporary_ctx, actual_md5);
-	memcpy(newBlobID->data, actual_md5, 16); // copy md5 hash
-	newBlobID->dataLength = 16;				 // MD5 produces a 128-bit hash (16 bytes)
-	update_fileUpload(newBlobID);
+	struct file_upload *upload = &file_uploads[num_uploads - 1];
+	int err;
+	if (upload_encodings & TRANSFER_ENCODING_UPLOAD_LZSS)
+	{
+		uint32_t size = upload->size;
+		uint32_t start = k_cycle_get_32();
+		upload_sink_cycles = 0;
+
+		err = lzss_decode(&upload_decoder, data->data, data->dataLength, append_fileUpload, upload);
+		if (err == 0)
+		{
+			err = lzss_decode_finish(&upload_decoder, append_fileUpload, upload);
+		}
+		else
+		{
+			lzss_decoder_reset(&upload_decoder);
+		}
 
-	// Write data to file
-	FILE *file = get_file_pointer_from_blobID(newBlobID);
-	if (file == NULL)
+		upload_compress_stats.raw_bytes += upload->size - size;
+		upload_compress_stats.coded_bytes += data->dataLength;
+		upload_compress_stats.cycles += (k_cycle_get_32() - start) - upload_sink_cycles;
+	}
+	else
 	{
-		LOG_ERR("Failed to open file");
-		return 3; // Error: Failed to open file
+		err = append_fileUpload(data->data, data->dataLength, upload);
 	}
-	size_t bytesWritten = fwrite(data->data, sizeof(uint8_t), data->dataLength, file);
-	if (bytesWritten != data->dataLength)
+	if (err != 0)
 	{
-		LOG_ERR("Failed to write %u bytes to file #%u (wrote %u)", data->dataLength, file->_file, bytesWritten);
-		return 4; // Error: Failed to write data to file
+		return err;
+	}
+
+	if (upload_encodings & TRANSFER_ENCODING_UPLOAD_HANDLE)
+	{
+		memcpy(newBlobID->data, blobID->data, 16); // the handle stays valid until the upload is finished
+		newBlobID->dataLength = 16;
+		return result;
 	}
-	// LOG_INF("write 0x%03x bytes to file #%u ", bytesWritten, file->_file, bytesWritten);
-	fflush(file);
-	// LOG_INF("flushed file #%u", file->_file);
+
+	// Calculate MD5 hash of the concatenated data, the host checks each intermediate hash, it is finished on a copy of the context
+	mbedtls_md5_clone(&temporary_ctx, &complete_ctx);
+	mbedtls_md5_finish(&temporary_ctx, actual_md5);
+	memcpy(newBlobID->data, actual_md5, 16); // copy md5 hash
+	newBlobID->dataLength = 16;				 // MD5 produces a 128-bit hash (16 bytes)
+	update_fileUpload(newBlobID);
 	return result;
 }
 
 /****************************************************************************************************************************************
  * @brief 	Finalizes the PLC file upload and verifies the file integrity using MD5 checksum.
- * 			Finishes the file upload process by comparing the final MD5 checksum of the uploaded file against the provided checksum. If the
- * 			checksums match, it proceeds to update the PLC program with the uploaded file.
+ * 			Finishes the file upload process and waits until the storage worker has written all files, the only sync of the whole
+ * 			transfer. The blobID of each file is the MD5 checksum calculated during its upload, so the PLC object is valid if its
+ * 			blobID is found in the upload list. The sync also waits for the blobIDs calculated by the storage worker. It then proceeds to update the PLC program with the uploaded file.
  *
  * @param md5sum The expected MD5 checksum of the complete file.
  * @param plcObjectBlobID Pointer to the blobID of the uploaded PLC object file.
@@ -640,57 +872,75 @@ uint32_t AppendChunkToBlob(const binary_t *data, const binary_t *blobID, binary_
 uint32_t NewPLC(const char *md5sum, const binary_t *plcObjectBlobID, const list_extra_file_1_t *extrafiles, bool *success)
 {
 	// LOG_INF("NewPLC");
-	uint8_t file_md5[16];
 	struct fs_dirent dirent;
-	struct fs_file_t file;
-	fs_file_t_init(&file);
 
-	finish_fileUpload(plcObjectBlobID);										  // finish the upload
-	mbedtls_md5_finish(&complete_ctx, file_md5);							  // get final md5sum
-	if (memcmp(file_md5, plcObjectBlobID->data, plcObjectBlobID->dataLength)) // compare with md5 calculated from upload
+	finish_fileUpload(); // finish the upload
+	if (upload_sync() != 0)
+	{
+		LOG_ERR("file upload error, writing files failed");
+		*success = false;
+		return 0;
+	}
+
+	struct file_upload *plc_upload = get_upload_from_blobID(plcObjectBlobID); // blobID is the md5 calculated from upload
+	if (plc_upload == NULL)
 	{
 		LOG_ERR("md5 mismatch, file upload error");
 		*success = false;
 		return 0;
 	}
+	else if (plc_upload->patch && !plc_upload->patch_valid)
+	{
+		LOG_ERR("plc module patch invalid");
+		*success = false;
+		return 0;
+	}
 	else
 	{
 		LOG_INF("md5 match, file uploaded succesfull");
 		plc_run = 0;
 
-		char *plc_tmp_file = get_filename_from_blobID(plcObjectBlobID);
-
 		int rc = fs_stat(PLC_MD5_FILE, &dirent);
-		if (rc == 0)
-			fs_unlink(PLC_BIN_FILE); // remove PLC_BIN_FILE
-
-		if (fs_rename(plc_tmp_file, PLC_BIN_FILE) == 0)
+		if (plc_upload->flash_slot >= 0) // plc module was streamed to flash and checked, only switch the slot
 		{
-			; // LOG_INF("set uploaded file %s as plc start file %s", plc_tmp_file, PLC_BIN_FILE);
+			if (fs_stat(PLC_BIN_FILE, &dirent) == 0)
+				fs_unlink(PLC_BIN_FILE); // remove outdated PLC_BIN_FILE
+			plc_flash_activate_slot(plc_upload->flash_slot);
 		}
 		else
 		{
-			LOG_ERR("cant set uploaded file %s as plc start file %s", plc_tmp_file, PLC_BIN_FILE);
+			char *plc_tmp_file = plc_upload->filename;
+			if (rc == 0)
+				fs_unlink(PLC_BIN_FILE); // remove PLC_BIN_FILE
+
+			if (fs_rename(plc_tmp_file, PLC_BIN_FILE) == 0)
+			{
+				if (get_plc_flash_slot_setting() >= 0)
+					plc_flash_activate_slot(-1); // load PLC_BIN_FILE again
+			}
+			else
+			{
+				LOG_ERR("cant set uploaded file %s as plc start file %s", plc_tmp_file, PLC_BIN_FILE);
+			}
 		}
 
 		// LOG_INF("Extra Files: %u", extrafiles->elementsCount);
 		for (uint32_t i = 0; i < extrafiles->elementsCount; ++i)
 		{
-			binary_t extra_files_blob;
-			char ex_file_name[48] = {0};
-			extra_files_blob.data = NULL;
-			extra_files_blob.data = (uint8_t *)k_malloc(extrafiles->elements[i].blobID.dataLength);
-			if (extra_files_blob.data == NULL)
+			const binary_t *extra_files_blob = &extrafiles->elements[i].blobID;
+			char ex_file_name[BLOB_STORE_PATH_SIZE] = {0};
+			char stored_file_name[BLOB_STORE_PATH_SIZE];
+
+			// precompressed variants like index.html.gz go to the web files, too
+			char baseName[BLOB_STORE_PATH_SIZE];
+			strncpy(baseName, extrafiles->elements[i].fname, sizeof(baseName) - 1);
+			baseName[sizeof(baseName) - 1] = '\0';
+			char *fileExtension = strrchr(baseName, '.');
+			if (fileExtension && strcmp(fileExtension, ".gz") == 0)
 			{
-				LOG_ERR("error allocating memory for extra_files");
-				*success = false;
-				return 0;
+				*fileExtension = '\0';
+				fileExtension = strrchr(baseName, '.');
 			}
-
-			extra_files_blob = extrafiles->elements[i].blobID;
-			char *ex_tmp_file = get_filename_from_blobID(&extra_files_blob);
-
-			const char *fileExtension = strrchr(extrafiles->elements[i].fname, '.');
 			bool isWebFile = fileExtension &&
 							 (strcmp(fileExtension, ".htm") == 0 || 
 							 strcmp(fileExtension, ".html") == 0 || 
@@ -698,16 +948,39 @@ uint32_t NewPLC(const char *md5sum, const binary_t *plcObjectBlobID, const list_
 							 strcmp(fileExtension, ".json") == 0 || 
 							 strcmp(fileExtension, ".css") == 0);
 
-			const char *destinationPath = isWebFile ? HTTP_ROOT "/" : PLC_ROOT_PATH;
-			strcat(ex_file_name, destinationPath);
-			strcat(ex_file_name, extrafiles->elements[i].fname);
-			if (fs_rename(ex_tmp_file, ex_file_name) != 0)
+			const char *destinationPath = isWebFile ? HTTP_ROOT : PLC_ROOT_PATH;
+			snprintf(ex_file_name, sizeof(ex_file_name), "%s%s", destinationPath, extrafiles->elements[i].fname);
+
+			struct file_upload *ex_upload = get_upload_from_blobID(extra_files_blob);
+			if (ex_upload != NULL) // uploaded with this transfer
+			{
+				if (fs_rename(ex_upload->filename, ex_file_name) != 0)
+				{
+					LOG_ERR("cant rename uploaded file %s to %s", ex_upload->filename, ex_file_name);
+					*success = false;
+					return 0;
+				}
+			}
+			else if (blob_store_lookup(extra_files_blob, stored_file_name, sizeof(stored_file_name))) // unchanged since a previous transfer
+			{
+				if ((strcmp(stored_file_name, ex_file_name) != 0) && (blob_store_copy(stored_file_name, ex_file_name) != 0))
+				{
+					LOG_ERR("cant copy stored file %s to %s", stored_file_name, ex_file_name);
+					*success = false;
+					return 0;
+				}
+			}
+			else
 			{
-				LOG_ERR("cant rename uploaded file %s to %s", ex_tmp_file, ex_file_name);
+				LOG_ERR("extra file %s neither uploaded nor stored", extrafiles->elements[i].fname);
 				*success = false;
 				return 0;
 			}
+			blob_store_add(extra_files_blob, ex_file_name);
 		}
+		blob_store_save();
+		www_bundle_build(); // the web files are served from the filesystem if the board has no bundle partition
+
 		rc = fs_stat(PLC_MD5_FILE, &dirent);
 		if (rc == 0)
 			fs_unlink(PLC_MD5_FILE); // remove PLC_MD5_FILE
@@ -750,6 +1023,91 @@ uint32_t NewPLC(const char *md5sum, const binary_t *plcObjectBlobID, const list_
 /***************************************************************************************************************************************/
 /*		rpc server thread																								     		   */
 /***************************************************************************************************************************************/
+/****************************************************************************************************************************************
+ * @brief 			Session worker thread.
+ * 					Takes accepted connections from rpc_connection_queue and serves each one until the client disconnects
+ * 					or sends nothing for RPC_SESSION_IDLE_TIMEOUT seconds.
+ *
+ * @param p1 		Pointer to the rpc_session owned by this worker.
+ * @param p2 		Shared PLCObject service.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static void rpc_session_task(void *p1, void *p2, void *)
+{
+	struct rpc_session *session = p1;
+	erpc_service_t service = p2;
+	struct rpc_connection connection;
+	static atomic_t session_counter = ATOMIC_INIT(0);
+
+	while (true)
+	{
+		k_msgq_get(&rpc_connection_queue, &connection, K_FOREVER);
+
+		session->fd = connection.fd;
+		session->peer = connection.peer;
+		session->id = atomic_inc(&session_counter) + 1;
+		session->encodings = 0;
+
+		char addr[INET_ADDRSTRLEN];
+		inet_ntop(AF_INET, &session->peer.sin_addr, addr, sizeof(addr));
+		LOG_INF("Session %u: client %s connected", session->id, addr);
+
+		erpc_status_t status = rpc_session_serve(session, service);
+		if (status == kErpcStatus_Timeout)
+		{
+			LOG_WRN("Session %u: client idle for %u s", session->id, RPC_SESSION_IDLE_TIMEOUT);
+		}
+		else if (status != kErpcStatus_Success && status != kErpcStatus_ConnectionClosed)
+		{
+			LOG_ERR("Session %u: error status %u", session->id, status);
+			erpc_error_handler(status, 0);
+		}
+
+		close(session->fd);
+		session->fd = -1;
+		rpc_connection_active = 0; // Update connection status
+		LOG_INF("Session %u: connection to client closed", session->id);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Opens the listening socket of the eRPC server.
+ *
+ * @param port 		TCP port to listen on.
+ * @return 			Socket descriptor, or -1 on failure.
+ ****************************************************************************************************************************************/
+static int rpc_listen(uint16_t port)
+{
+	struct sockaddr_in addr = {
+		.sin_family = AF_INET,
+		.sin_port = htons(port),
+		.sin_addr.s_addr = htonl(INADDR_ANY),
+	};
+	int opt = 1;
+
+	int fd = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (fd < 0)
+	{
+		LOG_ERR("Failed to create socket: %d", errno);
+		return -1;
+	}
+	setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+	if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(fd, RPC_SESSION_COUNT) < 0)
+	{
+		LOG_ERR("Failed to listen on port %u: %d", port, errno);
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			eRPC server thread.
+ * 					Starts the session workers and blocks in accept(), handing every connection to a free worker. Up to
+ * 					RPC_SESSION_COUNT clients (e.g. the IDE and a monitoring tool) are served concurrently, further clients wait
+ * 					in the queue or are refused when it is full.
+ ****************************************************************************************************************************************/
 void rpc_server_task(void *, void *, void *)
 {
 	// MDNS service
@@ -766,82 +1124,56 @@ void rpc_server_task(void *, void *, void *)
 		ERPC_SERVER_PORT
 		);
 
-	while (true)
+	/* Service shared by all sessions */
+	erpc_service_t service = create_BeremizPLCObjectService_service();
+	if (service == NULL)
 	{
-		/* TCP transport layer initialization */
-		LOG_INF("TCP transport layer initialization");
-		erpc_transport_t transport = erpc_transport_tcp_zephyr_init(INADDR_ANY, erpc_port, true);
-		if (transport == NULL)
-		{
-			LOG_ERR("Failed to initialize TCP transport");
-			continue; // Skip this iteration to attempt a restart
-		}
-
-		/* MessageBufferFactory initialization */
-		LOG_INF("MessageBufferFactory initialization");
-		erpc_mbf_t message_buffer_factory = erpc_mbf_dynamic_init();
-		if (message_buffer_factory == NULL)
-		{
-			LOG_ERR("Failed to initialize MessageBufferFactory");
-			erpc_transport_tcp_zephyr_deinit(transport); // Clean up transport before restart
-			continue; // Attempt restart
-		}
+		LOG_ERR("Failed to create service");
+		return;
+	}
 
-		/* eRPC server side initialization */
-		LOG_INF("eRPC server side initialization");
-		erpc_server_t server = erpc_server_init(transport, message_buffer_factory);
-		if (server == NULL)
-		{
-			LOG_ERR("Failed to initialize eRPC server");
-			erpc_mbf_dynamic_deinit(message_buffer_factory); // Clean up message buffer factory
-			erpc_transport_tcp_zephyr_deinit(transport); // Clean up transport
-			continue; // Attempt restart
-		}
+	for (int i = 0; i < RPC_SESSION_COUNT; i++)
+	{
+		rpc_sessions[i].fd = -1;
+		k_thread_create(&rpc_session_threads[i], rpc_session_stacks[i], K_THREAD_STACK_SIZEOF(rpc_session_stacks[i]), rpc_session_task,
+						&rpc_sessions[i], service, NULL, RPC_SESSION_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&rpc_session_threads[i], "rpc_session");
+	}
 
-		/* Adding the service to the server */
-		LOG_INF("Adding the service to the server");
-		erpc_service_t service = create_BeremizPLCObjectService_service();
-		if (service == NULL)
+	while (true)
+	{
+		int listen_fd = rpc_listen(erpc_port);
+		if (listen_fd < 0)
 		{
-			LOG_ERR("Failed to create service");
-			erpc_server_deinit(server); // Clean up server
-			erpc_mbf_dynamic_deinit(message_buffer_factory); // Clean up message buffer factory
-			erpc_transport_tcp_zephyr_deinit(transport); // Clean up transport
+			k_msleep(1000);
 			continue; // Attempt restart
 		}
-		erpc_add_service_to_server(server, service);
+		LOG_INF("eRPC server listening on port %u", erpc_port);
 
-		/* Server loop for processing messages */
 		while (true)
 		{
-			/* Process message */
-			erpc_status_t status = erpc_server_poll(server);
+			struct rpc_connection connection;
+			socklen_t addr_len = sizeof(connection.peer);
+			int opt = 1;
 
-			/* Handle non-successful status */
-			if (status != kErpcStatus_Success && status != kErpcStatus_ConnectionClosed)
+			connection.fd = accept(listen_fd, (struct sockaddr *)&connection.peer, &addr_len);
+			if (connection.fd < 0)
 			{
-				LOG_ERR("Error status %u", status);
-				erpc_error_handler(status, 0); // Handle the error
-
-				/* Cleanup and break from server loop for restart */
-				erpc_remove_service_from_server(server, service);
-				destroy_BeremizPLCObjectService_service(service);
-				erpc_server_stop(server);
-				erpc_server_deinit(server);
-				erpc_mbf_dynamic_deinit(message_buffer_factory);
-				erpc_transport_tcp_zephyr_deinit(transport);
-				break; // Exit the server loop for restart
+				LOG_ERR("Accept failed: %d", errno);
+				break;
 			}
+			setsockopt(connection.fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt)); // Replies are small, send them at once
+			struct timeval idle = {.tv_sec = RPC_SESSION_IDLE_TIMEOUT, .tv_usec = 0};
+			setsockopt(connection.fd, SOL_SOCKET, SO_RCVTIMEO, &idle, sizeof(idle)); // Half-open connections don't block a session
 
-			/* Check if the connection was closed */
-			if (status == kErpcStatus_ConnectionClosed)
+			if (k_msgq_put(&rpc_connection_queue, &connection, K_NO_WAIT) != 0)
 			{
-				LOG_INF("Connection to client closed");
-				rpc_connection_active = 0; // Update connection status
+				LOG_WRN("All %d sessions busy, connection refused", RPC_SESSION_COUNT);
+				close(connection.fd);
 			}
-
-			k_msleep(10); // Sleep to reduce CPU usage
 		}
+
+		close(listen_fd);
 		LOG_ERR("The RPC server was terminated due to an error. Try restarting the RPC server...");
 	}
 }
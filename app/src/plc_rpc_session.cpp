@@ -0,0 +1,267 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <errno.h>
+#include <sys/socket.h>
+#include <zephyr/kernel.h>
+
+#include "erpc_basic_codec.hpp"
+#include "erpc_crc16.hpp"
+#include "erpc_framed_transport.hpp"
+#include "erpc_message_buffer.hpp"
+#include "erpc_port.h"
+#include "erpc_simple_server.hpp"
+#include "erpc_PLCObject_interface.hpp"
+
+#include "plc_rpc_session.h"
+
+using namespace erpc;
+using namespace erpcShim;
+
+/***************************************************************************************************************************************/
+/*		session transport																									 		   */
+/***************************************************************************************************************************************/
+
+/****************************************************************************************************************************************
+ * @brief 			Framed eRPC transport over the connected socket of one session.
+ * 					Receiving blocks in recv() until the client sends, so an idle session costs no cpu time. The socket
+ * 					has a receive timeout of RPC_SESSION_IDLE_TIMEOUT, a peer that vanished without closing the
+ * 					connection (crash, cable pull) doesn't keep the session forever.
+ ****************************************************************************************************************************************/
+class SessionTransport : public FramedTransport
+{
+public:
+	explicit SessionTransport(int fd) : m_fd(fd) {}
+
+protected:
+	virtual erpc_status_t underlyingReceive(uint8_t *data, uint32_t size) override
+	{
+		while (size > 0)
+		{
+			ssize_t received = recv(m_fd, data, size, 0);
+			if (received == 0)
+			{
+				return kErpcStatus_ConnectionClosed;
+			}
+			if (received < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				if (errno == EAGAIN || errno == EWOULDBLOCK)
+				{
+					return kErpcStatus_Timeout;
+				}
+				return (errno == ECONNRESET) ? kErpcStatus_ConnectionClosed : kErpcStatus_ReceiveFailed;
+			}
+			data += received;
+			size -= received;
+		}
+		return kErpcStatus_Success;
+	}
+
+	virtual erpc_status_t underlyingSend(const uint8_t *data, uint32_t size) override
+	{
+		while (size > 0)
+		{
+			ssize_t sent = send(m_fd, data, size, 0);
+			if (sent < 0)
+			{
+				if (errno == EINTR)
+				{
+					continue;
+				}
+				return (errno == ECONNRESET || errno == EPIPE) ? kErpcStatus_ConnectionClosed : kErpcStatus_SendFailed;
+			}
+			data += sent;
+			size -= sent;
+		}
+		return kErpcStatus_Success;
+	}
+
+private:
+	int m_fd;
+};
+
+/****************************************************************************************************************************************
+ * @brief 			Message buffer factory handing out the preallocated buffers of one session.
+ * 					Only the worker thread of the session uses it, so the bitmap needs no locking.
+ ****************************************************************************************************************************************/
+class SessionBufferFactory : public MessageBufferFactory
+{
+public:
+	explicit SessionBufferFactory(struct rpc_session *session) : m_session(session) { m_session->buffers_used = 0; }
+
+	virtual MessageBuffer create(void) override
+	{
+		for (uint32_t i = 0; i < ERPC_DEFAULT_BUFFERS_COUNT; i++)
+		{
+			if (!(m_session->buffers_used & BIT(i)))
+			{
+				m_session->buffers_used |= BIT(i);
+				return MessageBuffer(m_session->buffers[i], ERPC_DEFAULT_BUFFER_SIZE);
+			}
+		}
+		return MessageBuffer();
+	}
+
+	virtual void dispose(MessageBuffer *buf) override
+	{
+		for (uint32_t i = 0; i < ERPC_DEFAULT_BUFFERS_COUNT; i++)
+		{
+			if (buf->get() == m_session->buffers[i])
+			{
+				m_session->buffers_used &= ~BIT(i);
+			}
+		}
+	}
+
+private:
+	struct rpc_session *m_session;
+};
+
+/****************************************************************************************************************************************
+ * @brief 			Forwards the calls of one session to the shared PLCObject service.
+ * 					Calls that change blob uploads, the installed plc or the log counters take rpc_state_mutex, everything else
+ * 					(status, logs, traces, statistics) runs concurrently with the other sessions. AppendChunkToBlob is decoded
+ * 					here instead of by the generated shim, the chunk is passed in place from the received message buffer.
+ ****************************************************************************************************************************************/
+class SessionService : public Service
+{
+public:
+	explicit SessionService(Service *service) : Service(service->getServiceId()), m_service(service) {}
+
+	virtual erpc_status_t handleInvocation(uint32_t methodId, uint32_t sequence, Codec *codec, MessageBufferFactory *messageFactory, Transport *transport) override
+	{
+		erpc_status_t err;
+
+		if (!is_exclusive(methodId))
+		{
+			return m_service->handleInvocation(methodId, sequence, codec, messageFactory, transport);
+		}
+
+		k_mutex_lock(&rpc_state_mutex, K_FOREVER);
+		if (methodId == BeremizPLCObjectService_interface::m_AppendChunkToBlobId)
+		{
+			err = AppendChunkToBlob_shim(sequence, codec, messageFactory, transport);
+		}
+		else
+		{
+			err = m_service->handleInvocation(methodId, sequence, codec, messageFactory, transport);
+		}
+		k_mutex_unlock(&rpc_state_mutex);
+		return err;
+	}
+
+private:
+	/************************************************************************************************************************************
+	 * @brief 		Server shim of AppendChunkToBlob, replaces the generated one. The chunk and the blobID point into the
+	 * 				received message buffer and are only valid until AppendChunkToBlob returns, the reply is built in the
+	 * 				same buffer afterwards. The message format is the one of the generated shim.
+	 ************************************************************************************************************************************/
+	static erpc_status_t AppendChunkToBlob_shim(uint32_t sequence, Codec *codec, MessageBufferFactory *messageFactory, Transport *transport)
+	{
+		binary_t data = {NULL, 0};
+		binary_t blobID = {NULL, 0};
+		binary_t newBlobID = {NULL, 0};
+		uint32_t result = 0;
+
+		// startReadMessage() was already called by the server
+		codec->readBinary(data.dataLength, &data.data);
+		codec->readBinary(blobID.dataLength, &blobID.data);
+
+		erpc_status_t err = codec->getStatus();
+		if (err == kErpcStatus_Success)
+		{
+			result = ::AppendChunkToBlob(&data, &blobID, &newBlobID);
+			err = messageFactory->prepareServerBufferForSend(codec->getBufferRef(), transport->reserveHeaderSize());
+		}
+
+		if (err == kErpcStatus_Success)
+		{
+			codec->reset(transport->reserveHeaderSize());
+			codec->startWriteMessage(message_type_t::kReplyMessage, BeremizPLCObjectService_interface::m_serviceId,
+									 BeremizPLCObjectService_interface::m_AppendChunkToBlobId, sequence);
+			codec->writeBinary(newBlobID.dataLength, newBlobID.data);
+			codec->write(result);
+			err = codec->getStatus();
+		}
+
+		erpc_free(newBlobID.data);
+		return err;
+	}
+
+	static bool is_exclusive(uint32_t methodId)
+	{
+		switch (methodId)
+		{
+		case BeremizPLCObjectService_interface::m_AppendChunkToBlobId:
+		case BeremizPLCObjectService_interface::m_MatchMD5Id:
+		case BeremizPLCObjectService_interface::m_NewPLCId:
+		case BeremizPLCObjectService_interface::m_PurgeBlobsId:
+		case BeremizPLCObjectService_interface::m_QueryBlobsId:
+		case BeremizPLCObjectService_interface::m_RepairPLCId:
+		case BeremizPLCObjectService_interface::m_ResetLogCountId:
+		case BeremizPLCObjectService_interface::m_SeedBlobId:
+		case BeremizPLCObjectService_interface::m_StartPLCId:
+		case BeremizPLCObjectService_interface::m_StopPLCId:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	Service *m_service;
+};
+
+/***************************************************************************************************************************************/
+/*		session																												 		   */
+/***************************************************************************************************************************************/
+
+/****************************************************************************************************************************************
+ * @brief 			Serves eRPC requests on the socket of a session until the client disconnects or an error occurs.
+ * 					Transport, codec, buffers and server are private to the session, the PLCObject service is shared.
+ *
+ * @param session 	Session with the connected socket, the socket is not closed here.
+ * @param service 	PLCObject service created by create_BeremizPLCObjectService_service().
+ * @return 			kErpcStatus_ConnectionClosed when the client disconnected, otherwise the error that ended the session.
+ ****************************************************************************************************************************************/
+extern "C" erpc_status_t rpc_session_serve(struct rpc_session *session, erpc_service_t service)
+{
+	Crc16 crc;
+	SessionTransport transport(session->fd);
+	BasicCodecFactory codecs;
+	SessionBufferFactory buffers(session);
+	SessionService sessionService(static_cast<Service *>(service));
+	SimpleServer server;
+
+	transport.setCrc16(&crc);
+	server.setTransport(&transport);
+	server.setCodecFactory(&codecs);
+	server.setMessageBufferFactory(&buffers);
+	server.addService(&sessionService);
+
+	erpc_status_t err = server.run();
+
+	server.removeService(&sessionService);
+	return err;
+}
@@ -22,11 +22,13 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(PLC_RTE_LOGGING, LOG_LEVEL_DBG);
 
+#include <stdarg.h>
 #include <stdio.h>
 #include <string.h>
 #include <time.h>
 #include <unistd.h>
 
+#include <zephyr/fs/fs.h>
 #include <zephyr/kernel.h>
 #include <zephyr/posix/time.h>
 
@@ -35,15 +37,203 @@ LOG_MODULE_REGISTER(PLC_RTE_LOGGING, LOG_LEVEL_DBG);
 
 #include "config.h"
 #include "plc_log_rte.h"
+#include "plc_syslog.h"
 #include "plc_task.h"
 
-static uint32_t messageIndexes[LOG_LEVELS] = {0}; // Sequential indexes for log messages per log level
+/****************************************************************************************************************************************
+ * RTE log store
+ * Messages are stored as fixed-size records in a file used as ring of RTE_LOG_MAX_RECORDS slots. Record n of the store
+ * is written to slot n % RTE_LOG_MAX_RECORDS, so writes are sequential and the oldest record is overwritten when the
+ * file is full. The index in RAM maps a message ID of a level to its slot, so a message is read with a single seek.
+ * The index is persisted together with the log state and rebuilt from the records if it doesn't match the log.
+ ****************************************************************************************************************************************/
+#define RTE_LOG_INDEX_MAGIC 0x58444c52 // "RLDX"
+#define RTE_LOG_SLOT_EMPTY 0xff
+
+struct rte_log_record
+{
+	uint32_t seq;							// Sequence number of the record in the store, starts at 1, 0 = empty slot
+	uint32_t id;							// Message ID within the level
+	uint32_t tick;
+	uint32_t sec;
+	uint32_t nsec;
+	uint8_t level;
+	uint8_t length;							// Length of msg without terminating zero
+	uint8_t reserved[2];
+	char msg[RTE_LOG_MSG_SIZE];
+};
+
+struct rte_log_index
+{
+	uint32_t magic;
+	uint32_t next_seq;										// Sequence number of the next record
+	uint32_t next_id[LOG_LEVELS];							// Sequential indexes for log messages per log level
+	uint32_t first_id[LOG_LEVELS];							// Oldest message ID per level that is still stored
+	uint32_t counts[LOG_LEVELS];							// Number of log entries per level
+	uint8_t slot_level[RTE_LOG_MAX_RECORDS];				// Level of the record in each slot, RTE_LOG_SLOT_EMPTY if unused
+	uint16_t slot[LOG_LEVELS][RTE_LOG_MAX_RECORDS];			// Slot of message ID n is slot[level][n % RTE_LOG_MAX_RECORDS]
+};
+
+static struct rte_log_index __ccm_noinit_section log_index;
 uint32_t plc_logCounts[LOG_LEVELS] = {0};		  // Number of log entries per level
 
+static struct fs_file_t log_file;
+static bool log_file_open = false;
+K_MUTEX_DEFINE(log_mutex); // Serializes access to the log store and its index
+
+// Messages from PLC code are queued and written by the log writer thread
+K_MSGQ_DEFINE(log_queue, sizeof(struct rte_log_record), RTE_LOG_QUEUE_SIZE, 4);
+K_SEM_DEFINE(log_store_ready, 0, 1);									// Given when the log store is initialized
+static struct rte_log_record __ccm_noinit_section log_write_batch[RTE_LOG_WRITE_BATCH]; // Records written by one write
+static atomic_t log_dropped = ATOMIC_INIT(0);							// Messages dropped since the last report
+static uint32_t log_dropped_total = 0;									// Messages dropped since start
+
 extern uint32_t __tick; // Current PLC tick from plc_task.c
 
 struct k_timer logging_timer;
 
+/****************************************************************************************************************************************
+ * @brief    Opens the log store if it isn't open yet
+ *
+ * @param    None
+ * @return   int 0 on success, negative errno on failure
+ ****************************************************************************************************************************************/
+static int open_log_file(void)
+{
+	if (log_file_open)
+		return 0;
+
+	fs_file_t_init(&log_file);
+	int ret = fs_open(&log_file, LOG_FILE_NAME, FS_O_CREATE | FS_O_RDWR);
+	if (ret < 0)
+	{
+		LOG_ERR("Failed to open logfile %s (%d)", LOG_FILE_NAME, ret);
+		return ret;
+	}
+	log_file_open = true;
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Closes the log store
+ *
+ * @param    None
+ * @return   void
+ ****************************************************************************************************************************************/
+static void close_log_file(void)
+{
+	if (log_file_open)
+	{
+		fs_close(&log_file);
+		log_file_open = false;
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief    Reads the record stored in a slot of the log store
+ *
+ * @param    slot Slot to read
+ * @param    record Struct to store the record
+ * @return   int 0 if the slot holds a record, -ENOENT if the slot is empty, negative errno on failure
+ ****************************************************************************************************************************************/
+static int read_log_record(uint32_t slot, struct rte_log_record *record)
+{
+	int ret = fs_seek(&log_file, (off_t)slot * sizeof(struct rte_log_record), FS_SEEK_SET);
+	if (ret < 0)
+		return ret;
+
+	ret = fs_read(&log_file, record, sizeof(struct rte_log_record));
+	if (ret < 0)
+		return ret;
+	if ((ret != sizeof(struct rte_log_record)) || (record->seq == 0) || (record->level >= LOG_LEVELS) || (record->length >= RTE_LOG_MSG_SIZE))
+		return -ENOENT;
+
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Clears the index of the log store
+ *
+ * @param    None
+ * @return   void
+ ****************************************************************************************************************************************/
+static void clear_log_index(void)
+{
+	memset(&log_index, 0, sizeof(log_index));
+	memset(log_index.slot_level, RTE_LOG_SLOT_EMPTY, sizeof(log_index.slot_level));
+	log_index.magic = RTE_LOG_INDEX_MAGIC;
+	log_index.next_seq = 1;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Adds a record to the index of the log store
+ *
+ * @param    slot Slot of the record
+ * @param    record The record
+ * @return   void
+ ****************************************************************************************************************************************/
+static void index_log_record(uint32_t slot, const struct rte_log_record *record)
+{
+	log_index.slot[record->level][record->id % RTE_LOG_MAX_RECORDS] = slot;
+	log_index.slot_level[slot] = record->level;
+	log_index.next_seq = MAX(log_index.next_seq, record->seq + 1);
+	log_index.next_id[record->level] = MAX(log_index.next_id[record->level], record->id + 1);
+}
+
+/****************************************************************************************************************************************
+ * @brief    Rebuilds the index from the records of the log store, used if the persisted index doesn't match the log
+ *
+ * @param    None
+ * @return   void
+ ****************************************************************************************************************************************/
+static void rebuild_log_index(void)
+{
+	struct rte_log_record record;
+	uint32_t first_id[LOG_LEVELS];
+
+	clear_log_index();
+	memset(first_id, 0xff, sizeof(first_id));
+
+	for (uint32_t slot = 0; slot < RTE_LOG_MAX_RECORDS; slot++)
+	{
+		if (read_log_record(slot, &record) == 0)
+		{
+			index_log_record(slot, &record);
+			first_id[record.level] = MIN(first_id[record.level], record.id);
+		}
+	}
+
+	for (int i = 0; i < LOG_LEVELS; i++)
+	{
+		log_index.first_id[i] = (first_id[i] == UINT32_MAX) ? log_index.next_id[i] : first_id[i];
+		log_index.counts[i] = log_index.next_id[i];
+	}
+	LOG_INF("Log index rebuilt, %u records", log_index.next_seq - 1);
+}
+
+/****************************************************************************************************************************************
+ * @brief    Checks whether the persisted index describes the records in the log store
+ *
+ * @param    None
+ * @return   bool true if the index is up to date
+ ****************************************************************************************************************************************/
+static bool log_index_valid(void)
+{
+	struct rte_log_record record;
+
+	if ((log_index.magic != RTE_LOG_INDEX_MAGIC) || (log_index.next_seq == 0))
+		return false;
+
+	// The newest indexed record must be on file and no newer one may have been written after the index was saved
+	if ((log_index.next_seq > 1) &&
+		((read_log_record((log_index.next_seq - 1) % RTE_LOG_MAX_RECORDS, &record) != 0) || (record.seq != log_index.next_seq - 1)))
+		return false;
+	if ((read_log_record(log_index.next_seq % RTE_LOG_MAX_RECORDS, &record) == 0) && (record.seq >= log_index.next_seq))
+		return false;
+
+	return true;
+}
+
 /****************************************************************************************************************************************
  * @brief    Timer callback function for logging timer
  *
@@ -67,6 +257,7 @@ void initialize_logging(void)
 	LOG_INF("Initialized PLC logging");
 	ResetLogCount();
 	LoadLogState(plc_logCounts); // Also loads the messageIndex
+	k_sem_give(&log_store_ready); // Let the log writer store queued messages
 #if BACKUP_PERIOD_SEC > 0		 // 0 = log backup disabled
 	k_timer_init(&logging_timer, logging_timer_callback, NULL);
 	k_timer_start(&logging_timer, K_SECONDS(BACKUP_PERIOD_SEC), K_SECONDS(BACKUP_PERIOD_SEC));
@@ -108,61 +299,150 @@ void backup_logging(void)
 }
 
 /****************************************************************************************************************************************
- * @brief    Saves the current state of log counts and message indexes
+ * @brief    Saves the current state of log counts, message indexes and the index of the log store
  *
  * @param    logCounts Array of log counts for each level
  * @return   void
  ****************************************************************************************************************************************/
 void SaveLogState(uint32_t *logCounts)
 {
-	FILE *file = fopen(STATE_FILE_NAME, "w");
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	FILE *file = fopen(STATE_FILE_NAME, "wb");
 	if (file)
 	{
-		// Saves messageIndexes and the number of log entries per log level
-		for (int i = 0; i < LOG_LEVELS; i++)
-		{
-			fprintf(file, "%u %u\n", messageIndexes[i], logCounts[i]);
-		}
+		memcpy(log_index.counts, logCounts, sizeof(log_index.counts));
+		if (fwrite(&log_index, sizeof(log_index), 1, file) == 1)
+			LOG_INF("Log state saved successfully.");
+		else
+			LOG_ERR("Failed to write log state");
 		fclose(file);
-		LOG_INF("Log state saved successfully.");
 	}
 	else
 	{
 		LOG_ERR("Failed to save log state %d %s", errno, strerror(errno));
 	}
+	k_mutex_unlock(&log_mutex);
 }
 
 /****************************************************************************************************************************************
- * @brief    Loads the saved state of log counts and message indexes
+ * @brief    Loads the saved state of log counts, message indexes and the index of the log store. The index is rebuilt
+ *           from the log store if it is missing or outdated.
  *
  * @param    logCounts Array to store the loaded log counts for each level
  * @return   void
  ****************************************************************************************************************************************/
 void LoadLogState(uint32_t *logCounts)
 {
-	FILE *file = fopen(STATE_FILE_NAME, "r");
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	FILE *file = fopen(STATE_FILE_NAME, "rb");
 	if (file)
 	{
-		// Loads messageIndexes and the number of log entries per log level
-		for (int i = 0; i < LOG_LEVELS; i++)
+		if (fread(&log_index, sizeof(log_index), 1, file) != 1)
 		{
-			if (fscanf(file, "%u %u", &messageIndexes[i], &logCounts[i]) != 2)
-			{
-				LOG_ERR("Failed to load log state for level %d", i);
-				break;
-			}
+			LOG_ERR("Failed to load log state");
+			log_index.magic = 0;
 		}
 		fclose(file);
-		LOG_INF("Log state loaded successfully.");
 	}
 	else
 	{
 		LOG_ERR("Failed to load log state %d %s", errno, strerror(errno));
+		log_index.magic = 0;
+	}
+
+	if (open_log_file() == 0)
+	{
+		if (!log_index_valid())
+			rebuild_log_index();
+		else
+			LOG_INF("Log state loaded successfully.");
+	}
+	else
+	{
+		clear_log_index();
 	}
+	memcpy(logCounts, log_index.counts, sizeof(log_index.counts));
+	k_mutex_unlock(&log_mutex);
 }
 
 /****************************************************************************************************************************************
- * @brief    Logs a message with the specified level and message buffer
+ * @brief    Writes log records to the log store and adds them to the index. Records going to consecutive slots are
+ *           written with a single write.
+ *
+ * @param    records Records to store, seq and id are assigned here
+ * @param    count Number of records
+ * @return   int Number of records stored
+ ****************************************************************************************************************************************/
+static int store_log_records(struct rte_log_record *records, uint32_t count)
+{
+	uint32_t stored = 0;
+
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	if (open_log_file() < 0)
+	{
+		k_mutex_unlock(&log_mutex);
+		return 0; // Error opening the file
+	}
+
+	while (stored < count)
+	{
+		uint32_t slot = log_index.next_seq % RTE_LOG_MAX_RECORDS;
+		uint32_t batch = MIN(count - stored, RTE_LOG_MAX_RECORDS - slot); // Split where the ring wraps
+
+		for (uint32_t i = 0; i < batch; i++)
+		{
+			struct rte_log_record *record = &records[stored + i];
+			record->seq = log_index.next_seq + i;
+			record->id = log_index.next_id[record->level]++; // Use and update the index for the specific log level
+		}
+
+		int ret = fs_seek(&log_file, (off_t)slot * sizeof(struct rte_log_record), FS_SEEK_SET);
+		if (ret == 0)
+		{
+			ret = fs_write(&log_file, &records[stored], batch * sizeof(struct rte_log_record));
+			ret = (ret == batch * sizeof(struct rte_log_record)) ? fs_sync(&log_file) : -EIO;
+		}
+		if (ret < 0)
+		{
+			LOG_ERR("Failed to save message to logfile %d", ret);
+			for (uint32_t i = 0; i < batch; i++) // Give back the ids of the lost records
+			{
+				log_index.next_id[records[stored + i].level]--;
+			}
+			break;
+		}
+
+		for (uint32_t i = 0; i < batch; i++)
+		{
+			struct rte_log_record *record = &records[stored + i];
+
+			// The overwritten record was the oldest one of its level
+			if (log_index.slot_level[slot + i] != RTE_LOG_SLOT_EMPTY)
+			{
+				log_index.first_id[log_index.slot_level[slot + i]]++;
+			}
+			index_log_record(slot + i, record);
+			plc_logCounts[record->level]++; // Updates the number of log entries for the specific log level
+			LOG_INF("Saved log message [%u] [%u] [%u] %s", record->id, record->tick, record->level, record->msg);
+		}
+		stored += batch;
+	}
+	k_mutex_unlock(&log_mutex);
+
+#ifdef CONFIG_PLC_SYSLOG
+	for (uint32_t i = 0; i < stored; i++)
+	{
+		syslog_rte_message(records[i].level, records[i].tick, records[i].sec, records[i].nsec, records[i].msg);
+	}
+#endif
+
+	return stored;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Logs a message with the specified level and message buffer. Called by PLC code within the PLC cycle, so the
+ *           message is only queued with its timestamp and tick and written by the log writer thread. If the queue is
+ *           full, the message is dropped and counted instead of blocking the cycle.
  *
  * @param    level Log level of the message
  * @param    buf Buffer containing the message to log
@@ -176,30 +456,87 @@ int LogMessage(uint8_t level, char *buf, int8_t size)
 		return 0; // Invalid log level
 	}
 
-	FILE *file = fopen(LOG_FILE_NAME, "a+");
-	if (!file)
+	struct rte_log_record record;
+	struct timespec ts;
+	clock_gettime(CLOCK_REALTIME, &ts);
+
+	record.seq = 0;
+	record.id = 0;
+	record.tick = __tick;
+	record.sec = ts.tv_sec;
+	record.nsec = ts.tv_nsec;
+	record.level = level;
+	record.length = strnlen(buf, (size > 0) ? MIN(size, RTE_LOG_MSG_SIZE - 1) : RTE_LOG_MSG_SIZE - 1);
+	record.reserved[0] = 0;
+	record.reserved[1] = 0;
+	memcpy(record.msg, buf, record.length);
+	memset(record.msg + record.length, 0, RTE_LOG_MSG_SIZE - record.length);
+
+	if (k_msgq_put(&log_queue, &record, K_NO_WAIT) != 0)
 	{
-		LOG_ERR("Failed to save message to logfile %d %s", errno, strerror(errno));
-		return 0; // Error opening the file
+		atomic_inc(&log_dropped);
+		return 0; // Queue full
 	}
+	return 1; // Success
+}
 
-	struct timespec ts;
-	clock_gettime(CLOCK_REALTIME, &ts);
+/****************************************************************************************************************************************
+ * @brief    Returns the number of log messages dropped because the log queue was full
+ *
+ * @param    None
+ * @return   uint32_t Number of dropped messages since start
+ ****************************************************************************************************************************************/
+uint32_t GetLogDroppedCount(void) { return log_dropped_total + atomic_get(&log_dropped); }
+
+/****************************************************************************************************************************************
+ * @brief    Log writer thread, writes the queued log messages to the log store in batches. Dropped messages are
+ *           reported with a warning in the log itself, so they are visible in the IDE.
+ *
+ * @param    None
+ * @return   void
+ ****************************************************************************************************************************************/
+#define LOG_WRITER_STACK_SIZE 1536
+#define LOG_WRITER_PRIORITY 8
 
-	char localBuf[256];
-	snprintf(localBuf, 256, "[%u] [%u] [%lld] [%ld] [%u] ",
-			 messageIndexes[level]++, // Use and update the index for the specific log level
-			 __tick, (long long)ts.tv_sec, ts.tv_nsec, level);
-	strcat(localBuf, buf);
-	fprintf(file, "%s\n", localBuf);
+void log_writer_thread(void *, void *, void *)
+{
+	uint32_t count;
 
-	fclose(file);
+	k_sem_take(&log_store_ready, K_FOREVER); // Queued messages are kept until the log store is initialized
 
-	plc_logCounts[level]++; // Updates the number of log entries for the specific log level
-	LOG_INF("Saved log message msg=%s", localBuf);
-	return 1; // Success
+	while (true)
+	{
+		k_msgq_get(&log_queue, &log_write_batch[0], K_FOREVER);
+		count = 1;
+		while ((count < RTE_LOG_WRITE_BATCH) && (k_msgq_get(&log_queue, &log_write_batch[count], K_NO_WAIT) == 0))
+		{
+			count++;
+		}
+
+		store_log_records(log_write_batch, count);
+
+		uint32_t dropped = atomic_clear(&log_dropped);
+		if (dropped > 0)
+		{
+			struct rte_log_record *record = &log_write_batch[0];
+			struct timespec ts;
+			clock_gettime(CLOCK_REALTIME, &ts);
+
+			log_dropped_total += dropped;
+			memset(record, 0, sizeof(struct rte_log_record));
+			record->tick = __tick;
+			record->sec = ts.tv_sec;
+			record->nsec = ts.tv_nsec;
+			record->level = RTE_LOGLEVEL_WARNING;
+			record->length = snprintf(record->msg, RTE_LOG_MSG_SIZE, "%u log messages dropped, log queue full", dropped);
+			store_log_records(record, 1);
+			LOG_WRN("%u log messages dropped", dropped);
+		}
+	}
 }
 
+K_THREAD_DEFINE_CCM(log_writer, LOG_WRITER_STACK_SIZE, log_writer_thread, NULL, NULL, NULL, LOG_WRITER_PRIORITY, 0, PLC_TASK_STARTUP_DELAY);
+
 /****************************************************************************************************************************************
  * @brief    Retrieves a log message by its ID and level
  *
@@ -210,64 +547,40 @@ int LogMessage(uint8_t level, char *buf, int8_t size)
  ****************************************************************************************************************************************/
 uint32_t GetLogMessage(uint8_t level, uint32_t msgID, log_message *message)
 {
-	message->msg = NULL;
-	FILE *file = fopen(LOG_FILE_NAME, "r");
-	if (!file)
-	{
-		LOG_ERR("GetLogMessage can't open logfile");
-		return 0; // Error opening the file
-	}
-
-	char line[512];
+	struct rte_log_record record;
 	uint32_t found = 1; // Starts with an error value, 0 is set if the message was found.
 
-	while (fgets(line, sizeof(line), file) != NULL)
+	message->msg = NULL;
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	if ((level < LOG_LEVELS) && (msgID >= log_index.first_id[level]) && (msgID < log_index.next_id[level]) && (open_log_file() == 0))
 	{
-		uint32_t lineID, lineTick, lineSec, lineNsec, lineLevel;
-		if (sscanf(line, "[%u] [%u] [%u] [%u] [%u]", &lineID, &lineTick, &lineSec, &lineNsec, &lineLevel) == 5)
+		uint32_t slot = log_index.slot[level][msgID % RTE_LOG_MAX_RECORDS];
+		if ((read_log_record(slot, &record) == 0) && (record.id == msgID) && (record.level == level))
 		{
-			if (lineID == msgID && lineLevel == level)
+			message->msg = (char *)k_malloc(record.length + 1); // Allocates memory for the message
+			if (message->msg == NULL)
+			{
+				LOG_ERR("Error allocating memory for the message");
+			}
+			else
 			{
-				// Extracts the message by skipping all metadata fields
-				char *msgStart = line;
-				for (int i = 0; i < 5; ++i)
-				{									  // For each of the five metadata fields
-					msgStart = strchr(msgStart, ']'); // Find the next ']' character
-					if (!msgStart)
-						break;	   // If no further ']' found, break
-					msgStart += 2; // Skips the ']' and the following space
-				}
-
-				if (msgStart)
-				{
-					size_t msgLen = strlen(msgStart);
-					message->msg = (char *)k_malloc(msgLen + 1); // Allocates memory for the message
-					if (message->msg == NULL)
-					{
-						found = 1; // Error allocating memory
-						LOG_ERR("Error allocating memory for the message");
-						break;
-					}
-					strncpy(message->msg, msgStart, msgLen);
-					message->msg[msgLen] = '\0'; // Ensures the message is properly terminated
-					// Copies the metadata
-					message->tick = lineTick;
-					message->sec = lineSec;
-					message->nsec = lineNsec;
-
-					found = 0; // Message successfully found and copied
-					break;
-				}
+				memcpy(message->msg, record.msg, record.length);
+				message->msg[record.length] = '\0'; // Ensures the message is properly terminated
+				// Copies the metadata
+				message->tick = record.tick;
+				message->sec = record.sec;
+				message->nsec = record.nsec;
+
+				found = 0; // Message successfully found and copied
+				plc_logCounts[level]--; // Updates the number of log entries for the specific log level, under the log_mutex like the writer
 			}
 		}
 	}
-
-	fclose(file);
+	k_mutex_unlock(&log_mutex);
 
 	if (found == 0)
 	{
 		LOG_INF("Found LogMessage in file: msgid=%u level=%u tick=%u sec=%u nsec=%u msg=%s", msgID, level, message->tick, message->sec, message->nsec, message->msg);
-		plc_logCounts[level]--; // Updates the number of log entries for the specific log level
 	}
 	else
 	{
@@ -281,6 +594,127 @@ uint32_t GetLogMessage(uint8_t level, uint32_t msgID, log_message *message)
 	return 0;
 }
 
+/****************************************************************************************************************************************
+ * @brief    Finds the first message of a level that was logged at or after a time, by a binary search over the message
+ *           IDs. Assumes the realtime clock doesn't go backwards between messages.
+ *
+ * @param    level Log level
+ * @param    id First message ID to consider
+ * @param    sec Time in seconds
+ * @return   uint32_t ID of the first message not older than sec, the next message ID if there is none
+ ****************************************************************************************************************************************/
+static uint32_t find_log_id_by_time(uint8_t level, uint32_t id, uint32_t sec)
+{
+	struct rte_log_record record;
+	uint32_t lo = id;
+	uint32_t hi = log_index.next_id[level];
+
+	while (lo < hi)
+	{
+		uint32_t mid = lo + (hi - lo) / 2;
+		if ((read_log_record(log_index.slot[level][mid % RTE_LOG_MAX_RECORDS], &record) != 0) || (record.sec < sec))
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Retrieves a batch of log messages of a level, starting at a message ID and optionally limited to a time
+ *           range. The batch ends after maxCount messages or when the response would exceed RTE_LOG_BATCH_BYTES, the
+ *           host continues with batch->nextID. Unlike GetLogMessage the log count isn't changed.
+ *
+ * @param    level Log level of the messages to retrieve
+ * @param    firstID ID of the first message, older messages that were overwritten are skipped
+ * @param    maxCount Maximum number of messages, limited to RTE_LOG_BATCH_MAX
+ * @param    fromSec Only messages logged at or after this time in seconds, 0 for no limit
+ * @param    toSec Only messages logged at or before this time in seconds, 0 for no limit
+ * @param    batch Struct to store the messages, the number of messages of the level and the ID to continue with
+ * @return   uint32_t Returns 0 on success, 1 on failure
+ ****************************************************************************************************************************************/
+uint32_t GetLogMessages(uint8_t level, uint32_t firstID, uint32_t maxCount, uint32_t fromSec, uint32_t toSec, log_batch *batch)
+{
+	struct rte_log_record record;
+	size_t bytes = 0;
+	uint32_t ret = 1;
+
+	batch->count = 0;
+	batch->nextID = firstID;
+	batch->entries.elements = NULL;
+	batch->entries.elementsCount = 0;
+
+	if (level >= LOG_LEVELS)
+	{
+		return 1; // Invalid log level
+	}
+	maxCount = CLAMP(maxCount, 1, RTE_LOG_BATCH_MAX);
+
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	batch->count = log_index.next_id[level];
+	if (open_log_file() < 0)
+	{
+		goto out;
+	}
+
+	uint32_t id = MAX(firstID, log_index.first_id[level]);
+	if (fromSec > 0)
+	{
+		id = find_log_id_by_time(level, id, fromSec);
+	}
+
+	batch->entries.elements = (log_entry *)k_malloc(maxCount * sizeof(log_entry));
+	if (batch->entries.elements == NULL)
+	{
+		LOG_ERR("Error allocating memory for the log batch");
+		goto out;
+	}
+
+	while ((id < log_index.next_id[level]) && (batch->entries.elementsCount < maxCount))
+	{
+		if ((read_log_record(log_index.slot[level][id % RTE_LOG_MAX_RECORDS], &record) != 0) || (record.id != id) || (record.level != level))
+		{
+			id++; // Lost record, skip it
+			continue;
+		}
+		if ((toSec > 0) && (record.sec > toSec))
+		{
+			break; // End of the time range
+		}
+
+		size_t size = record.length + 6 * sizeof(uint32_t); // Encoded size of the entry, string length and 5 fields
+		if ((batch->entries.elementsCount > 0) && (bytes + size > RTE_LOG_BATCH_BYTES))
+		{
+			break; // Keep the response in one eRPC buffer
+		}
+
+		log_entry *entry = &batch->entries.elements[batch->entries.elementsCount];
+		entry->msg = (char *)k_malloc(record.length + 1);
+		if (entry->msg == NULL)
+		{
+			LOG_ERR("Error allocating memory for the message");
+			break;
+		}
+		memcpy(entry->msg, record.msg, record.length);
+		entry->msg[record.length] = '\0';
+		entry->msgID = record.id;
+		entry->tick = record.tick;
+		entry->sec = record.sec;
+		entry->nsec = record.nsec;
+
+		batch->entries.elementsCount++;
+		bytes += size;
+		id++;
+	}
+	batch->nextID = id;
+	ret = 0;
+
+out:
+	k_mutex_unlock(&log_mutex);
+	LOG_DBG("GetLogMessages: level=%u firstID=%u count=%u nextID=%u", level, firstID, batch->entries.elementsCount, batch->nextID);
+	return ret;
+}
+
 /****************************************************************************************************************************************
  * @brief    Resets the log counts and message indexes for all levels
  *
@@ -290,6 +724,10 @@ uint32_t GetLogMessage(uint8_t level, uint32_t msgID, log_message *message)
 uint32_t ResetLogCount(void)
 {
 	struct fs_dirent dirent;
+
+	k_mutex_lock(&log_mutex, K_FOREVER);
+	close_log_file();
+
 	int rc = fs_stat(LOG_FILE_NAME, &dirent);
 	if (rc == 0)
 	{
@@ -308,15 +746,16 @@ uint32_t ResetLogCount(void)
 			LOG_ERR("Failed to delete logState file.");
 	}
 
-	// Resets the count of log messages and messageIndexes for each level
+	// Resets the count of log messages, messageIndexes and the index for each level
+	clear_log_index();
 	for (int i = 0; i < LOG_LEVELS; ++i)
 	{
 		plc_logCounts[i] = 0;
-		messageIndexes[i] = 0; // Resets the message index for each log level
 	}
 
 	// Saves the current state, including reset messageIndexes and logCounts
 	SaveLogState(plc_logCounts);
+	k_mutex_unlock(&log_mutex);
 
 	return 0;
 }
@@ -351,3 +790,408 @@ void rte_log_inf(const char *fmt, ...)
 	LOG_WRN("%s", buffer);
 	va_end(args);
 }
+
+/****************************************************************************************************************************************
+ * Deferred rte logging
+ * rte_log_inf_deferred runs inside the PLC cycle and only captures the message, it is formatted later in the system
+ * workqueue. The format is scanned for its conversions and exactly the arguments it names are read, with their types.
+ * Integers are kept as long long and floating point values as double. Strings and formats in the loaded PLC module are
+ * copied into the record, so the message never refers to PLC memory that changed or was released meanwhile. %n and
+ * wide characters aren't supported, the message ends before such a conversion or before an argument that doesn't fit.
+ ****************************************************************************************************************************************/
+enum rte_log_arg_type
+{
+	RTE_LOG_ARG_INT,	// Integer of any length, formatted with ll
+	RTE_LOG_ARG_CHAR,	// %c
+	RTE_LOG_ARG_DOUBLE, // Floating point value, long double is kept as double
+	RTE_LOG_ARG_PTR,	// %p
+	RTE_LOG_ARG_STR,	// %s, the copy is in strings
+};
+
+union rte_log_arg
+{
+	long long i;
+	double d;
+	const void *p;
+	uint32_t str; // Offset of the copied string
+};
+
+struct rte_log_deferred
+{
+	uint32_t tick;
+	const char *fmt;								// Format in firmware rodata, or fmt_copy
+	uint8_t nargs;									// Number of captured arguments
+	uint8_t types[RTE_LOG_DEFERRED_ARGS];			// enum rte_log_arg_type of each argument
+	union rte_log_arg args[RTE_LOG_DEFERRED_ARGS];	// Captured arguments, '*' widths and precisions are int arguments
+	char fmt_copy[RTE_LOG_FMT_SIZE];				// Copy of a format outside firmware rodata
+	char strings[RTE_LOG_STR_SIZE];					// Copies of the string arguments
+};
+
+static void rte_log_deferred_handler(struct k_work *work);
+
+K_MSGQ_DEFINE(log_deferred_queue, sizeof(struct rte_log_deferred), RTE_LOG_DEFERRED_COUNT, 8);
+K_WORK_DEFINE(log_deferred_work, rte_log_deferred_handler);
+static atomic_t log_deferred_dropped = ATOMIC_INIT(0);	 // Deferred messages dropped since the last report
+static atomic_t log_deferred_truncated = ATOMIC_INIT(0); // Deferred messages truncated since the last report
+static char log_deferred_buffer[RTE_LOG_MSG_SIZE];		 // Output of rte_log_format, only used by the system workqueue
+
+/****************************************************************************************************************************************
+ * @brief    Parses a printf conversion
+ *
+ * @param    spec First character behind the '%'
+ * @param    conv Returns the conversion character, '\0' at the end of the format
+ * @param    stars Returns the number of '*' width and precision arguments
+ * @param    length Returns the length modifier, 'H' for hh, 'q' for ll, 0 without
+ * @return   Pointer behind the conversion
+ ****************************************************************************************************************************************/
+static const char *rte_log_parse_spec(const char *spec, char *conv, int *stars, char *length)
+{
+	*stars = 0;
+	*length = 0;
+
+	while ((*spec != '\0') && (strchr("-+ #0", *spec) != NULL))
+		spec++;
+	for (int part = 0; part < 2; part++) // width, then precision
+	{
+		if (part == 1)
+		{
+			if (*spec != '.')
+				break;
+			spec++;
+		}
+		if (*spec == '*')
+		{
+			(*stars)++;
+			spec++;
+		}
+		while ((*spec >= '0') && (*spec <= '9'))
+			spec++;
+	}
+	switch (*spec)
+	{
+	case 'h':
+		*length = (spec[1] == 'h') ? 'H' : 'h';
+		spec += (spec[1] == 'h') ? 2 : 1;
+		break;
+	case 'l':
+		*length = (spec[1] == 'l') ? 'q' : 'l';
+		spec += (spec[1] == 'l') ? 2 : 1;
+		break;
+	case 'j':
+	case 'z':
+	case 't':
+	case 'L':
+		*length = *spec++;
+		break;
+	}
+	*conv = *spec;
+	return (*spec != '\0') ? spec + 1 : spec;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Returns how the argument of a conversion is kept
+ *
+ * @param    conv Conversion character
+ * @param    length Length modifier from rte_log_parse_spec
+ * @return   enum rte_log_arg_type, -1 for an unsupported conversion
+ ****************************************************************************************************************************************/
+static int rte_log_arg_type(char conv, char length)
+{
+	if (conv == '\0')
+		return -1;
+	if (strchr("diouxX", conv) != NULL)
+		return RTE_LOG_ARG_INT;
+	if (strchr("fFeEgGaA", conv) != NULL)
+		return RTE_LOG_ARG_DOUBLE;
+	if ((conv == 'c') && (length == 0))
+		return RTE_LOG_ARG_CHAR;
+	if (conv == 'p')
+		return RTE_LOG_ARG_PTR;
+	if ((conv == 's') && (length == 0))
+		return RTE_LOG_ARG_STR;
+	return -1;
+}
+
+/****************************************************************************************************************************************
+ * @brief    Reads an integer argument with the type given by the conversion
+ *
+ * @param    args Variadic arguments
+ * @param    conv Conversion character
+ * @param    length Length modifier from rte_log_parse_spec
+ * @return   Value of the argument
+ ****************************************************************************************************************************************/
+static long long rte_log_get_int(va_list *args, char conv, char length)
+{
+	bool is_signed = (conv == 'd') || (conv == 'i');
+
+	switch (length)
+	{
+	case 'H':
+		return is_signed ? (long long)(signed char)va_arg(*args, int) : (long long)(unsigned char)va_arg(*args, unsigned int);
+	case 'h':
+		return is_signed ? (long long)(short)va_arg(*args, int) : (long long)(unsigned short)va_arg(*args, unsigned int);
+	case 'l':
+		return is_signed ? (long long)va_arg(*args, long) : (long long)va_arg(*args, unsigned long);
+	case 'q':
+		return is_signed ? va_arg(*args, long long) : (long long)va_arg(*args, unsigned long long);
+	case 'j':
+		return is_signed ? (long long)va_arg(*args, intmax_t) : (long long)va_arg(*args, uintmax_t);
+	case 'z':
+	{
+		size_t value = va_arg(*args, size_t);
+		return is_signed ? (long long)(ptrdiff_t)value : (long long)value;
+	}
+	case 't':
+	{
+		ptrdiff_t value = va_arg(*args, ptrdiff_t);
+		return is_signed ? (long long)value : (long long)(size_t)value;
+	}
+	default:
+		return is_signed ? (long long)va_arg(*args, int) : (long long)va_arg(*args, unsigned int);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief    Formats a deferred message into log_deferred_buffer. Each conversion is formatted on its own with the
+ *           captured argument, '*' is replaced by the captured width or precision.
+ *
+ * @param    record Captured message
+ * @return   void
+ ****************************************************************************************************************************************/
+static void rte_log_format(const struct rte_log_deferred *record)
+{
+	const char *fmt = record->fmt ? record->fmt : record->fmt_copy;
+	size_t len = 0;
+	uint8_t n = 0;
+
+	while ((*fmt != '\0') && (len < sizeof(log_deferred_buffer) - 1))
+	{
+		if (*fmt != '%')
+		{
+			log_deferred_buffer[len++] = *fmt++;
+			continue;
+		}
+
+		char conv, length;
+		int stars;
+		const char *end = rte_log_parse_spec(fmt + 1, &conv, &stars, &length);
+		if (conv == '%')
+		{
+			log_deferred_buffer[len++] = '%';
+			fmt = end;
+			continue;
+		}
+		if (n + stars + 1 > record->nargs)
+			break; // argument not captured, the message ends here
+
+		// Rebuild the conversion without the length modifier of the caller
+		char spec[32];
+		size_t pos = 0;
+		for (const char *c = fmt; c < end - 1; c++)
+		{
+			if (*c == '*')
+				pos += snprintf(&spec[pos], sizeof(spec) - 4 - pos, "%d", (int)record->args[n++].i);
+			else if (strchr("hljztL", *c) == NULL)
+				spec[pos++] = *c;
+			pos = MIN(pos, sizeof(spec) - 4);
+		}
+		if (record->types[n] == RTE_LOG_ARG_INT)
+		{
+			spec[pos++] = 'l';
+			spec[pos++] = 'l';
+		}
+		spec[pos++] = conv;
+		spec[pos] = '\0';
+
+		size_t room = sizeof(log_deferred_buffer) - len;
+		const union rte_log_arg *arg = &record->args[n];
+		int ret = 0;
+		switch (record->types[n++])
+		{
+		case RTE_LOG_ARG_INT:
+			ret = snprintf(&log_deferred_buffer[len], room, spec, arg->i);
+			break;
+		case RTE_LOG_ARG_CHAR:
+			ret = snprintf(&log_deferred_buffer[len], room, spec, (int)arg->i);
+			break;
+		case RTE_LOG_ARG_DOUBLE:
+			ret = snprintf(&log_deferred_buffer[len], room, spec, arg->d);
+			break;
+		case RTE_LOG_ARG_PTR:
+			ret = snprintf(&log_deferred_buffer[len], room, spec, arg->p);
+			break;
+		case RTE_LOG_ARG_STR:
+			ret = snprintf(&log_deferred_buffer[len], room, spec, &record->strings[arg->str]);
+			break;
+		}
+		len += MIN((size_t)MAX(ret, 0), room - 1);
+		fmt = end;
+	}
+	log_deferred_buffer[len] = '\0';
+}
+
+/****************************************************************************************************************************************
+ * @brief    Reports lost deferred messages in the zephyr log and in the RTE log, where the IDE shows them
+ *
+ * @param    what Kind of loss
+ * @param    count Number of messages
+ * @return   void
+ ****************************************************************************************************************************************/
+static void rte_log_deferred_report(const char *what, uint32_t count)
+{
+	char msg[64];
+	int len = snprintf(msg, sizeof(msg), "%u deferred rte messages %s", count, what);
+
+	LOG_WRN("%s", msg);
+	LogMessage(RTE_LOGLEVEL_WARNING, msg, (int8_t)MIN(len, (int)sizeof(msg) - 1));
+}
+
+/****************************************************************************************************************************************
+ * @brief    Formats the queued deferred messages and passes them to the zephyr logging system
+ *
+ * @param    work Work item
+ * @return   void
+ ****************************************************************************************************************************************/
+static void rte_log_deferred_handler(struct k_work *work)
+{
+	static struct rte_log_deferred record;
+
+	while (k_msgq_get(&log_deferred_queue, &record, K_NO_WAIT) == 0)
+	{
+		rte_log_format(&record);
+		LOG_WRN("[%u] %s", record.tick, log_deferred_buffer);
+	}
+
+	uint32_t dropped = atomic_clear(&log_deferred_dropped);
+	if (dropped > 0)
+	{
+		rte_log_deferred_report("dropped, queue full", dropped);
+	}
+	uint32_t truncated = atomic_clear(&log_deferred_truncated);
+	if (truncated > 0)
+	{
+		rte_log_deferred_report("truncated", truncated);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief    Formats all queued deferred messages, e.g. before the PLC module is unloaded
+ *
+ * @param    void
+ * @return   void
+ ****************************************************************************************************************************************/
+void rte_log_deferred_flush(void)
+{
+	struct k_work_sync sync;
+
+	k_work_submit(&log_deferred_work);
+	k_work_flush(&log_deferred_work, &sync);
+}
+
+/****************************************************************************************************************************************
+ * @brief    Deferred variant of rte_log_inf for PLC code. The arguments named by the format are captured, the message
+ *           is formatted later outside the PLC cycle. Up to RTE_LOG_DEFERRED_ARGS arguments and RTE_LOG_STR_SIZE bytes
+ *           of strings are kept, longer messages are truncated. Messages that don't fit into the queue are dropped,
+ *           losses are reported in the RTE log.
+ *
+ * @param    fmt printf like format
+ * @return   void
+ ****************************************************************************************************************************************/
+void rte_log_inf_deferred(const char *fmt, ...)
+{
+	extern char __rodata_region_start[];
+	extern char __rodata_region_end[];
+	struct rte_log_deferred record;
+	bool truncated = false;
+	va_list args;
+
+	record.tick = __tick;
+	if ((fmt >= __rodata_region_start) && (fmt < __rodata_region_end))
+	{
+		record.fmt = fmt;
+	}
+	else
+	{
+		size_t len = strnlen(fmt, sizeof(record.fmt_copy));
+		if (len == sizeof(record.fmt_copy))
+		{
+			len--;
+			truncated = true;
+		}
+		memcpy(record.fmt_copy, fmt, len);
+		record.fmt_copy[len] = '\0';
+		record.fmt = NULL;
+	}
+
+	// Read exactly the arguments the format names, a conversion that can't be kept ends the message
+	size_t str_used = 0;
+	record.nargs = 0;
+	va_start(args, fmt);
+	for (const char *p = strchr(record.fmt ? record.fmt : record.fmt_copy, '%'); p != NULL; p = strchr(p, '%'))
+	{
+		char conv, length;
+		int stars;
+		p = rte_log_parse_spec(p + 1, &conv, &stars, &length);
+		if (conv == '%')
+			continue;
+
+		int type = rte_log_arg_type(conv, length);
+		if ((type < 0) || (record.nargs + stars + 1 > RTE_LOG_DEFERRED_ARGS) || ((type == RTE_LOG_ARG_STR) && (str_used == sizeof(record.strings))))
+		{
+			truncated = (conv != '\0');
+			break;
+		}
+
+		for (; stars > 0; stars--)
+		{
+			record.types[record.nargs] = RTE_LOG_ARG_INT;
+			record.args[record.nargs++].i = va_arg(args, int);
+		}
+
+		union rte_log_arg *arg = &record.args[record.nargs];
+		record.types[record.nargs++] = type;
+		switch (type)
+		{
+		case RTE_LOG_ARG_INT:
+			arg->i = rte_log_get_int(&args, conv, length);
+			break;
+		case RTE_LOG_ARG_CHAR:
+			arg->i = va_arg(args, int);
+			break;
+		case RTE_LOG_ARG_DOUBLE:
+			arg->d = (length == 'L') ? (double)va_arg(args, long double) : va_arg(args, double);
+			break;
+		case RTE_LOG_ARG_PTR:
+			arg->p = va_arg(args, void *);
+			break;
+		case RTE_LOG_ARG_STR:
+		{
+			const char *str = va_arg(args, const char *);
+			size_t room = sizeof(record.strings) - str_used;
+			size_t len = strnlen(str ? str : "(null)", room);
+			if (len == room)
+			{
+				len--;
+				truncated = true;
+			}
+			memcpy(&record.strings[str_used], str ? str : "(null)", len);
+			record.strings[str_used + len] = '\0';
+			arg->str = str_used;
+			str_used += len + 1;
+			break;
+		}
+		}
+	}
+	va_end(args);
+
+	if (truncated)
+	{
+		atomic_inc(&log_deferred_truncated);
+	}
+	if (k_msgq_put(&log_deferred_queue, &record, K_NO_WAIT) != 0)
+	{
+		atomic_inc(&log_deferred_dropped);
+		return;
+	}
+	k_work_submit(&log_deferred_work);
+}
@@ -26,12 +26,17 @@ LOG_MODULE_REGISTER(plc_settings, LOG_LEVEL_INF);
 #include <zephyr/kernel.h>
 #include <zephyr/settings/settings.h>
 
+#include "config.h"
 #include "plc_settings.h"
 
 bool mount_sd_card = true;
 bool plc_autostart = true;
 bool plc_autostart_source = false;
+bool flight_recorder = false;
+int plc_flash_slot = -1;
 char hostname[64] = "default_hostname";
+char syslog_server[17] = "";
+int syslog_port = SYSLOG_DEFAULT_PORT;
 bool dhcp_active = true;
 int dhcp_timeout_sec = 0;
 bool fallback_ip = false;
@@ -67,10 +72,26 @@ static int settings_set(const char *name, size_t len, settings_read_cb read_cb,
 	{
 		read_cb(cb_arg, &plc_autostart_source, sizeof(plc_autostart_source));
 	}
+	else if (settings_name_steq(name, "flight_recorder", NULL))
+	{
+		read_cb(cb_arg, &flight_recorder, sizeof(flight_recorder));
+	}
+	else if (settings_name_steq(name, "flash_slot", NULL))
+	{
+		read_cb(cb_arg, &plc_flash_slot, sizeof(plc_flash_slot));
+	}
 	else if (settings_name_steq(name, "hostname", NULL))
 	{
 		read_cb(cb_arg, &hostname, sizeof(hostname));
 	}
+	else if (settings_name_steq(name, "syslog_server", NULL))
+	{
+		read_cb(cb_arg, &syslog_server, sizeof(syslog_server));
+	}
+	else if (settings_name_steq(name, "syslog_port", NULL))
+	{
+		read_cb(cb_arg, &syslog_port, sizeof(syslog_port));
+	}
 	else if (settings_name_steq(name, "dhcp_active", NULL))
 	{
 		read_cb(cb_arg, &dhcp_active, sizeof(dhcp_active));
@@ -128,7 +149,11 @@ static int settings_export(int (*cb)(const char *name, const void *val, size_t v
 {
 	cb("plc/mount_sd_card", &mount_sd_card, sizeof(mount_sd_card));
 	cb("plc/start_plc_at_boot", &plc_autostart, sizeof(plc_autostart));
+	cb("plc/flight_recorder", &flight_recorder, sizeof(flight_recorder));
+	cb("plc/flash_slot", &plc_flash_slot, sizeof(plc_flash_slot));
 	cb("network/hostname", &hostname, sizeof(hostname));
+	cb("network/syslog_server", &syslog_server, sizeof(syslog_server));
+	cb("network/syslog_port", &syslog_port, sizeof(syslog_port));
 	cb("network/dhcp_active", &dhcp_active, sizeof(dhcp_active));
 	cb("network/dhcp_timeout_sec", &dhcp_timeout_sec, sizeof(dhcp_timeout_sec));
 	cb("network/fallback_ip", &fallback_ip, sizeof(fallback_ip));
@@ -209,6 +234,38 @@ void set_plc_autostart_source_setting(bool value)
 	plc_settings_save();
 }
 
+/****************************************************************************************************************************************
+ * @brief  Returns whether trace samples are recorded to file while no IDE is attached.
+ * @return true if the flight recorder is enabled, otherwise false.
+ ****************************************************************************************************************************************/
+bool get_flight_recorder_setting(void) { return flight_recorder; }
+
+/****************************************************************************************************************************************
+ * @brief  Sets whether trace samples are recorded to file while no IDE is attached.
+ * @param value true to enable the flight recorder, otherwise false.
+ ****************************************************************************************************************************************/
+void set_flight_recorder_setting(bool value)
+{
+	flight_recorder = value;
+	plc_settings_save();
+}
+
+/****************************************************************************************************************************************
+ * @brief  Returns the flash slot the PLC module is loaded from.
+ * @return The slot number, -1 if the module is loaded from the file system.
+ ****************************************************************************************************************************************/
+int get_plc_flash_slot_setting(void) { return plc_flash_slot; }
+
+/****************************************************************************************************************************************
+ * @brief  Sets the flash slot the PLC module is loaded from.
+ * @param value The slot number, -1 to load the module from the file system.
+ ****************************************************************************************************************************************/
+void set_plc_flash_slot_setting(int value)
+{
+	plc_flash_slot = value;
+	plc_settings_save();
+}
+
 /****************************************************************************************************************************************
  * @brief  Returns the current hostname.
  * @return The current hostname as a string.
@@ -225,6 +282,38 @@ void set_hostname_setting(const char *value)
 	plc_settings_save();
 }
 
+/****************************************************************************************************************************************
+ * @brief  Returns the IPv4 address of the syslog server.
+ * @return The address as a string, empty if the syslog export is disabled.
+ ****************************************************************************************************************************************/
+char *get_syslog_server_setting(void) { return syslog_server; }
+
+/****************************************************************************************************************************************
+ * @brief  Sets the IPv4 address of the syslog server.
+ * @param value The address as a string, empty to disable the syslog export.
+ ****************************************************************************************************************************************/
+void set_syslog_server_setting(const char *value)
+{
+	strncpy(syslog_server, value, sizeof(syslog_server) - 1);
+	plc_settings_save();
+}
+
+/****************************************************************************************************************************************
+ * @brief  Returns the UDP port of the syslog server.
+ * @return The port number.
+ ****************************************************************************************************************************************/
+int get_syslog_port_setting(void) { return syslog_port; }
+
+/****************************************************************************************************************************************
+ * @brief  Sets the UDP port of the syslog server.
+ * @param value The port number.
+ ****************************************************************************************************************************************/
+void set_syslog_port_setting(int value)
+{
+	syslog_port = value;
+	plc_settings_save();
+}
+
 /****************************************************************************************************************************************
  * @brief  Returns whether DHCP is active.
  * @return true if DHCP is active, otherwise false.
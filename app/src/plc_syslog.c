@@ -0,0 +1,330 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+#ifdef CONFIG_PLC_SYSLOG
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log_backend.h>
+#include <zephyr/logging/log_ctrl.h>
+#include <zephyr/logging/log_output.h>
+#include <zephyr/posix/time.h>
+#include <zephyr/sys/ring_buffer.h>
+
+#include "config.h"
+#include "plc_settings.h"
+#include "plc_syslog.h"
+
+/************************************************************************************************************************/
+/*		syslog exporter																									*/
+/************************************************************************************************************************/
+
+// RTE log messages and the system log are formatted as RFC 5424 messages and queued. The syslog thread sends the queued
+// messages to the server set in the syslog_server setting, several messages separated by LF are coalesced into one
+// datagram of up to SYSLOG_DATAGRAM_SIZE bytes. Messages that don't fit into the queue are counted and reported.
+// The system log backend needs deferred log mode, its messages are formatted one after the other by the log thread,
+// never in an interrupt or in the thread that logged.
+// This module must not log itself, its messages would be exported again.
+
+#define SYSLOG_FACILITY_RTE		16		// local0
+#define SYSLOG_FACILITY_SYSTEM	17		// local1
+
+static uint8_t __ccm_noinit_section syslog_queue_data[SYSLOG_QUEUE_SIZE];
+static struct ring_buf syslog_queue = {.buffer = syslog_queue_data, .size = SYSLOG_QUEUE_SIZE};
+static struct k_spinlock syslog_lock;										// Protects syslog_queue, producers are the log writer and the log thread
+static uint32_t syslog_dropped = 0;											// Messages dropped since the last report
+static uint32_t syslog_dropped_total = 0;									// Messages dropped since start
+
+static char syslog_message[SYSLOG_MESSAGE_SIZE];							// Message being formatted by the system log backend, log thread only
+static size_t syslog_message_len = 0;
+static uint8_t syslog_output_buf[64];										// Line buffer of log_output
+
+/****************************************************************************************************************************************
+ * @brief                syslog_enqueue
+ *                       Adds a formatted message to the queue, messages are stored with a 16 bit length prefix.
+ * @param msg            Message.
+ * @param len            Length of the message.
+ * @return
+ ****************************************************************************************************************************************/
+static void syslog_enqueue(const char *msg, size_t len)
+{
+	uint16_t length = MIN(len, SYSLOG_MESSAGE_SIZE);
+
+	k_spinlock_key_t key = k_spin_lock(&syslog_lock);
+	if (ring_buf_space_get(&syslog_queue) < sizeof(length) + length)
+	{
+		syslog_dropped++;
+	}
+	else
+	{
+		ring_buf_put(&syslog_queue, (uint8_t *)&length, sizeof(length));
+		ring_buf_put(&syslog_queue, (const uint8_t *)msg, length);
+	}
+	k_spin_unlock(&syslog_lock, key);
+}
+
+/****************************************************************************************************************************************
+ * @brief                syslog_header
+ *                       Formats the RFC 5424 header of a message, PROCID, MSGID and STRUCTURED-DATA are nil.
+ * @param buf            Destination.
+ * @param size           Size of buf.
+ * @param pri            Priority, facility * 8 + severity.
+ * @param sec            Timestamp in seconds, realtime clock.
+ * @param nsec           Nanoseconds of the timestamp.
+ * @param app            APP-NAME field.
+ * @return               Length of the header.
+ ****************************************************************************************************************************************/
+static int syslog_header(char *buf, size_t size, int pri, uint32_t sec, uint32_t nsec, const char *app)
+{
+	struct tm tm;
+	time_t t = sec;
+
+	gmtime_r(&t, &tm);
+	int len = snprintf(buf, size, "<%d>1 %04d-%02d-%02dT%02d:%02d:%02d.%06uZ %s %s - - - ", pri, tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday,
+					   tm.tm_hour, tm.tm_min, tm.tm_sec, nsec / 1000, get_hostname_setting(), app);
+	return MIN(len, (int)size - 1);
+}
+
+/****************************************************************************************************************************************
+ * @brief                syslog_rte_message
+ *                       Exports a message of the RTE log, called by the log writer after the message was stored.
+ * @param level          RTE log level.
+ * @param tick           PLC tick of the message.
+ * @param sec            Timestamp in seconds.
+ * @param nsec           Nanoseconds of the timestamp.
+ * @param msg            Message text.
+ * @return
+ ****************************************************************************************************************************************/
+void syslog_rte_message(uint8_t level, uint32_t tick, uint32_t sec, uint32_t nsec, const char *msg)
+{
+	static const uint8_t severity[LOG_LEVELS] = {2, 4, 6, 7}; // critical, warning, info, debug
+	char buf[SYSLOG_MESSAGE_SIZE];
+
+	if (get_syslog_server_setting()[0] == '\0')
+		return;
+
+	int len = syslog_header(buf, sizeof(buf), SYSLOG_FACILITY_RTE * 8 + severity[MIN(level, LOG_LEVELS - 1)], sec, nsec, "plc");
+	len += snprintf(buf + len, sizeof(buf) - len, "tick=%u %s", tick, msg);
+	syslog_enqueue(buf, MIN(len, (int)sizeof(buf) - 1));
+}
+
+/****************************************************************************************************************************************
+ * @brief                syslog_dropped_count
+ *                       Returns the number of messages dropped because the queue was full.
+ * @param
+ * @return               Number of dropped messages since start.
+ ****************************************************************************************************************************************/
+uint32_t syslog_dropped_count(void) { return syslog_dropped_total + syslog_dropped; }
+
+/****************************************************************************************************************************************
+ * @brief                syslog_out
+ *                       Output function of log_output, collects the text of a system log message.
+ * @param data           Formatted output.
+ * @param length         Length of the output.
+ * @param ctx            Unused.
+ * @return               Number of bytes consumed, always all of them.
+ ****************************************************************************************************************************************/
+static int syslog_out(uint8_t *data, size_t length, void *ctx)
+{
+	ARG_UNUSED(ctx);
+
+	for (size_t i = 0; i < length; i++)
+	{
+		if ((data[i] != '\r') && (data[i] != '\n') && (syslog_message_len < sizeof(syslog_message) - 1))
+		{
+			syslog_message[syslog_message_len++] = data[i];
+		}
+	}
+	return length;
+}
+
+LOG_OUTPUT_DEFINE(syslog_output, syslog_out, syslog_output_buf, sizeof(syslog_output_buf));
+
+/****************************************************************************************************************************************
+ * @brief                syslog_process
+ *                       Backend process function, exports a system log message. Runs in the log thread, which
+ *                       serializes the use of syslog_message.
+ * @param backend        The backend.
+ * @param msg            Log message.
+ * @return
+ ****************************************************************************************************************************************/
+static void syslog_process(const struct log_backend *const backend, union log_msg_generic *msg)
+{
+	static const uint8_t severity[] = {7, 3, 4, 6, 7}; // none, error, warning, info, debug
+	struct timespec ts;
+
+	ARG_UNUSED(backend);
+
+	if (get_syslog_server_setting()[0] == '\0')
+		return;
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	uint8_t level = MIN(log_msg_get_level(&msg->log), ARRAY_SIZE(severity) - 1);
+	syslog_message_len = syslog_header(syslog_message, sizeof(syslog_message), SYSLOG_FACILITY_SYSTEM * 8 + severity[level], ts.tv_sec, ts.tv_nsec, "zephyr");
+	log_output_msg_process(&syslog_output, &msg->log, 0); // Module name and text, the header has time and level
+	log_output_flush(&syslog_output);
+	syslog_enqueue(syslog_message, syslog_message_len);
+}
+
+/****************************************************************************************************************************************
+ * @brief                syslog_dropped_process
+ *                       Messages dropped by the logging core are added to the drop counter.
+ * @param backend        The backend.
+ * @param cnt            Number of dropped messages.
+ * @return
+ ****************************************************************************************************************************************/
+static void syslog_dropped_process(const struct log_backend *const backend, uint32_t cnt)
+{
+	ARG_UNUSED(backend);
+
+	k_spinlock_key_t key = k_spin_lock(&syslog_lock);
+	syslog_dropped += cnt;
+	k_spin_unlock(&syslog_lock, key);
+}
+
+/****************************************************************************************************************************************
+ * @brief                syslog_panic
+ *                       Nothing is sent after a panic.
+ * @param backend        The backend.
+ * @return
+ ****************************************************************************************************************************************/
+static void syslog_panic(const struct log_backend *const backend) { log_backend_disable(backend); }
+
+static const struct log_backend_api syslog_backend_api = {
+	.process = syslog_process,
+	.dropped = syslog_dropped_process,
+	.panic = syslog_panic,
+};
+
+LOG_BACKEND_DEFINE(syslog_backend, syslog_backend_api, true);
+
+/****************************************************************************************************************************************
+ * @brief                syslog_fill_datagram
+ *                       Moves queued messages into a datagram, as many as fit. A report of dropped messages is added
+ *                       first.
+ * @param buf            Datagram buffer of SYSLOG_DATAGRAM_SIZE bytes.
+ * @return               Length of the datagram, 0 if nothing is queued.
+ ****************************************************************************************************************************************/
+static size_t syslog_fill_datagram(char *buf)
+{
+	size_t len = 0;
+	uint16_t length;
+
+	k_spinlock_key_t key = k_spin_lock(&syslog_lock);
+	uint32_t dropped = syslog_dropped;
+	syslog_dropped = 0;
+	syslog_dropped_total += dropped;
+	k_spin_unlock(&syslog_lock, key);
+
+	if (dropped > 0)
+	{
+		struct timespec ts;
+		clock_gettime(CLOCK_REALTIME, &ts);
+		len = syslog_header(buf, SYSLOG_DATAGRAM_SIZE, SYSLOG_FACILITY_SYSTEM * 8 + 4, ts.tv_sec, ts.tv_nsec, "syslog");
+		len += snprintf(buf + len, SYSLOG_DATAGRAM_SIZE - len, "%u messages dropped", dropped);
+	}
+
+	while (true)
+	{
+		key = k_spin_lock(&syslog_lock);
+		if ((ring_buf_peek(&syslog_queue, (uint8_t *)&length, sizeof(length)) != sizeof(length)) ||
+			(len + (len > 0 ? 1 : 0) + length > SYSLOG_DATAGRAM_SIZE) || ((len > 0) && !SYSLOG_COALESCE))
+		{
+			k_spin_unlock(&syslog_lock, key);
+			break;
+		}
+		if (len > 0)
+		{
+			buf[len++] = '\n';
+		}
+		ring_buf_get(&syslog_queue, NULL, sizeof(length));
+		len += ring_buf_get(&syslog_queue, (uint8_t *)buf + len, length);
+		k_spin_unlock(&syslog_lock, key);
+	}
+
+	return len;
+}
+
+/****************************************************************************************************************************************
+ * @brief                plc_syslog_thread
+ *                       Sends the queued messages every SYSLOG_PERIOD milliseconds, at most SYSLOG_MAX_DATAGRAMS
+ *                       datagrams per period. Messages are kept in the queue while no server is reachable.
+ * @param
+ * @return
+ ****************************************************************************************************************************************/
+#define SYSLOG_STACK_SIZE 1536
+#define SYSLOG_PRIORITY 9
+
+void plc_syslog_thread(void *, void *, void *)
+{
+	static char datagram[SYSLOG_DATAGRAM_SIZE];
+	struct sockaddr_in server_addr;
+	int sock = -1;
+
+	while (true)
+	{
+		k_msleep(SYSLOG_PERIOD);
+
+		const char *server = get_syslog_server_setting();
+		if (server[0] == '\0')
+		{
+			k_spinlock_key_t key = k_spin_lock(&syslog_lock);
+			ring_buf_reset(&syslog_queue); // Export disabled
+			k_spin_unlock(&syslog_lock, key);
+			continue;
+		}
+
+		memset(&server_addr, 0, sizeof(server_addr));
+		server_addr.sin_family = AF_INET;
+		server_addr.sin_port = htons(get_syslog_port_setting());
+		if (inet_pton(AF_INET, server, &server_addr.sin_addr) != 1)
+			continue;
+
+		if (sock < 0)
+		{
+			sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+			if (sock < 0)
+				continue;
+		}
+
+		for (int i = 0; i < SYSLOG_MAX_DATAGRAMS; i++)
+		{
+			size_t len = syslog_fill_datagram(datagram);
+			if (len == 0)
+				break;
+
+			if (sendto(sock, datagram, len, 0, (struct sockaddr *)&server_addr, sizeof(server_addr)) < 0)
+			{
+				close(sock); // Network not up yet, the datagram is lost
+				sock = -1;
+				break;
+			}
+		}
+	}
+}
+
+K_THREAD_DEFINE_CCM(plc_syslog, SYSLOG_STACK_SIZE, plc_syslog_thread, NULL, NULL, NULL, SYSLOG_PRIORITY, 0, HTTP_SERVER_STARTUP_DELAY);
+
+#endif
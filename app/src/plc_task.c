@@ -113,6 +113,8 @@ void plc_main_task(void *, void *, void *)
 
 			k_sem_take(&plc_cycle_start, K_FOREVER); // PLC Cycle start
 			config_run__(__tick);
+			apply_output_writes();			// outputs written by the JSON API, overwrite the program once
+			update_statistics();			// aggregate watched variables at cycle end
 			k_sem_give(&plc_cycle_start); // PLC Cycle end
 
 			plc_update_outputs(plc_run);
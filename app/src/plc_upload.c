@@ -0,0 +1,462 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_upload, LOG_LEVEL_INF);
+
+#include <errno.h>
+#include <string.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <zephyr/sys/crc.h>
+#include <mbedtls/md5.h>
+
+#include "config.h"
+#include "plc_loader.h"
+#include "plc_upload.h"
+
+/***************************************************************************************************************************************/
+/*		write-behind file upload																							 		   */
+/***************************************************************************************************************************************/
+
+// The rpc thread copies the received chunks into one of UPLOAD_BUFFER_COUNT buffers and continues with the next request while
+// the storage worker writes full buffers to the file. Every buffer except the last one of a file starts at a multiple of
+// UPLOAD_BUFFER_SIZE, so the sd card is written in whole sectors. Files are only synced when they are closed.
+// A plc module can be streamed into a flash slot instead of a file, the slot is erased when it is opened and the crc of
+// the module is checked when it is closed.
+// If the session negotiated TRANSFER_ENCODING_UPLOAD_HANDLE the md5 blobID of the upload is calculated here as well, over
+// the seed and each buffer next to its write, and finished once by upload_hash_end. The rpc thread reads it after upload_sync.
+
+enum upload_op
+{
+	UPLOAD_OPEN,
+	UPLOAD_OPEN_FLASH,
+	UPLOAD_WRITE,
+	UPLOAD_CLOSE,
+	UPLOAD_SYNC,
+	UPLOAD_HASH_BEGIN,
+	UPLOAD_HASH,
+	UPLOAD_HASH_END,
+};
+
+struct upload_request
+{
+	uint8_t op;
+	uint8_t buffer;
+	uint8_t area;
+	uint8_t reserved;
+	uint32_t length;
+	uint8_t *digest;
+	char filename[33];
+};
+
+static uint8_t __ccm_noinit_section upload_buffers[UPLOAD_BUFFER_COUNT][UPLOAD_BUFFER_SIZE] __aligned(4);
+static uint32_t upload_active = 0;											// Buffer filled by the rpc thread
+static uint32_t upload_fill = 0;											// Bytes in the active buffer
+static bool upload_claimed = false;											// Active buffer is owned by the rpc thread
+static atomic_t upload_error = ATOMIC_INIT(0);								// First error of the storage worker, kept until upload_reset
+
+K_MSGQ_DEFINE(upload_queue, sizeof(struct upload_request), UPLOAD_QUEUE_SIZE, 4);
+K_SEM_DEFINE(upload_buffer_free, UPLOAD_BUFFER_COUNT, UPLOAD_BUFFER_COUNT);
+K_SEM_DEFINE(upload_synced, 0, 1);
+
+/****************************************************************************************************************************************
+ * @brief 			Queues a request for the storage worker, waits if the queue is full.
+ *
+ * @param op 		Requested operation.
+ * @param buffer 	Buffer index for UPLOAD_WRITE.
+ * @param length 	Number of bytes for UPLOAD_WRITE.
+ * @param filename 	File name for UPLOAD_OPEN, otherwise NULL.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static void upload_queue_request(enum upload_op op, uint32_t buffer, uint32_t length, const char *filename)
+{
+	struct upload_request request = {.op = op, .buffer = buffer, .length = length};
+
+	if (filename != NULL)
+	{
+		strncpy(request.filename, filename, sizeof(request.filename) - 1);
+	}
+	k_msgq_put(&upload_queue, &request, K_FOREVER);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Hands the active buffer to the storage worker and switches to the next buffer.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static void upload_submit(void)
+{
+	if (upload_claimed)
+	{
+		upload_queue_request(UPLOAD_WRITE, upload_active, upload_fill, NULL);
+		upload_active = (upload_active + 1) % UPLOAD_BUFFER_COUNT;
+		upload_fill = 0;
+		upload_claimed = false;
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Starts a new upload file, an open file is closed first.
+ *
+ * @param filename 	Name of the file, created or truncated.
+ * @return 			0 on success, -ENAMETOOLONG if the name does not fit a request.
+ ****************************************************************************************************************************************/
+int upload_open(const char *filename)
+{
+	if (strlen(filename) >= sizeof(((struct upload_request *)0)->filename))
+	{
+		return -ENAMETOOLONG;
+	}
+
+	upload_close();
+	upload_queue_request(UPLOAD_OPEN, 0, 0, filename);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Starts streaming a plc module into a flash area, an open file is closed first.
+ *
+ * @param area 		Flash area id of the slot, erased by the storage worker.
+ * @return 			0 on success.
+ ****************************************************************************************************************************************/
+int upload_open_flash(uint8_t area)
+{
+	upload_close();
+	struct upload_request request = {.op = UPLOAD_OPEN_FLASH, .area = area};
+	k_msgq_put(&upload_queue, &request, K_FOREVER);
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Appends data to the open upload file. The data is copied, the function only waits if all buffers are
+ * 					still being written.
+ *
+ * @param data 		Data to append.
+ * @param length 	Number of bytes.
+ * @return 			0 on success, the error of the storage worker if a previous write failed.
+ ****************************************************************************************************************************************/
+int upload_write(const uint8_t *data, size_t length)
+{
+	int err = atomic_get(&upload_error);
+	if (err != 0)
+	{
+		return err;
+	}
+
+	while (length > 0)
+	{
+		if (!upload_claimed)
+		{
+			k_sem_take(&upload_buffer_free, K_FOREVER);
+			upload_claimed = true;
+		}
+
+		size_t count = MIN(length, UPLOAD_BUFFER_SIZE - upload_fill);
+		memcpy(&upload_buffers[upload_active][upload_fill], data, count);
+		upload_fill += count;
+		data += count;
+		length -= count;
+
+		if (upload_fill == UPLOAD_BUFFER_SIZE)
+		{
+			upload_submit();
+		}
+	}
+	return 0;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Queues the remaining data of the upload file and closes it.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void upload_close(void)
+{
+	upload_submit();
+	upload_queue_request(UPLOAD_CLOSE, 0, 0, NULL);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Waits until the storage worker has written all queued data and synced the open file.
+ *
+ * @return 			0 on success, the first error of the storage worker otherwise.
+ ****************************************************************************************************************************************/
+int upload_sync(void)
+{
+	upload_submit();
+	upload_queue_request(UPLOAD_SYNC, 0, 0, NULL);
+	k_sem_take(&upload_synced, K_FOREVER);
+	return atomic_get(&upload_error);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Starts the md5 of the next upload with the seed, the data written until upload_hash_end is added by the
+ * 					storage worker. The seed is copied like the data but only hashed.
+ *
+ * @param seed 		Seed of the blob.
+ * @param length 	Length of the seed.
+ * @param digest 	Receives the 16 byte md5 with upload_hash_end, valid after the next upload_sync.
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void upload_hash_begin(const uint8_t *seed, size_t length, uint8_t *digest)
+{
+	struct upload_request request = {.op = UPLOAD_HASH_BEGIN, .digest = digest};
+
+	upload_submit();
+	k_msgq_put(&upload_queue, &request, K_FOREVER);
+
+	while (length > 0)
+	{
+		size_t count = MIN(length, UPLOAD_BUFFER_SIZE);
+
+		k_sem_take(&upload_buffer_free, K_FOREVER);
+		memcpy(upload_buffers[upload_active], seed, count);
+		upload_queue_request(UPLOAD_HASH, upload_active, count, NULL);
+		upload_active = (upload_active + 1) % UPLOAD_BUFFER_COUNT;
+		seed += count;
+		length -= count;
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Finishes the md5 started by upload_hash_begin after the queued data, does nothing if none is running.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void upload_hash_end(void)
+{
+	upload_submit();
+	upload_queue_request(UPLOAD_HASH_END, 0, 0, NULL);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Closes the upload file, waits for the storage worker and clears a previous error.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void upload_reset(void)
+{
+	upload_close();
+	upload_hash_end();
+	upload_sync();
+	atomic_clear(&upload_error);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Storage worker, executes the queued requests in order. After an error the remaining data is discarded
+ * 					until upload_reset.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+static const struct flash_area *upload_flash = NULL;						// Flash slot written instead of a file
+static off_t upload_flash_offset;
+static uint32_t upload_flash_crc;											// crc of the module without header
+static file_header_t upload_flash_header;
+static mbedtls_md5_context upload_md5;										// md5 of the upload for TRANSFER_ENCODING_UPLOAD_HANDLE
+static uint8_t *upload_md5_digest = NULL;									// Destination of the md5, NULL if none is running
+
+/****************************************************************************************************************************************
+ * @brief 			Opens and erases a flash slot for a plc module.
+ *
+ * @param area 		Flash area id.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int upload_flash_open(uint8_t area)
+{
+	int ret = flash_area_open(area, &upload_flash);
+	if (ret == 0)
+	{
+		ret = flash_area_erase(upload_flash, 0, upload_flash->fa_size);
+		if (ret != 0)
+		{
+			flash_area_close(upload_flash);
+			upload_flash = NULL;
+		}
+	}
+	else
+	{
+		upload_flash = NULL;
+	}
+	upload_flash_offset = 0;
+	upload_flash_crc = 0;
+	memset(&upload_flash_header, 0, sizeof(upload_flash_header));
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Writes a buffer to the flash slot and updates the crc, the module header is kept for the check.
+ *
+ * @param data 		Data to write.
+ * @param length 	Number of bytes.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int upload_flash_write(const uint8_t *data, size_t length)
+{
+	if (upload_flash_offset + length > upload_flash->fa_size)
+	{
+		return -EFBIG;
+	}
+
+	int ret = flash_area_write(upload_flash, upload_flash_offset, data, length);
+	if (ret == 0)
+	{
+		size_t header = 0;
+		if (upload_flash_offset < sizeof(file_header_t))
+		{
+			header = MIN(sizeof(file_header_t) - upload_flash_offset, length);
+			memcpy((uint8_t *)&upload_flash_header + upload_flash_offset, data, header);
+		}
+		upload_flash_crc = crc32_ieee_update(upload_flash_crc, data + header, length - header);
+		upload_flash_offset += length;
+	}
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Closes the flash slot and checks the written module.
+ *
+ * @return 			0 if the module is valid, -EBADMSG otherwise.
+ ****************************************************************************************************************************************/
+static int upload_flash_close(void)
+{
+	int ret = 0;
+	if ((upload_flash_offset < sizeof(file_header_t)) || (upload_flash_header.sign != SIGN) || (upload_flash_header.crc != upload_flash_crc))
+	{
+		LOG_ERR("plc module in flash slot invalid, crc 0x%08x expected 0x%08x", upload_flash_crc, upload_flash_header.crc);
+		ret = -EBADMSG;
+	}
+	flash_area_close(upload_flash);
+	upload_flash = NULL;
+	return ret;
+}
+
+#define UPLOAD_STACK_SIZE 1536
+#define UPLOAD_PRIORITY 6
+
+void upload_thread(void *, void *, void *)
+{
+	struct upload_request request;
+	struct fs_file_t file;
+	bool open = false;
+	int ret;
+
+	while (true)
+	{
+		k_msgq_get(&upload_queue, &request, K_FOREVER);
+
+		switch (request.op)
+		{
+		case UPLOAD_OPEN_FLASH:
+			ret = upload_flash_open(request.area);
+			break;
+
+		case UPLOAD_OPEN:
+			fs_file_t_init(&file);
+			ret = fs_open(&file, request.filename, FS_O_CREATE | FS_O_WRITE);
+			if (ret == 0)
+			{
+				open = true;
+				ret = fs_truncate(&file, 0);
+			}
+			break;
+
+		case UPLOAD_WRITE:
+			ret = 0;
+			if (upload_md5_digest != NULL)
+			{
+				mbedtls_md5_update(&upload_md5, upload_buffers[request.buffer], request.length);
+			}
+			if ((upload_flash != NULL) && (atomic_get(&upload_error) == 0))
+			{
+				ret = upload_flash_write(upload_buffers[request.buffer], request.length);
+			}
+			else if (open && (atomic_get(&upload_error) == 0))
+			{
+				ret = fs_write(&file, upload_buffers[request.buffer], request.length);
+				ret = (ret == request.length) ? 0 : (ret < 0) ? ret : -EIO;
+			}
+			k_sem_give(&upload_buffer_free);
+			break;
+
+		case UPLOAD_CLOSE:
+			ret = open ? fs_close(&file) : 0;
+			open = false;
+			if (upload_flash != NULL)
+			{
+				ret = upload_flash_close();
+			}
+			break;
+
+		case UPLOAD_SYNC:
+			ret = open ? fs_sync(&file) : 0;
+			break;
+
+		case UPLOAD_HASH_BEGIN:
+			if (upload_md5_digest != NULL)
+			{
+				mbedtls_md5_free(&upload_md5);
+			}
+			mbedtls_md5_init(&upload_md5);
+			mbedtls_md5_starts(&upload_md5);
+			upload_md5_digest = request.digest;
+			ret = 0;
+			break;
+
+		case UPLOAD_HASH:
+			if (upload_md5_digest != NULL)
+			{
+				mbedtls_md5_update(&upload_md5, upload_buffers[request.buffer], request.length);
+			}
+			k_sem_give(&upload_buffer_free);
+			ret = 0;
+			break;
+
+		case UPLOAD_HASH_END:
+			if (upload_md5_digest != NULL)
+			{
+				mbedtls_md5_finish(&upload_md5, upload_md5_digest);
+				mbedtls_md5_free(&upload_md5);
+				upload_md5_digest = NULL;
+			}
+			ret = 0;
+			break;
+
+		default:
+			ret = 0;
+			break;
+		}
+
+		if (ret < 0)
+		{
+			LOG_ERR("upload request %u failed: %d", request.op, ret);
+			atomic_cas(&upload_error, 0, ret);
+		}
+		if (request.op == UPLOAD_SYNC)
+		{
+			k_sem_give(&upload_synced);
+		}
+	}
+}
+
+K_THREAD_DEFINE_CCM(upload_worker, UPLOAD_STACK_SIZE, upload_thread, NULL, NULL, NULL, UPLOAD_PRIORITY, 0, RPC_SERVER_STARTUP_DELAY);
@@ -0,0 +1,285 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(plc_www_bundle, LOG_LEVEL_INF);
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <zephyr/fs/fs.h>
+#include <zephyr/kernel.h>
+#include <zephyr/storage/flash_map.h>
+#include <mbedtls/md5.h>
+
+#include "config.h"
+#include "plc_blobstore.h"
+#include "plc_www_bundle.h"
+
+/***************************************************************************************************************************************/
+/*		read-only web bundle in flash																						 		   */
+/***************************************************************************************************************************************/
+
+// The web files installed in HTTP_ROOT are packed into one image in www_partition: header, directory sorted by name and
+// the file contents. The partition has to be in the internal flash, so the http server can look files up with a binary
+// search and send them straight from the memory mapped flash, without the filesystem. Boards without www_partition serve
+// the web files from the filesystem only, app/boards/PLC_STM32F407VE_www_bundle.overlay adds it to PLC_STM32F407VE.
+
+#if FIXED_PARTITION_EXISTS(www_partition)
+
+#define WWW_BUNDLE_ID			FIXED_PARTITION_ID(www_partition)
+#define WWW_BUNDLE_ADDRESS		((uintptr_t)DT_REG_ADDR(DT_GPARENT(DT_NODELABEL(www_partition))) + FIXED_PARTITION_OFFSET(www_partition))
+
+static atomic_t bundle_users = ATOMIC_INIT(0);	  // Responses sending from the image
+static atomic_t bundle_building = ATOMIC_INIT(0); // Image is erased and written
+
+static const struct www_bundle_header *bundle_header(void) { return (const struct www_bundle_header *)WWW_BUNDLE_ADDRESS; }
+static const struct www_bundle_entry *bundle_directory(void) { return (const struct www_bundle_entry *)(bundle_header() + 1); }
+
+static int bundle_compare(const void *a, const void *b)
+{
+	return strcmp(((const struct www_bundle_entry *)a)->name, ((const struct www_bundle_entry *)b)->name);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Copies a file into the image and calculates its md5.
+ *
+ * @param fa 		Flash area of the image.
+ * @param entry 	Directory entry with name and size, receives the md5.
+ * @param buffer 	Copy buffer of WWW_BUNDLE_BLOCK_SIZE bytes.
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+static int bundle_write_file(const struct flash_area *fa, struct www_bundle_entry *entry, uint8_t *buffer)
+{
+	char path[sizeof(HTTP_ROOT) + WWW_BUNDLE_NAME_SIZE];
+	struct fs_file_t file;
+	mbedtls_md5_context md5;
+	uint32_t offset = 0;
+	int ret;
+
+	snprintf(path, sizeof(path), "%s%s", HTTP_ROOT, entry->name);
+	fs_file_t_init(&file);
+	ret = fs_open(&file, path, FS_O_READ);
+	if (ret != 0)
+	{
+		return ret;
+	}
+
+	mbedtls_md5_init(&md5);
+	mbedtls_md5_starts(&md5);
+	while ((ret == 0) && (offset < entry->size))
+	{
+		ssize_t count = fs_read(&file, buffer, MIN(WWW_BUNDLE_BLOCK_SIZE, entry->size - offset));
+		if (count <= 0)
+		{
+			ret = (count < 0) ? count : -EIO; // File changed while the bundle is built
+			break;
+		}
+		mbedtls_md5_update(&md5, buffer, count);
+		size_t length = ROUND_UP(count, 4);
+		memset(&buffer[count], 0xFF, length - count);
+		ret = flash_area_write(fa, entry->offset + offset, buffer, length);
+		offset += count;
+	}
+	mbedtls_md5_finish(&md5, entry->id);
+	mbedtls_md5_free(&md5);
+	fs_close(&file);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Packs the web files in HTTP_ROOT into www_partition. Waits until no response is sent from the old image.
+ * 					Without a valid image, the web files are served from the filesystem.
+ *
+ * @return 			0 on success, negative error code otherwise.
+ ****************************************************************************************************************************************/
+int www_bundle_build(void)
+{
+	const struct flash_area *fa;
+	struct www_bundle_header header = {.magic = WWW_BUNDLE_MAGIC};
+	struct fs_dir_t dir;
+	struct fs_dirent dirent;
+	struct blob_info info;
+	struct timespec ts;
+	int ret;
+
+	struct www_bundle_entry *entries = k_malloc(WWW_BUNDLE_MAX_FILES * sizeof(struct www_bundle_entry));
+	uint8_t *buffer = k_malloc(WWW_BUNDLE_BLOCK_SIZE);
+	if ((entries == NULL) || (buffer == NULL))
+	{
+		k_free(entries);
+		k_free(buffer);
+		return -ENOMEM;
+	}
+	memset(entries, 0, WWW_BUNDLE_MAX_FILES * sizeof(struct www_bundle_entry));
+
+	// Directory of the image, empty without web files
+	ret = 0;
+	fs_dir_t_init(&dir);
+	if (fs_opendir(&dir, HTTP_ROOT) == 0)
+	{
+		while ((ret == 0) && (fs_readdir(&dir, &dirent) == 0) && (dirent.name[0] != '\0'))
+		{
+			if ((dirent.type != FS_DIR_ENTRY_FILE) || (strstr(dirent.name, ".tmp") != NULL))
+			{
+				continue;
+			}
+			if ((header.count == WWW_BUNDLE_MAX_FILES) || (strlen(dirent.name) >= WWW_BUNDLE_NAME_SIZE))
+			{
+				LOG_ERR("web file %s doesn't fit into the bundle", dirent.name);
+				ret = -EFBIG;
+				break;
+			}
+			strcpy(entries[header.count].name, dirent.name);
+			entries[header.count].size = dirent.size;
+			header.count++;
+		}
+		fs_closedir(&dir);
+	}
+	qsort(entries, header.count, sizeof(struct www_bundle_entry), bundle_compare);
+
+	clock_gettime(CLOCK_REALTIME, &ts);
+	header.size = sizeof(header) + header.count * sizeof(struct www_bundle_entry);
+	for (uint32_t i = 0; i < header.count; i++)
+	{
+		char path[sizeof(HTTP_ROOT) + WWW_BUNDLE_NAME_SIZE];
+		snprintf(path, sizeof(path), "%s%s", HTTP_ROOT, entries[i].name);
+		entries[i].installed = blob_store_stat(path, &info) ? info.installed : ts.tv_sec;
+		entries[i].offset = ROUND_UP(header.size, 4);
+		header.size = entries[i].offset + entries[i].size;
+	}
+
+	if (flash_area_open(WWW_BUNDLE_ID, &fa) != 0)
+	{
+		k_free(entries);
+		k_free(buffer);
+		return -ENODEV;
+	}
+
+	// no response may read the image while it is erased, the old image is dropped in any case
+	atomic_set(&bundle_building, 1);
+	while (atomic_get(&bundle_users) > 0)
+	{
+		k_msleep(10);
+	}
+	int err = flash_area_erase(fa, 0, fa->fa_size);
+	if ((ret == 0) && (header.size > fa->fa_size))
+	{
+		LOG_ERR("web files need %u bytes, www_partition has %u", header.size, (uint32_t)fa->fa_size);
+		ret = -EFBIG;
+	}
+	if (ret == 0)
+	{
+		ret = err;
+	}
+	for (uint32_t i = 0; (ret == 0) && (i < header.count); i++)
+	{
+		ret = bundle_write_file(fa, &entries[i], buffer);
+	}
+	if (ret == 0)
+	{
+		ret = flash_area_write(fa, sizeof(header), entries, header.count * sizeof(struct www_bundle_entry));
+	}
+	if (ret == 0)
+	{
+		ret = flash_area_write(fa, 0, &header, sizeof(header));
+	}
+	if ((ret != 0) && (err == 0))
+	{
+		flash_area_erase(fa, 0, fa->fa_size); // no partial image is left
+	}
+	flash_area_close(fa);
+	atomic_set(&bundle_building, 0);
+
+	if (ret == 0)
+	{
+		LOG_INF("web bundle: %u files, %u bytes", header.count, header.size);
+	}
+	else
+	{
+		LOG_ERR("web bundle not built: %d", ret);
+	}
+	k_free(entries);
+	k_free(buffer);
+	return ret;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Keeps the image from being rebuilt while a response is sent from it.
+ *
+ * @return 			true if a valid image is present, www_bundle_release has to be called then.
+ ****************************************************************************************************************************************/
+bool www_bundle_acquire(void)
+{
+	atomic_inc(&bundle_users);
+	if (atomic_get(&bundle_building) || (bundle_header()->magic != WWW_BUNDLE_MAGIC) || (bundle_header()->count > WWW_BUNDLE_MAX_FILES))
+	{
+		atomic_dec(&bundle_users);
+		return false;
+	}
+	return true;
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Releases the image acquired by www_bundle_acquire.
+ *
+ * @return 			None.
+ ****************************************************************************************************************************************/
+void www_bundle_release(void) { atomic_dec(&bundle_users); }
+
+/****************************************************************************************************************************************
+ * @brief 			Looks up a file in the image, only while the image is acquired.
+ *
+ * @param name 		Path relative to HTTP_ROOT.
+ * @return 			Directory entry or NULL if the file is not bundled.
+ ****************************************************************************************************************************************/
+const struct www_bundle_entry *www_bundle_find(const char *name)
+{
+	struct www_bundle_entry key;
+
+	if (strlen(name) >= WWW_BUNDLE_NAME_SIZE)
+	{
+		return NULL;
+	}
+	strcpy(key.name, name);
+	return bsearch(&key, bundle_directory(), bundle_header()->count, sizeof(struct www_bundle_entry), bundle_compare);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Gets the content of a bundled file in the memory mapped flash.
+ *
+ * @param entry 	Directory entry from www_bundle_find.
+ * @return 			Content of the file.
+ ****************************************************************************************************************************************/
+const uint8_t *www_bundle_data(const struct www_bundle_entry *entry) { return (const uint8_t *)(WWW_BUNDLE_ADDRESS + entry->offset); }
+
+#else
+
+int www_bundle_build(void) { return -ENOTSUP; }
+bool www_bundle_acquire(void) { return false; }
+void www_bundle_release(void) {}
+const struct www_bundle_entry *www_bundle_find(const char *name) { return NULL; }
+const uint8_t *www_bundle_data(const struct www_bundle_entry *entry) { return NULL; }
+
+#endif
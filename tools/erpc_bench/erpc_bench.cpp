@@ -0,0 +1,497 @@
+/****************************************************************************
+#  Project Name: Beremiz 4 uC                                               #
+#  Author(s): nandibrenna                                                   #
+#  Created: 2024-03-15                                                      #
+#  ======================================================================== #
+#  Copyright © 2024 nandibrenna                                             #
+#                                                                           #
+#  Licensed under the Apache License, Version 2.0 (the "License");          #
+#  you may not use this file except in compliance with the License.         #
+#  You may obtain a copy of the License at                                  #
+#                                                                           #
+#      http://www.apache.org/licenses/LICENSE-2.0                           #
+#                                                                           #
+#  Unless required by applicable law or agreed to in writing, software      #
+#  distributed under the License is distributed on an "AS IS" BASIS,        #
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or          #
+#  implied. See the License for the specific language governing             #
+#  permissions and limitations under the License.                           #
+#                                                                           #
+****************************************************************************/
+
+// Host side load generator and latency benchmark for the eRPC server of the runtime. Every client thread opens its own
+// connection and calls the generated client shim, the latency of each call is measured on the host.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include "erpc_basic_codec.hpp"
+#include "erpc_client_manager.h"
+#include "erpc_config_internal.h"
+#include "erpc_crc16.hpp"
+#include "erpc_message_buffer.hpp"
+#include "erpc_port.h"
+#include "erpc_tcp_transport.hpp"
+#include "erpc_PLCObject_client.hpp"
+
+using namespace erpc;
+using namespace erpcShim;
+using bench_clock = std::chrono::steady_clock;
+
+#define DEFAULT_PORT 1042				// ERPC_SERVER_PORT of the runtime
+#define DEFAULT_CHUNK_SIZE 896			// fits one ERPC_DEFAULT_BUFFER_SIZE message of the runtime
+#define DEFAULT_UPLOAD_SIZE (64 * 1024)
+#define TRANSFER_ENCODING_TRACE_DELTA 2	// see plc_compress.h
+
+/***************************************************************************************************************************************/
+/*		options and results																									 		   */
+/***************************************************************************************************************************************/
+
+struct bench_options
+{
+	std::string host = "127.0.0.1";
+	uint16_t port = DEFAULT_PORT;
+	unsigned clients = 1;
+	unsigned seconds = 10;
+	unsigned requests = 0;				// per client, 0 to run for the given time
+	uint32_t chunk_size = DEFAULT_CHUNK_SIZE;
+	uint32_t upload_size = DEFAULT_UPLOAD_SIZE;
+	std::vector<uint32_t> trace_vars = {0};
+	bool trace_delta = false;
+	std::string test;
+};
+
+// Latencies and transferred bytes of one kind of call
+struct bench_series
+{
+	std::string name;
+	std::vector<double> latency_us;
+	uint64_t bytes = 0;
+	uint64_t errors = 0;
+};
+
+static thread_local erpc_status_t call_status;
+
+static void bench_error_handler(erpc_status_t err, uint32_t functionID)
+{
+	if (err != kErpcStatus_Success)
+	{
+		call_status = err;
+	}
+}
+
+/***************************************************************************************************************************************/
+/*		client connection																									 		   */
+/***************************************************************************************************************************************/
+
+/****************************************************************************************************************************************
+ * @brief 			Message buffers allocated on the heap, one client uses one buffer per request.
+ ****************************************************************************************************************************************/
+class HeapBufferFactory : public MessageBufferFactory
+{
+public:
+	virtual MessageBuffer create(void) override { return MessageBuffer(new uint8_t[ERPC_DEFAULT_BUFFER_SIZE], ERPC_DEFAULT_BUFFER_SIZE); }
+
+	virtual void dispose(MessageBuffer *buf) override { delete[] buf->get(); }
+};
+
+/****************************************************************************************************************************************
+ * @brief 			One connection to the runtime with its own transport, codec and client manager.
+ ****************************************************************************************************************************************/
+class BenchClient
+{
+public:
+	BenchClient(const bench_options &options) : m_transport(options.host.c_str(), options.port, false), m_plc(&m_manager)
+	{
+		m_transport.setCrc16(&m_crc);
+		m_manager.setTransport(&m_transport);
+		m_manager.setCodecFactory(&m_codecs);
+		m_manager.setMessageBufferFactory(&m_buffers);
+		m_manager.setErrorHandler(bench_error_handler);
+	}
+
+	~BenchClient() { m_transport.close(); }
+
+	bool open(void) { return m_transport.open() == kErpcStatus_Success; }
+
+	BeremizPLCObjectService_client &plc(void) { return m_plc; }
+
+private:
+	Crc16 m_crc;
+	TCPTransport m_transport;
+	BasicCodecFactory m_codecs;
+	HeapBufferFactory m_buffers;
+	ClientManager m_manager;
+	BeremizPLCObjectService_client m_plc;
+};
+
+/****************************************************************************************************************************************
+ * @brief 			Performs one call and checks transport and result.
+ *
+ * @param call 		Performs the call and returns the result of the served function.
+ * @return 			true if the transport and the served function succeeded.
+ ****************************************************************************************************************************************/
+template <typename F> static bool checked_call(F call)
+{
+	call_status = kErpcStatus_Success;
+	uint32_t result = call();
+	return (call_status == kErpcStatus_Success) && (result == 0);
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Times one call and adds it to the series.
+ *
+ * @param series 	Series of the call.
+ * @param bytes 	Payload bytes of the call, counted if it succeeds.
+ * @param call 		Performs the call and returns the result of the served function.
+ * @return 			true if the transport and the served function succeeded.
+ ****************************************************************************************************************************************/
+template <typename F> static bool timed_call(bench_series &series, uint64_t bytes, F call)
+{
+	auto start = bench_clock::now();
+	bool ok = checked_call(call);
+	auto end = bench_clock::now();
+
+	if (!ok)
+	{
+		series.errors++;
+		return false;
+	}
+	series.latency_us.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+	series.bytes += bytes;
+	return true;
+}
+
+static void free_binary(binary_t *data)
+{
+	erpc_free(data->data);
+	data->data = NULL;
+	data->dataLength = 0;
+}
+
+/***************************************************************************************************************************************/
+/*		tests																												 		   */
+/***************************************************************************************************************************************/
+
+struct bench_worker
+{
+	const bench_options *options;
+	bench_clock::time_point deadline;
+	uint32_t debug_token;
+	bench_series status{"GetPLCstatus"};
+	bench_series trace{"GetTraceVariables"};
+	bench_series chunk{"AppendChunkToBlob"};
+	bench_series upload{"upload"};
+	bool connected = false;
+};
+
+static bool worker_running(const bench_worker &worker, unsigned done)
+{
+	if (worker.options->requests > 0)
+	{
+		return done < worker.options->requests;
+	}
+	return bench_clock::now() < worker.deadline;
+}
+
+static void poll_status(bench_worker &worker, BenchClient &client)
+{
+	for (unsigned done = 0; worker_running(worker, done); done++)
+	{
+		PLCstatus status;
+		timed_call(worker.status, sizeof(status), [&] { return client.plc().GetPLCstatus(&status); });
+	}
+}
+
+static void poll_trace(bench_worker &worker, BenchClient &client)
+{
+	uint32_t accepted = 0;
+	if (worker.options->trace_delta && (!checked_call([&] { return client.plc().SetTransferEncoding(TRANSFER_ENCODING_TRACE_DELTA, &accepted); }) ||
+										!(accepted & TRANSFER_ENCODING_TRACE_DELTA)))
+	{
+		fprintf(stderr, "delta coded trace samples not supported by the runtime\n");
+		return;
+	}
+
+	for (unsigned done = 0; worker_running(worker, done); done++)
+	{
+		TraceVariables traces = {};
+		uint64_t bytes = 0;
+		bool ok = timed_call(worker.trace, 0, [&] { return client.plc().GetTraceVariables(worker.debug_token, &traces); });
+		for (uint32_t i = 0; i < traces.traces.elementsCount; i++)
+		{
+			bytes += traces.traces.elements[i].TraceBuffer.dataLength;
+			free_binary(&traces.traces.elements[i].TraceBuffer);
+		}
+		erpc_free(traces.traces.elements);
+		if (ok)
+		{
+			worker.trace.bytes += bytes;
+		}
+	}
+}
+
+static void run_uploads(bench_worker &worker, BenchClient &client)
+{
+	std::vector<uint8_t> data(worker.options->upload_size);
+	std::mt19937 random(1);
+	std::generate(data.begin(), data.end(), [&] { return (uint8_t)random(); });
+
+	for (unsigned done = 0; worker_running(worker, done); done++)
+	{
+		uint8_t seed_data[16] = {0};
+		binary_t seed = {seed_data, sizeof(seed_data)};
+		binary_t blob = {};
+
+		// an upload starts like in the IDE, the uploaded files are never installed
+		auto start = bench_clock::now();
+		bool ok = checked_call([&] { return client.plc().PurgeBlobs(); }) && checked_call([&] { return client.plc().SeedBlob(&seed, &blob); });
+
+		for (uint32_t offset = 0; ok && (offset < data.size()); offset += worker.options->chunk_size)
+		{
+			binary_t chunk = {&data[offset], std::min<uint32_t>(worker.options->chunk_size, data.size() - offset)};
+			binary_t next = {};
+			ok = timed_call(worker.chunk, chunk.dataLength, [&] { return client.plc().AppendChunkToBlob(&chunk, &blob, &next); });
+			free_binary(&blob);
+			blob = next;
+		}
+		free_binary(&blob);
+
+		if (ok)
+		{
+			worker.upload.latency_us.push_back(std::chrono::duration<double, std::micro>(bench_clock::now() - start).count());
+			worker.upload.bytes += data.size();
+		}
+		else
+		{
+			worker.upload.errors++;
+		}
+	}
+	client.plc().PurgeBlobs();
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Client thread. The first client runs the test, the others poll the status to measure the latency seen by a
+ * 					second client (e.g. a monitoring tool) while the runtime is busy. For the trace test all clients poll.
+ ****************************************************************************************************************************************/
+static void worker_thread(bench_worker &worker, unsigned index)
+{
+	const bench_options &options = *worker.options;
+	BenchClient client(options);
+
+	worker.connected = client.open();
+	if (!worker.connected)
+	{
+		fprintf(stderr, "client %u: cant connect to %s:%u\n", index, options.host.c_str(), options.port);
+		return;
+	}
+
+	if (options.test == "status")
+	{
+		poll_status(worker, client);
+	}
+	else if (options.test == "trace")
+	{
+		poll_trace(worker, client);
+	}
+	else if (index == 0)
+	{
+		run_uploads(worker, client);
+	}
+	else
+	{
+		poll_status(worker, client);
+	}
+}
+
+/****************************************************************************************************************************************
+ * @brief 			Registers the trace variables and optionally negotiates delta coded samples, all clients share the debug token.
+ *
+ * @return 			true on success.
+ ****************************************************************************************************************************************/
+static bool setup_trace(const bench_options &options, uint32_t *debug_token)
+{
+	BenchClient client(options);
+	if (!client.open())
+	{
+		fprintf(stderr, "cant connect to %s:%u\n", options.host.c_str(), options.port);
+		return false;
+	}
+
+	std::vector<trace_order> orders;
+	for (uint32_t idx : options.trace_vars)
+	{
+		orders.push_back({idx, {NULL, 0}});
+	}
+	list_trace_order_1_t list = {orders.data(), (uint32_t)orders.size()};
+
+	if (!checked_call([&] { return client.plc().SetTraceVariablesList(&list, debug_token); }))
+	{
+		fprintf(stderr, "SetTraceVariablesList failed, status %u\n", call_status);
+		return false;
+	}
+	return true;
+}
+
+/***************************************************************************************************************************************/
+/*		report																												 		   */
+/***************************************************************************************************************************************/
+
+static double percentile(const std::vector<double> &sorted, double p)
+{
+	if (sorted.empty())
+	{
+		return 0;
+	}
+	size_t index = std::min(sorted.size() - 1, (size_t)(p / 100.0 * sorted.size()));
+	return sorted[index];
+}
+
+static void print_series(bench_series &series, double seconds)
+{
+	if (series.latency_us.empty() && (series.errors == 0))
+	{
+		return;
+	}
+
+	std::sort(series.latency_us.begin(), series.latency_us.end());
+	printf("%-18s %8zu %6llu %9.1f %9.0f %9.0f %9.0f %9.0f %9.0f %9.1f\n", series.name.c_str(), series.latency_us.size(),
+		   (unsigned long long)series.errors, series.latency_us.size() / seconds, percentile(series.latency_us, 0),
+		   percentile(series.latency_us, 50), percentile(series.latency_us, 90), percentile(series.latency_us, 99),
+		   series.latency_us.empty() ? 0 : series.latency_us.back(), series.bytes / seconds / 1024);
+}
+
+static void merge(bench_series &into, const bench_series &from)
+{
+	into.latency_us.insert(into.latency_us.end(), from.latency_us.begin(), from.latency_us.end());
+	into.bytes += from.bytes;
+	into.errors += from.errors;
+}
+
+/***************************************************************************************************************************************/
+/*		main																												 		   */
+/***************************************************************************************************************************************/
+
+static void usage(const char *name)
+{
+	fprintf(stderr,
+			"usage: %s [options] status|trace|upload\n"
+			"  -a host     address of the runtime (default 127.0.0.1)\n"
+			"  -p port     eRPC port (default %u)\n"
+			"  -c clients  concurrent connections (default 1)\n"
+			"  -d seconds  duration of the test (default 10)\n"
+			"  -n count    requests per client instead of a duration\n"
+			"  -s bytes    upload chunk size (default %u)\n"
+			"  -b bytes    size of one upload (default %u)\n"
+			"  -v list     comma separated indexes of the traced variables (default 0)\n"
+			"  -D          request delta coded trace samples\n"
+			"\n"
+			"status  every client polls GetPLCstatus\n"
+			"trace   every client polls GetTraceVariables, the plc should be running\n"
+			"upload  the first client uploads blobs like the IDE, the others poll GetPLCstatus\n",
+			name, DEFAULT_PORT, DEFAULT_CHUNK_SIZE, DEFAULT_UPLOAD_SIZE);
+}
+
+int main(int argc, char **argv)
+{
+	bench_options options;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "a:p:c:d:n:s:b:v:D")) != -1)
+	{
+		switch (opt)
+		{
+		case 'a':
+			options.host = optarg;
+			break;
+		case 'p':
+			options.port = (uint16_t)atoi(optarg);
+			break;
+		case 'c':
+			options.clients = std::max(atoi(optarg), 1);
+			break;
+		case 'd':
+			options.seconds = std::max(atoi(optarg), 1);
+			break;
+		case 'n':
+			options.requests = std::max(atoi(optarg), 0);
+			break;
+		case 's':
+			options.chunk_size = std::max(atoi(optarg), 1);
+			break;
+		case 'b':
+			options.upload_size = std::max(atoi(optarg), 1);
+			break;
+		case 'v':
+			options.trace_vars.clear();
+			for (char *idx = strtok(optarg, ","); idx != NULL; idx = strtok(NULL, ","))
+			{
+				options.trace_vars.push_back((uint32_t)atoi(idx));
+			}
+			break;
+		case 'D':
+			options.trace_delta = true;
+			break;
+		default:
+			usage(argv[0]);
+			return 2;
+		}
+	}
+	if ((optind != argc - 1) || ((strcmp(argv[optind], "status") != 0) && (strcmp(argv[optind], "trace") != 0) && (strcmp(argv[optind], "upload") != 0)))
+	{
+		usage(argv[0]);
+		return 2;
+	}
+	options.test = argv[optind];
+
+	uint32_t debug_token = 0;
+	if ((options.test == "trace") && !setup_trace(options, &debug_token))
+	{
+		return 1;
+	}
+
+	std::vector<bench_worker> workers(options.clients);
+	std::vector<std::thread> threads;
+	auto start = bench_clock::now();
+	for (unsigned i = 0; i < options.clients; i++)
+	{
+		workers[i].options = &options;
+		workers[i].deadline = start + std::chrono::seconds(options.seconds);
+		workers[i].debug_token = debug_token;
+		threads.emplace_back(worker_thread, std::ref(workers[i]), i);
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+	double seconds = std::chrono::duration<double>(bench_clock::now() - start).count();
+
+	bench_series status{"GetPLCstatus"}, trace{"GetTraceVariables"}, chunk{"AppendChunkToBlob"}, upload{"upload"};
+	unsigned connected = 0;
+	for (auto &worker : workers)
+	{
+		merge(status, worker.status);
+		merge(trace, worker.trace);
+		merge(chunk, worker.chunk);
+		merge(upload, worker.upload);
+		connected += worker.connected ? 1 : 0;
+	}
+
+	printf("%s:%u, test %s, %u of %u clients connected, %.1f s\n\n", options.host.c_str(), options.port, options.test.c_str(), connected,
+		   options.clients, seconds);
+	printf("%-18s %8s %6s %9s %9s %9s %9s %9s %9s %9s\n", "call", "count", "errors", "calls/s", "min us", "p50 us", "p90 us", "p99 us",
+		   "max us", "KB/s");
+	print_series(status, seconds);
+	print_series(trace, seconds);
+	print_series(chunk, seconds);
+	print_series(upload, seconds);
+	return (connected == options.clients) ? 0 : 1;
+}